@@ -40,70 +40,88 @@ static inline void store_be32(uint8_t out[4], uint32_t w) {
     out[3] = w & 0xFF;
 }
 
-/* 压缩函数 */
-static void sm3_compress(uint32_t state[8], const uint8_t block[64]) {
+/* 压缩函数：连续处理 nblocks 个分组，链接状态在整个批次中保留在局部变量中 */
+static void sm3_compress_blocks(uint32_t state[8], const uint8_t *data, size_t nblocks) {
     uint32_t W[68];
-    uint32_t A = state[0], B = state[1], C = state[2], D = state[3];
-    uint32_t E = state[4], F = state[5], G = state[6], H = state[7];
-    
-    // 1. 消息扩展
-    for (int j = 0; j < 16; j++) {
-        W[j] = load_be32(block + j * 4);
-    }
-    
-    // 消息扩展循环
-    for (int j = 16; j < 68; j++) {
-        uint32_t tmp = W[j-16] ^ W[j-9] ^ ROTL32(W[j-3], 15);
-        W[j] = P1(tmp) ^ ROTL32(W[j-13], 7) ^ W[j-6];
-    }
-    
-    // 2. 消息扩展附加
     uint32_t WW[64];
-    for (int j = 0; j < 64; j++) {
-        WW[j] = W[j] ^ W[j+4];
-    }
+    uint32_t V0 = state[0], V1 = state[1], V2 = state[2], V3 = state[3];
+    uint32_t V4 = state[4], V5 = state[5], V6 = state[6], V7 = state[7];
     
-    // 3. 压缩函数主循环
-    for (int j = 0; j < 64; j++) {
-        // 计算Tj常量（直接计算）
-        uint32_t T_j = (j < 16) ? 0x79CC4519 : 0x7A879D8A;
-        T_j = ROTL32(T_j, j);
+    for (; nblocks > 0; nblocks--, data += 64) {
+        uint32_t A = V0, B = V1, C = V2, D = V3;
+        uint32_t E = V4, F = V5, G = V6, H = V7;
+        
+        // 1. 消息扩展
+        for (int j = 0; j < 16; j++) {
+            W[j] = load_be32(data + j * 4);
+        }
         
-        // 预计算A的旋转结果
-        uint32_t A_rot12 = ROTL32(A, 12);
-        uint32_t tmp1 = A_rot12 + E + T_j;
-        uint32_t SS1 = ROTL32(tmp1, 7);
-        uint32_t SS2 = SS1 ^ A_rot12;
+        // 消息扩展循环
+        for (int j = 16; j < 68; j++) {
+            uint32_t tmp = W[j-16] ^ W[j-9] ^ ROTL32(W[j-3], 15);
+            W[j] = P1(tmp) ^ ROTL32(W[j-13], 7) ^ W[j-6];
+        }
         
-        uint32_t TT1, TT2;
-        if (j < 16) {
-            TT1 = FF0(A, B, C) + D + SS2 + WW[j];
-            TT2 = GG0(E, F, G) + H + SS1 + W[j];
-        } else {
-            TT1 = FF1(A, B, C) + D + SS2 + WW[j];
-            TT2 = GG1(E, F, G) + H + SS1 + W[j];
+        // 2. 消息扩展附加
+        for (int j = 0; j < 64; j++) {
+            WW[j] = W[j] ^ W[j+4];
         }
         
-        // 状态更新
-        D = C;
-        C = ROTL32(B, 9);
-        B = A;
-        A = TT1;
-        H = G;
-        G = ROTL32(F, 19);
-        F = E;
-        E = P0(TT2);
-    }
-    
-    // 4. 更新状态
-    state[0] ^= A;
-    state[1] ^= B;
-    state[2] ^= C;
-    state[3] ^= D;
-    state[4] ^= E;
-    state[5] ^= F;
-    state[6] ^= G;
-    state[7] ^= H;
+        // 3. 压缩函数主循环
+        for (int j = 0; j < 64; j++) {
+            // 计算Tj常量（直接计算）
+            uint32_t T_j = (j < 16) ? 0x79CC4519 : 0x7A879D8A;
+            T_j = ROTL32(T_j, j);
+            
+            // 预计算A的旋转结果
+            uint32_t A_rot12 = ROTL32(A, 12);
+            uint32_t tmp1 = A_rot12 + E + T_j;
+            uint32_t SS1 = ROTL32(tmp1, 7);
+            uint32_t SS2 = SS1 ^ A_rot12;
+            
+            uint32_t TT1, TT2;
+            if (j < 16) {
+                TT1 = FF0(A, B, C) + D + SS2 + WW[j];
+                TT2 = GG0(E, F, G) + H + SS1 + W[j];
+            } else {
+                TT1 = FF1(A, B, C) + D + SS2 + WW[j];
+                TT2 = GG1(E, F, G) + H + SS1 + W[j];
+            }
+            
+            // 状态更新
+            D = C;
+            C = ROTL32(B, 9);
+            B = A;
+            A = TT1;
+            H = G;
+            G = ROTL32(F, 19);
+            F = E;
+            E = P0(TT2);
+        }
+        
+        // 4. 更新状态
+        V0 ^= A;
+        V1 ^= B;
+        V2 ^= C;
+        V3 ^= D;
+        V4 ^= E;
+        V5 ^= F;
+        V6 ^= G;
+        V7 ^= H;
+    }
+    
+    state[0] = V0;
+    state[1] = V1;
+    state[2] = V2;
+    state[3] = V3;
+    state[4] = V4;
+    state[5] = V5;
+    state[6] = V6;
+    state[7] = V7;
+}
+
+static inline void sm3_compress(uint32_t state[8], const uint8_t block[64]) {
+    sm3_compress_blocks(state, block, 1);
 }
 
 /* 初始化 */
@@ -136,11 +154,12 @@ void sm3_update(sm3_ctx_t *ctx, const uint8_t *data, size_t len) {
         buf_len = 0;
     }
     
-    // 处理完整块
-    while (len >= block_size) {
-        sm3_compress(ctx->state, data);
-        data += block_size;
-        len -= block_size;
+    // 快速路径：完整块直接从调用者缓冲区成批压缩，不经过 buffer
+    if (len >= block_size) {
+        size_t nblocks = len / block_size;
+        sm3_compress_blocks(ctx->state, data, nblocks);
+        data += nblocks * block_size;
+        len -= nblocks * block_size;
     }
     
     // 保存剩余数据
@@ -155,7 +174,7 @@ void sm3_update(sm3_ctx_t *ctx, const uint8_t *data, size_t len) {
 /* 最终处理 */
 void sm3_final(sm3_ctx_t *ctx, uint8_t digest[32]) {
     // 计算消息总长度（位）
-    uint64_t bit_len = (uint64_t)ctx->total_len * 8;
+    uint64_t bit_len = ctx->total_len * 8;
     size_t buf_len = ctx->buf_len;
     
     // 计算填充长度
@@ -165,12 +184,12 @@ void sm3_final(sm3_ctx_t *ctx, uint8_t digest[32]) {
     uint8_t padding[128] = {0};
     padding[0] = 0x80;
     
-    // 添加长度信息
-    store_be32(padding + pad_len - 8, (uint32_t)(bit_len >> 32));
-    store_be32(padding + pad_len - 4, (uint32_t)bit_len);
+    // 添加长度信息（紧跟在填充字节之后，使总长度为 64 的倍数）
+    store_be32(padding + pad_len, (uint32_t)(bit_len >> 32));
+    store_be32(padding + pad_len + 4, (uint32_t)bit_len);
     
     // 处理填充
-    sm3_update(ctx, padding, pad_len);
+    sm3_update(ctx, padding, pad_len + 8);
     
     // 确保处理最后一块
     if (ctx->buf_len > 0) {
@@ -184,6 +203,50 @@ void sm3_final(sm3_ctx_t *ctx, uint8_t digest[32]) {
     }
 }
 
+/* 导出中间状态 */
+size_t sm3_export(const sm3_ctx_t *ctx, uint8_t out[SM3_EXPORT_MAX_SIZE]) {
+    uint64_t total = ctx->total_len;
+    
+    for (int i = 0; i < 8; i++) {
+        store_be32(out + i * 4, ctx->state[i]);
+    }
+    store_be32(out + 32, (uint32_t)(total >> 32));
+    store_be32(out + 36, (uint32_t)total);
+    memcpy(out + SM3_MIDSTATE_SIZE, ctx->buffer, ctx->buf_len);
+    
+    return SM3_MIDSTATE_SIZE + ctx->buf_len;
+}
+
+/* 恢复中间状态 */
+int sm3_import(sm3_ctx_t *ctx, const uint8_t *in, size_t len) {
+    if (len < SM3_MIDSTATE_SIZE) {
+        return -1;
+    }
+    
+    uint64_t total = ((uint64_t)load_be32(in + 32) << 32) | load_be32(in + 36);
+    size_t buf_len = (size_t)(total % 64);
+    if (len != SM3_MIDSTATE_SIZE + buf_len) {
+        return -1;
+    }
+    
+    ctx->total_len = total;
+    for (int i = 0; i < 8; i++) {
+        ctx->state[i] = load_be32(in + i * 4);
+    }
+    memcpy(ctx->buffer, in + SM3_MIDSTATE_SIZE, buf_len);
+    ctx->buf_len = buf_len;
+    
+    return 0;
+}
+
+/* 复制上下文 */
+void sm3_clone(sm3_ctx_t *dst, const sm3_ctx_t *src) {
+    memcpy(dst->state, src->state, sizeof(src->state));
+    dst->total_len = src->total_len;
+    dst->buf_len = src->buf_len;
+    memcpy(dst->buffer, src->buffer, src->buf_len);
+}
+
 /* 高性能一次性接口 */
 void sm3(const uint8_t *data, size_t len, uint8_t digest[32]) {
     // 创建本地上下文避免结构体开销
@@ -193,8 +256,8 @@ void sm3(const uint8_t *data, size_t len, uint8_t digest[32]) {
     size_t tail_len = len % 64;
     
     // 处理完整块
-    for (size_t i = 0; i < total_blocks; i++) {
-        sm3_compress(state, data + i * 64);
+    if (total_blocks > 0) {
+        sm3_compress_blocks(state, data, total_blocks);
     }
     
     // 准备尾部数据
@@ -8,12 +8,17 @@
 
 /* SM3 计算上下文 */
 typedef struct {
-    uint32_t total_len;      /* 已处理字节总数（仅低 32 位） */
+    uint64_t total_len;      /* 已处理字节总数 */
     uint32_t state[8];       /* 中间哈希状态 */
     uint8_t  buffer[64];     /* 当前还未处理的分组数据 */
     size_t   buf_len;        /* buffer 中已有数据长度 */
 } sm3_ctx_t;
 
+/* 中间状态序列化格式（大端序）：32 字节链接状态 + 8 字节已处理长度，
+ * 若长度不是 64 的倍数，其后紧跟 buffer 中尚未压缩的 (长度 % 64) 字节 */
+#define SM3_MIDSTATE_SIZE   40
+#define SM3_EXPORT_MAX_SIZE (SM3_MIDSTATE_SIZE + 64)
+
 /**
  * @brief 初始化 SM3 上下文（设置初始状态）
  */
@@ -34,6 +39,28 @@ void sm3_update(sm3_ctx_t *ctx, const uint8_t *data, size_t len);
  */
 void sm3_final(sm3_ctx_t *ctx, uint8_t digest[32]);
 
+/**
+ * @brief 导出上下文的中间状态（可保存、传输，之后用 sm3_import 恢复）
+ * @param ctx 上下文
+ * @param out 输出缓冲区（至少 SM3_EXPORT_MAX_SIZE 字节）
+ * @return 写入的字节数：SM3_MIDSTATE_SIZE + 缓冲区中未压缩的字节数
+ */
+size_t sm3_export(const sm3_ctx_t *ctx, uint8_t out[SM3_EXPORT_MAX_SIZE]);
+
+/**
+ * @brief 从 sm3_export 的输出恢复上下文
+ * @param ctx 待恢复的上下文
+ * @param in  序列化数据
+ * @param len 序列化数据长度
+ * @return 成功返回 0，长度与格式不符返回 -1
+ */
+int sm3_import(sm3_ctx_t *ctx, const uint8_t *in, size_t len);
+
+/**
+ * @brief 复制上下文（只拷贝有效的缓冲数据），用于在公共前缀之后分叉
+ */
+void sm3_clone(sm3_ctx_t *dst, const sm3_ctx_t *src);
+
 /**
  * @brief 一次性计算 SM3 摘要
  * @param data   输入数据
@@ -155,23 +155,13 @@ void sm3_compress(uint32_t state[8], const unsigned char block[64]) {
     state[7] ^= H;
 }
 
-// 8通道压缩函数
-void sm3_8x_compress(sm3_8x_context *ctx, const unsigned char blocks[8][64]) {
+// 8通道压缩函数 (消息字已按通道转置：words[i] 的第 ch 个元素为通道 ch 的第 i 个大端字)
+void sm3_8x_compress_words(sm3_8x_context *ctx, const __m256i words[16]) {
     __m256i w[68];
     __m256i ww[64];
-    
-    for (int i = 0; i < 16; i++) {
 
-        w[i] = _mm256_setr_epi32(
-            ((uint32_t)blocks[0][i*4] << 24) | ((uint32_t)blocks[0][i*4+1] << 16) | ((uint32_t)blocks[0][i*4+2] << 8) | (blocks[0][i*4+3]),
-            ((uint32_t)blocks[1][i*4] << 24) | ((uint32_t)blocks[1][i*4+1] << 16) | ((uint32_t)blocks[1][i*4+2] << 8) | (blocks[1][i*4+3]),
-            ((uint32_t)blocks[2][i*4] << 24) | ((uint32_t)blocks[2][i*4+1] << 16) | ((uint32_t)blocks[2][i*4+2] << 8) | (blocks[2][i*4+3]),
-            ((uint32_t)blocks[3][i*4] << 24) | ((uint32_t)blocks[3][i*4+1] << 16) | ((uint32_t)blocks[3][i*4+2] << 8) | (blocks[3][i*4+3]),
-            ((uint32_t)blocks[4][i*4] << 24) | ((uint32_t)blocks[4][i*4+1] << 16) | ((uint32_t)blocks[4][i*4+2] << 8) | (blocks[4][i*4+3]),
-            ((uint32_t)blocks[5][i*4] << 24) | ((uint32_t)blocks[5][i*4+1] << 16) | ((uint32_t)blocks[5][i*4+2] << 8) | (blocks[5][i*4+3]),
-            ((uint32_t)blocks[6][i*4] << 24) | ((uint32_t)blocks[6][i*4+1] << 16) | ((uint32_t)blocks[6][i*4+2] << 8) | (blocks[6][i*4+3]),
-            ((uint32_t)blocks[7][i*4] << 24) | ((uint32_t)blocks[7][i*4+1] << 16) | ((uint32_t)blocks[7][i*4+2] << 8) | (blocks[7][i*4+3])
-        );
+    for (int i = 0; i < 16; i++) {
+        w[i] = words[i];
     }
     
     for (int i = 16; i < 68; i++) {
@@ -246,6 +236,36 @@ void sm3_8x_compress(sm3_8x_context *ctx, const unsigned char blocks[8][64]) {
     ctx->state[7] = _mm256_blendv_epi8(saved_H, _mm256_xor_si256(saved_H, H), ctx->active_mask);
 }
 
+// 8通道压缩函数 (每个通道的分组可位于任意地址)
+void sm3_8x_compress_lanes(sm3_8x_context *ctx, const unsigned char *blocks[8]) {
+    __m256i w[16];
+
+    for (int i = 0; i < 16; i++) {
+
+        w[i] = _mm256_setr_epi32(
+            ((uint32_t)blocks[0][i*4] << 24) | ((uint32_t)blocks[0][i*4+1] << 16) | ((uint32_t)blocks[0][i*4+2] << 8) | (blocks[0][i*4+3]),
+            ((uint32_t)blocks[1][i*4] << 24) | ((uint32_t)blocks[1][i*4+1] << 16) | ((uint32_t)blocks[1][i*4+2] << 8) | (blocks[1][i*4+3]),
+            ((uint32_t)blocks[2][i*4] << 24) | ((uint32_t)blocks[2][i*4+1] << 16) | ((uint32_t)blocks[2][i*4+2] << 8) | (blocks[2][i*4+3]),
+            ((uint32_t)blocks[3][i*4] << 24) | ((uint32_t)blocks[3][i*4+1] << 16) | ((uint32_t)blocks[3][i*4+2] << 8) | (blocks[3][i*4+3]),
+            ((uint32_t)blocks[4][i*4] << 24) | ((uint32_t)blocks[4][i*4+1] << 16) | ((uint32_t)blocks[4][i*4+2] << 8) | (blocks[4][i*4+3]),
+            ((uint32_t)blocks[5][i*4] << 24) | ((uint32_t)blocks[5][i*4+1] << 16) | ((uint32_t)blocks[5][i*4+2] << 8) | (blocks[5][i*4+3]),
+            ((uint32_t)blocks[6][i*4] << 24) | ((uint32_t)blocks[6][i*4+1] << 16) | ((uint32_t)blocks[6][i*4+2] << 8) | (blocks[6][i*4+3]),
+            ((uint32_t)blocks[7][i*4] << 24) | ((uint32_t)blocks[7][i*4+1] << 16) | ((uint32_t)blocks[7][i*4+2] << 8) | (blocks[7][i*4+3])
+        );
+    }
+
+    sm3_8x_compress_words(ctx, w);
+}
+
+// 8通道压缩函数
+void sm3_8x_compress(sm3_8x_context *ctx, const unsigned char blocks[8][64]) {
+    const unsigned char *lanes[8] = {
+        blocks[0], blocks[1], blocks[2], blocks[3],
+        blocks[4], blocks[5], blocks[6], blocks[7]
+    };
+    sm3_8x_compress_lanes(ctx, lanes);
+}
+
 // 8通道最终处理函数
 void sm3_8x_final(sm3_8x_context *ctx, unsigned char outputs[8][32]) {
 
@@ -291,7 +311,7 @@ void sm3_single(const unsigned char *input, size_t ilen, unsigned char *output)
     memcpy(block, input + i, remaining_bytes);
     block[remaining_bytes] = 0x80; 
     
-    if (remaining_bytes >= 56 || remaining_bytes == 0) {
+    if (remaining_bytes >= 56) {
         sm3_compress(ctx.state, block);
         memset(block, 0, 64); 
     }
@@ -312,89 +332,162 @@ void sm3_single(const unsigned char *input, size_t ilen, unsigned char *output)
     }
 }
 
-// 8通道完整哈希计算
-void sm3_8x(const unsigned char *inputs[8], size_t ilens[8], unsigned char outputs[8][32]) {
-    sm3_8x_context ctx;
-    sm3_8x_starts(&ctx);
-    
-    unsigned char block_data[8][64]; 
-    uint64_t total_bits[8];
-    size_t num_message_blocks[8]; 
-    size_t remaining_bytes_in_last_msg_block[8];
-    size_t actual_total_blocks_for_lane[8]; 
-    
-    size_t max_total_blocks = 0; 
+// 8通道收尾：从各通道当前状态出发，直接从调用者缓冲区压缩剩余消息并完成填充。
+// prefix_lens 为各通道此前已压缩的字节数 (64 的倍数)，可为 NULL 表示 0。
+void sm3_8x_finish(sm3_8x_context *ctx, const unsigned char *inputs[8], const size_t ilens[8],
+                   const uint64_t prefix_lens[8], unsigned char outputs[8][32]) {
+    unsigned char tail[8][128];
+    size_t msg_blocks[8];
+    size_t total_blocks[8];
+    size_t max_total_blocks = 0;
+
     for (int ch = 0; ch < 8; ch++) {
-        total_bits[ch] = (uint64_t)ilens[ch] * 8;
-        num_message_blocks[ch] = ilens[ch] / 64;
-        remaining_bytes_in_last_msg_block[ch] = ilens[ch] % 64;
-
-        // 计算每个通道包括填充在内的总块数
-        if (remaining_bytes_in_last_msg_block[ch] == 0) {
-            actual_total_blocks_for_lane[ch] = num_message_blocks[ch] + 2; 
-        } else if (remaining_bytes_in_last_msg_block[ch] >= 56) {
-            actual_total_blocks_for_lane[ch] = num_message_blocks[ch] + 2; 
-        } else {
-            actual_total_blocks_for_lane[ch] = num_message_blocks[ch] + 1; 
+        size_t rem = ilens[ch] % 64;
+        size_t tail_len = (rem < 56) ? 64 : 128;
+        uint64_t total_bits = ((prefix_lens ? prefix_lens[ch] : 0) + (uint64_t)ilens[ch]) * 8;
+
+        msg_blocks[ch] = ilens[ch] / 64;
+        total_blocks[ch] = msg_blocks[ch] + tail_len / 64;
+
+        memset(tail[ch], 0, tail_len);
+        memcpy(tail[ch], inputs[ch] + msg_blocks[ch] * 64, rem);
+        tail[ch][rem] = 0x80;
+        // 追加 64 位长度 (大端序)
+        for (int k = 0; k < 8; k++) {
+            tail[ch][tail_len - 1 - k] = (unsigned char)(total_bits >> (k * 8));
         }
-        // 找出所有通道中所需的最大块数
-        if (actual_total_blocks_for_lane[ch] > max_total_blocks) {
-            max_total_blocks = actual_total_blocks_for_lane[ch];
+        if (total_blocks[ch] > max_total_blocks) {
+            max_total_blocks = total_blocks[ch];
         }
     }
-    
-    uint32_t current_mask_array[8]; 
+
+    const unsigned char *lanes[8];
+    uint32_t current_mask_array[8];
+    uint32_t loaded_mask_array[8];
+    int mask_loaded = 0;
 
     for (size_t block_idx = 0; block_idx < max_total_blocks; block_idx++) {
-        memset(current_mask_array, 0, sizeof(current_mask_array)); 
-        
         for (int ch = 0; ch < 8; ch++) {
-            // 检查该通道是否仍然需要处理块
-            if (block_idx < actual_total_blocks_for_lane[ch]) {
-                current_mask_array[ch] = 0xFFFFFFFF; 
-                memset(block_data[ch], 0, 64); 
-                
-                // 判断是消息块还是填充块
-                if (block_idx < num_message_blocks[ch]) {
-                    // 完整的消息块
-                    memcpy(block_data[ch], inputs[ch] + block_idx * 64, 64);
-                } else {
-                    // 填充块
-                    size_t current_padding_block_offset = block_idx - num_message_blocks[ch];
-
-                    if (remaining_bytes_in_last_msg_block[ch] < 56 && remaining_bytes_in_last_msg_block[ch] != 0) {
-                        // 情况：消息 + 0x80 + 长度可以在一个块中完成填充
-                        if (current_padding_block_offset == 0) {
-                            memcpy(block_data[ch], inputs[ch] + num_message_blocks[ch] * 64, remaining_bytes_in_last_msg_block[ch]);
-                            block_data[ch][remaining_bytes_in_last_msg_block[ch]] = 0x80;
-                            // 追加 64 位长度 (大端序)
-                            for (int k = 0; k < 8; k++) {
-                                block_data[ch][63 - k] = (unsigned char)(total_bits[ch] >> (k * 8));
-                            }
-                        }
-                    } else {
-                        // 情况：消息长度是 64 字节的倍数，或者消息 + 0x80 需要两个块才能完成填充
-                        if (current_padding_block_offset == 0) {
-                            // 第一个填充块：包含最后的消息字节 (如果有) + 0x80 + 零
-                            memcpy(block_data[ch], inputs[ch] + num_message_blocks[ch] * 64, remaining_bytes_in_last_msg_block[ch]);
-                            block_data[ch][remaining_bytes_in_last_msg_block[ch]] = 0x80;
-                        } else { // current_padding_block_offset 必须是 1
-                            // 第二个填充块：只包含 64 位长度
-                            for (int k = 0; k < 8; k++) {
-                                block_data[ch][63 - k] = (unsigned char)(total_bits[ch] >> (k * 8));
-                            }
-                        }
-                    }
-                }
+            if (block_idx < msg_blocks[ch]) {
+                lanes[ch] = inputs[ch] + block_idx * 64;
+                current_mask_array[ch] = 0xFFFFFFFF;
+            } else if (block_idx < total_blocks[ch]) {
+                lanes[ch] = tail[ch] + (block_idx - msg_blocks[ch]) * 64;
+                current_mask_array[ch] = 0xFFFFFFFF;
+            } else {
+                lanes[ch] = tail[ch]; // 已完成的通道：数据任意，结果被 active_mask 丢弃
+                current_mask_array[ch] = 0;
             }
         }
-        
-        ctx.active_mask = _mm256_loadu_si256((__m256i*)current_mask_array);
-        // 只有至少一个通道活跃时才调用压缩函数
-        if (!_mm256_testz_si256(ctx.active_mask, _mm256_set1_epi32(0xFFFFFFFF))) {
-            sm3_8x_compress(&ctx, (const unsigned char (*)[64])block_data); 
+        // 掩码只在通道完成时变化，长消息的主循环中无需重新加载
+        if (!mask_loaded || memcmp(current_mask_array, loaded_mask_array, sizeof(current_mask_array)) != 0) {
+            memcpy(loaded_mask_array, current_mask_array, sizeof(current_mask_array));
+            ctx->active_mask = _mm256_loadu_si256((__m256i*)current_mask_array);
+            mask_loaded = 1;
         }
+        sm3_8x_compress_lanes(ctx, lanes);
     }
-    
-    sm3_8x_final(&ctx, outputs); 
+
+    ctx->active_mask = _mm256_set1_epi32(0xFFFFFFFF);
+    sm3_8x_final(ctx, outputs);
+}
+
+// 8通道完整哈希计算
+void sm3_8x(const unsigned char *inputs[8], size_t ilens[8], unsigned char outputs[8][32]) {
+    sm3_8x_context ctx;
+    sm3_8x_starts(&ctx);
+    sm3_8x_finish(&ctx, inputs, ilens, NULL, outputs);
+}
+
+// --- 中间状态 (midstate) 与通道状态装载 ---
+void sm3_8x_clone(sm3_8x_context *dst, const sm3_8x_context *src) {
+    for (int i = 0; i < 8; i++) {
+        dst->state[i] = src->state[i];
+    }
+    dst->active_mask = src->active_mask;
+}
+
+void sm3_8x_get_lane_state(const sm3_8x_context *ctx, int lane, uint32_t state[8]) {
+    uint32_t tmp[8];
+    for (int i = 0; i < 8; i++) {
+        _mm256_storeu_si256((__m256i*)tmp, ctx->state[i]);
+        state[i] = tmp[lane];
+    }
+}
+
+void sm3_8x_set_lane_state(sm3_8x_context *ctx, int lane, const uint32_t state[8]) {
+    uint32_t tmp[8];
+    for (int i = 0; i < 8; i++) {
+        _mm256_storeu_si256((__m256i*)tmp, ctx->state[i]);
+        tmp[lane] = state[i];
+        ctx->state[i] = _mm256_loadu_si256((const __m256i*)tmp);
+    }
+}
+
+void sm3_8x_load_states(sm3_8x_context *ctx, const uint32_t *states[8]) {
+    sm3_8x_init_constants();
+    for (int i = 0; i < 8; i++) {
+        ctx->state[i] = _mm256_setr_epi32(
+            (int)states[0][i], (int)states[1][i], (int)states[2][i], (int)states[3][i],
+            (int)states[4][i], (int)states[5][i], (int)states[6][i], (int)states[7][i]);
+    }
+    ctx->active_mask = _mm256_set1_epi32(0xFFFFFFFF);
+}
+
+void sm3_8x_broadcast_state(sm3_8x_context *ctx, const uint32_t state[8]) {
+    sm3_8x_init_constants();
+    for (int i = 0; i < 8; i++) {
+        ctx->state[i] = _mm256_set1_epi32((int)state[i]);
+    }
+    ctx->active_mask = _mm256_set1_epi32(0xFFFFFFFF);
+}
+
+static int parse_midstate(const unsigned char in[SM3_MIDSTATE_SIZE], uint32_t state[8], uint64_t *processed_len) {
+    uint64_t len = 0;
+    for (int k = 0; k < 8; k++) {
+        state[k] = ((uint32_t)in[k*4] << 24) | ((uint32_t)in[k*4+1] << 16) |
+                   ((uint32_t)in[k*4+2] << 8) | ((uint32_t)in[k*4+3]);
+        len = (len << 8) | in[32 + k];
+    }
+    if (len % 64 != 0) {
+        return -1;
+    }
+    if (processed_len) {
+        *processed_len = len;
+    }
+    return 0;
+}
+
+void sm3_8x_export_lane(const sm3_8x_context *ctx, int lane, uint64_t processed_len,
+                        unsigned char out[SM3_MIDSTATE_SIZE]) {
+    uint32_t state[8];
+    sm3_8x_get_lane_state(ctx, lane, state);
+    for (int k = 0; k < 8; k++) {
+        out[k*4]   = (unsigned char)(state[k] >> 24);
+        out[k*4+1] = (unsigned char)(state[k] >> 16);
+        out[k*4+2] = (unsigned char)(state[k] >> 8);
+        out[k*4+3] = (unsigned char)(state[k]);
+        out[32 + k] = (unsigned char)(processed_len >> (56 - 8 * k));
+    }
+}
+
+int sm3_8x_import_lane(sm3_8x_context *ctx, int lane, const unsigned char in[SM3_MIDSTATE_SIZE],
+                       uint64_t *processed_len) {
+    uint32_t state[8];
+    if (parse_midstate(in, state, processed_len) != 0) {
+        return -1;
+    }
+    sm3_8x_init_constants();
+    sm3_8x_set_lane_state(ctx, lane, state);
+    return 0;
+}
+
+int sm3_8x_broadcast_midstate(sm3_8x_context *ctx, const unsigned char in[SM3_MIDSTATE_SIZE],
+                              uint64_t *processed_len) {
+    uint32_t state[8];
+    if (parse_midstate(in, state, processed_len) != 0) {
+        return -1;
+    }
+    sm3_8x_broadcast_state(ctx, state);
+    return 0;
 }
@@ -28,7 +28,35 @@ typedef struct {
 // 8 通道 SM3 函数声明 (公共接口)
 void sm3_8x_starts(sm3_8x_context *ctx);
 void sm3_8x_compress(sm3_8x_context *ctx, const unsigned char blocks[8][64]);
+// 与 sm3_8x_compress 相同，但每个通道的 64 字节分组由独立指针给出（无需拷贝到连续缓冲区）
+void sm3_8x_compress_lanes(sm3_8x_context *ctx, const unsigned char *blocks[8]);
+// 消息字已在寄存器中按通道转置好 (words[i] 的第 ch 个 32 位元素为通道 ch 分组的第 i 个大端字)
+void sm3_8x_compress_words(sm3_8x_context *ctx, const __m256i words[16]);
 void sm3_8x_final(sm3_8x_context *ctx, unsigned char outputs[8][32]);
+// 从各通道当前状态出发处理剩余消息、完成填充并输出摘要；prefix_lens 为各通道已压缩的字节数 (可为 NULL)
+void sm3_8x_finish(sm3_8x_context *ctx, const unsigned char *inputs[8], const size_t ilens[8],
+                   const uint64_t prefix_lens[8], unsigned char outputs[8][32]);
 void sm3_8x(const unsigned char *inputs[8], size_t ilens[8], unsigned char outputs[8][32]);
 
+// --- 中间状态 (midstate) 与通道状态装载 ---
+// 序列化格式与 sm3.h 相同：32 字节链接状态 + 8 字节已压缩长度 (大端序)。
+// 8 通道上下文只处理完整分组，因此长度必须是 64 的倍数。
+#define SM3_MIDSTATE_SIZE 40
+
+void sm3_8x_clone(sm3_8x_context *dst, const sm3_8x_context *src);
+void sm3_8x_get_lane_state(const sm3_8x_context *ctx, int lane, uint32_t state[8]);
+void sm3_8x_set_lane_state(sm3_8x_context *ctx, int lane, const uint32_t state[8]);
+// 每个通道装载各自的链接状态 (例如不同密钥的 HMAC 内层状态)
+void sm3_8x_load_states(sm3_8x_context *ctx, const uint32_t *states[8]);
+// 把同一个链接状态广播到全部 8 个通道，公共前缀只需压缩一次
+void sm3_8x_broadcast_state(sm3_8x_context *ctx, const uint32_t state[8]);
+
+void sm3_8x_export_lane(const sm3_8x_context *ctx, int lane, uint64_t processed_len,
+                        unsigned char out[SM3_MIDSTATE_SIZE]);
+// 成功返回 0 并通过 processed_len 返回已压缩长度；长度不是 64 的倍数返回 -1
+int sm3_8x_import_lane(sm3_8x_context *ctx, int lane, const unsigned char in[SM3_MIDSTATE_SIZE],
+                       uint64_t *processed_len);
+int sm3_8x_broadcast_midstate(sm3_8x_context *ctx, const unsigned char in[SM3_MIDSTATE_SIZE],
+                              uint64_t *processed_len);
+
 #endif // SM3_AVX_H
@@ -0,0 +1,256 @@
+// author： https://github.com/8891689
+// sm3_avx512.c  (gcc -O3 -mavx512f -mavx512bw)
+#include "sm3_avx512.h"
+#include <string.h>
+#include <immintrin.h>
+
+// 单通道 ROTL32
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+// AVX-512: vprold 一条指令完成循环左移
+#define ROTL32_512(x, n) _mm512_rol_epi32((x), (n))
+
+// vpternlogd 真值表: XOR3 = 0x96, 多数函数 FF1 = 0xE8, 选择函数 GG1 = 0xCA
+#define XOR3_512(x, y, z) _mm512_ternarylogic_epi32((x), (y), (z), 0x96)
+#define FF1_512(x, y, z)  _mm512_ternarylogic_epi32((x), (y), (z), 0xE8)
+#define GG1_512(x, y, z)  _mm512_ternarylogic_epi32((x), (y), (z), 0xCA)
+#define P0_512(x)         XOR3_512((x), ROTL32_512((x), 9), ROTL32_512((x), 17))
+#define P1_512(x)         XOR3_512((x), ROTL32_512((x), 15), ROTL32_512((x), 23))
+
+static const uint32_t SM3_IV[8] = {
+    0x7380166F, 0x4914B2B9, 0x172442D7, 0xDA8A0600,
+    0xA96F30BC, 0x163138AA, 0xE38DEE4D, 0xB0FB0E4E
+};
+
+// 预先旋转好的 Tj 常量，每轮以广播方式装载
+static const uint32_t T_j_rotated[64] = {
+#define TJ_BASE(j) ((uint32_t)((j) < 16 ? 0x79CC4519U : 0x7A879D8AU))
+#define TJ(j) ((j) % 32 == 0 ? TJ_BASE(j) : ROTL32(TJ_BASE(j), ((j) % 32)))
+    TJ(0),  TJ(1),  TJ(2),  TJ(3),  TJ(4),  TJ(5),  TJ(6),  TJ(7),
+    TJ(8),  TJ(9),  TJ(10), TJ(11), TJ(12), TJ(13), TJ(14), TJ(15),
+    TJ(16), TJ(17), TJ(18), TJ(19), TJ(20), TJ(21), TJ(22), TJ(23),
+    TJ(24), TJ(25), TJ(26), TJ(27), TJ(28), TJ(29), TJ(30), TJ(31),
+    TJ(32), TJ(33), TJ(34), TJ(35), TJ(36), TJ(37), TJ(38), TJ(39),
+    TJ(40), TJ(41), TJ(42), TJ(43), TJ(44), TJ(45), TJ(46), TJ(47),
+    TJ(48), TJ(49), TJ(50), TJ(51), TJ(52), TJ(53), TJ(54), TJ(55),
+    TJ(56), TJ(57), TJ(58), TJ(59), TJ(60), TJ(61), TJ(62), TJ(63)
+#undef TJ
+#undef TJ_BASE
+};
+
+// 装载 16 个通道的分组：每个通道一次 64 字节加载 + 字节序翻转，再做 16x16 的 32 位转置
+static inline void load_transpose_16x16(const unsigned char *blocks[16], __m512i w[16]) {
+    const __m512i bswap = _mm512_set4_epi32(0x0C0D0E0F, 0x08090A0B, 0x04050607, 0x00010203);
+    __m512i r[16], t[16], u[16];
+
+    for (int l = 0; l < 16; l++) {
+        r[l] = _mm512_shuffle_epi8(_mm512_loadu_si512((const void*)blocks[l]), bswap);
+    }
+    for (int i = 0; i < 8; i++) {
+        t[2*i]   = _mm512_unpacklo_epi32(r[2*i], r[2*i+1]);
+        t[2*i+1] = _mm512_unpackhi_epi32(r[2*i], r[2*i+1]);
+    }
+    for (int j = 0; j < 4; j++) {
+        u[4*j]   = _mm512_unpacklo_epi64(t[4*j],   t[4*j+2]);
+        u[4*j+1] = _mm512_unpackhi_epi64(t[4*j],   t[4*j+2]);
+        u[4*j+2] = _mm512_unpacklo_epi64(t[4*j+1], t[4*j+3]);
+        u[4*j+3] = _mm512_unpackhi_epi64(t[4*j+1], t[4*j+3]);
+    }
+    // u[4j+m] 的第 k 个 128 位段 = 第 4j..4j+3 通道的第 4k+m 个字
+    for (int m = 0; m < 4; m++) {
+        __m512i v0 = _mm512_shuffle_i32x4(u[m],     u[4 + m],  0x88);
+        __m512i v1 = _mm512_shuffle_i32x4(u[m],     u[4 + m],  0xDD);
+        __m512i v2 = _mm512_shuffle_i32x4(u[8 + m], u[12 + m], 0x88);
+        __m512i v3 = _mm512_shuffle_i32x4(u[8 + m], u[12 + m], 0xDD);
+        w[m]      = _mm512_shuffle_i32x4(v0, v2, 0x88);
+        w[4 + m]  = _mm512_shuffle_i32x4(v1, v3, 0x88);
+        w[8 + m]  = _mm512_shuffle_i32x4(v0, v2, 0xDD);
+        w[12 + m] = _mm512_shuffle_i32x4(v1, v3, 0xDD);
+    }
+}
+
+void sm3_16x_starts(sm3_16x_context *ctx) {
+    for (int i = 0; i < 8; i++) {
+        ctx->state[i] = _mm512_set1_epi32((int)SM3_IV[i]);
+    }
+    ctx->active_mask = 0xFFFF;
+}
+
+// 16通道压缩函数 (消息字已按通道转置：words[i] 的第 ch 个元素为通道 ch 的第 i 个大端字)
+void sm3_16x_compress_words(sm3_16x_context *ctx, const __m512i words[16]) {
+    __m512i w[68];
+    __m512i ww[64];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = words[i];
+    }
+
+    for (int i = 16; i < 68; i++) {
+        __m512i tmp = XOR3_512(w[i-16], w[i-9], ROTL32_512(w[i-3], 15));
+        w[i] = XOR3_512(P1_512(tmp), ROTL32_512(w[i-13], 7), w[i-6]);
+    }
+
+    for (int i = 0; i < 64; i++) {
+        ww[i] = _mm512_xor_si512(w[i], w[i+4]);
+    }
+
+    __m512i A = ctx->state[0];
+    __m512i B = ctx->state[1];
+    __m512i C = ctx->state[2];
+    __m512i D = ctx->state[3];
+    __m512i E = ctx->state[4];
+    __m512i F = ctx->state[5];
+    __m512i G = ctx->state[6];
+    __m512i H = ctx->state[7];
+
+    for (int j = 0; j < 64; j++) {
+        __m512i SS1, SS2, TT1, TT2;
+        __m512i rotA = ROTL32_512(A, 12);
+
+        SS1 = ROTL32_512(_mm512_add_epi32(_mm512_add_epi32(rotA, E), _mm512_set1_epi32((int)T_j_rotated[j])), 7);
+        SS2 = _mm512_xor_si512(SS1, rotA);
+
+        if (j < 16) {
+            TT1 = _mm512_add_epi32(_mm512_add_epi32(XOR3_512(A, B, C), D),
+                                   _mm512_add_epi32(SS2, ww[j]));
+            TT2 = _mm512_add_epi32(_mm512_add_epi32(XOR3_512(E, F, G), H),
+                                   _mm512_add_epi32(SS1, w[j]));
+        } else {
+            TT1 = _mm512_add_epi32(_mm512_add_epi32(FF1_512(A, B, C), D),
+                                   _mm512_add_epi32(SS2, ww[j]));
+            TT2 = _mm512_add_epi32(_mm512_add_epi32(GG1_512(E, F, G), H),
+                                   _mm512_add_epi32(SS1, w[j]));
+        }
+
+        D = C;
+        C = ROTL32_512(B, 9);
+        B = A;
+        A = TT1;
+        H = G;
+        G = ROTL32_512(F, 19);
+        F = E;
+        E = P0_512(TT2);
+    }
+
+    // 使用 k 掩码仅更新活跃通道的状态
+    __mmask16 m = ctx->active_mask;
+    ctx->state[0] = _mm512_mask_xor_epi32(ctx->state[0], m, ctx->state[0], A);
+    ctx->state[1] = _mm512_mask_xor_epi32(ctx->state[1], m, ctx->state[1], B);
+    ctx->state[2] = _mm512_mask_xor_epi32(ctx->state[2], m, ctx->state[2], C);
+    ctx->state[3] = _mm512_mask_xor_epi32(ctx->state[3], m, ctx->state[3], D);
+    ctx->state[4] = _mm512_mask_xor_epi32(ctx->state[4], m, ctx->state[4], E);
+    ctx->state[5] = _mm512_mask_xor_epi32(ctx->state[5], m, ctx->state[5], F);
+    ctx->state[6] = _mm512_mask_xor_epi32(ctx->state[6], m, ctx->state[6], G);
+    ctx->state[7] = _mm512_mask_xor_epi32(ctx->state[7], m, ctx->state[7], H);
+}
+
+// 16通道压缩函数 (每个通道的分组可位于任意地址)
+void sm3_16x_compress_lanes(sm3_16x_context *ctx, const unsigned char *blocks[16]) {
+    __m512i w[16];
+
+    load_transpose_16x16(blocks, w);
+    sm3_16x_compress_words(ctx, w);
+}
+
+// 16通道压缩函数
+void sm3_16x_compress(sm3_16x_context *ctx, const unsigned char blocks[16][64]) {
+    const unsigned char *lanes[16];
+    for (int l = 0; l < 16; l++) {
+        lanes[l] = blocks[l];
+    }
+    sm3_16x_compress_lanes(ctx, lanes);
+}
+
+// 16通道最终处理函数
+void sm3_16x_final(sm3_16x_context *ctx, unsigned char outputs[16][32]) {
+    uint32_t temp_states[8][16];
+
+    for (int i = 0; i < 8; i++) {
+        _mm512_storeu_si512((void*)temp_states[i], ctx->state[i]);
+    }
+
+    for (int ch = 0; ch < 16; ch++) {
+        for (int i = 0; i < 8; i++) {
+            uint32_t val = temp_states[i][ch];
+            outputs[ch][i*4] = (unsigned char)(val >> 24);
+            outputs[ch][i*4+1] = (unsigned char)(val >> 16);
+            outputs[ch][i*4+2] = (unsigned char)(val >> 8);
+            outputs[ch][i*4+3] = (unsigned char)val;
+        }
+    }
+}
+
+// 16通道收尾 (与 sm3_8x_finish 相同的填充规则)
+void sm3_16x_finish(sm3_16x_context *ctx, const unsigned char *inputs[16], const size_t ilens[16],
+                    const uint64_t prefix_lens[16], unsigned char outputs[16][32]) {
+    unsigned char tail[16][128];
+    size_t msg_blocks[16];
+    size_t total_blocks[16];
+    size_t max_total_blocks = 0;
+
+    for (int ch = 0; ch < 16; ch++) {
+        size_t rem = ilens[ch] % 64;
+        size_t tail_len = (rem < 56) ? 64 : 128;
+        uint64_t total_bits = ((prefix_lens ? prefix_lens[ch] : 0) + (uint64_t)ilens[ch]) * 8;
+
+        msg_blocks[ch] = ilens[ch] / 64;
+        total_blocks[ch] = msg_blocks[ch] + tail_len / 64;
+
+        memset(tail[ch], 0, tail_len);
+        memcpy(tail[ch], inputs[ch] + msg_blocks[ch] * 64, rem);
+        tail[ch][rem] = 0x80;
+        // 追加 64 位长度 (大端序)
+        for (int k = 0; k < 8; k++) {
+            tail[ch][tail_len - 1 - k] = (unsigned char)(total_bits >> (k * 8));
+        }
+        if (total_blocks[ch] > max_total_blocks) {
+            max_total_blocks = total_blocks[ch];
+        }
+    }
+
+    const unsigned char *lanes[16];
+    for (size_t block_idx = 0; block_idx < max_total_blocks; block_idx++) {
+        __mmask16 mask = 0;
+        for (int ch = 0; ch < 16; ch++) {
+            if (block_idx < msg_blocks[ch]) {
+                lanes[ch] = inputs[ch] + block_idx * 64;
+                mask |= (__mmask16)(1u << ch);
+            } else if (block_idx < total_blocks[ch]) {
+                lanes[ch] = tail[ch] + (block_idx - msg_blocks[ch]) * 64;
+                mask |= (__mmask16)(1u << ch);
+            } else {
+                lanes[ch] = tail[ch]; // 已完成的通道：数据任意，结果被 active_mask 丢弃
+            }
+        }
+        ctx->active_mask = mask;
+        sm3_16x_compress_lanes(ctx, lanes);
+    }
+
+    ctx->active_mask = 0xFFFF;
+    sm3_16x_final(ctx, outputs);
+}
+
+// 16通道完整哈希计算
+void sm3_16x(const unsigned char *inputs[16], size_t ilens[16], unsigned char outputs[16][32]) {
+    sm3_16x_context ctx;
+    sm3_16x_starts(&ctx);
+    sm3_16x_finish(&ctx, inputs, ilens, NULL, outputs);
+}
+
+void sm3_16x_load_states(sm3_16x_context *ctx, const uint32_t *states[16]) {
+    uint32_t tmp[16];
+    for (int i = 0; i < 8; i++) {
+        for (int ch = 0; ch < 16; ch++) {
+            tmp[ch] = states[ch][i];
+        }
+        ctx->state[i] = _mm512_loadu_si512((const void*)tmp);
+    }
+    ctx->active_mask = 0xFFFF;
+}
+
+void sm3_16x_broadcast_state(sm3_16x_context *ctx, const uint32_t state[8]) {
+    for (int i = 0; i < 8; i++) {
+        ctx->state[i] = _mm512_set1_epi32((int)state[i]);
+    }
+    ctx->active_mask = 0xFFFF;
+}
@@ -0,0 +1,33 @@
+// author： https://github.com/8891689
+#ifndef SM3_AVX512_H
+#define SM3_AVX512_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <immintrin.h>
+
+// --- 16 通道 AVX-512 SM3 上下文和函数 ---
+// 接口与 sm3_avx.h 中的 8 通道版本一一对应，编译需要 -mavx512f -mavx512bw
+typedef struct {
+    __m512i state[8];
+    __mmask16 active_mask;
+} sm3_16x_context;
+
+// 16 通道 SM3 函数声明 (公共接口)
+void sm3_16x_starts(sm3_16x_context *ctx);
+void sm3_16x_compress(sm3_16x_context *ctx, const unsigned char blocks[16][64]);
+// 与 sm3_16x_compress 相同，但每个通道的 64 字节分组由独立指针给出
+void sm3_16x_compress_lanes(sm3_16x_context *ctx, const unsigned char *blocks[16]);
+// 消息字已在寄存器中按通道转置好 (words[i] 的第 ch 个 32 位元素为通道 ch 分组的第 i 个大端字)
+void sm3_16x_compress_words(sm3_16x_context *ctx, const __m512i words[16]);
+void sm3_16x_final(sm3_16x_context *ctx, unsigned char outputs[16][32]);
+// 从各通道当前状态出发处理剩余消息、完成填充并输出摘要；prefix_lens 为各通道已压缩的字节数 (可为 NULL)
+void sm3_16x_finish(sm3_16x_context *ctx, const unsigned char *inputs[16], const size_t ilens[16],
+                    const uint64_t prefix_lens[16], unsigned char outputs[16][32]);
+void sm3_16x(const unsigned char *inputs[16], size_t ilens[16], unsigned char outputs[16][32]);
+
+// 通道状态装载 (与 sm3_8x_load_states / sm3_8x_broadcast_state 对应)
+void sm3_16x_load_states(sm3_16x_context *ctx, const uint32_t *states[16]);
+void sm3_16x_broadcast_state(sm3_16x_context *ctx, const uint32_t state[8]);
+
+#endif // SM3_AVX512_H
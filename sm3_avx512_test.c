@@ -0,0 +1,151 @@
+//  gcc -O3 -mavx2 -mavx512f -mavx512bw -march=native sm3_avx.c sm3_avx512.c sm3_avx512_test.c -o sm3_avx512_test
+//  author： https://github.com/8891689
+#include <immintrin.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "sm3_avx.h"
+#include "sm3_avx512.h"
+
+static void print_hash(const char* label, const unsigned char* hash) {
+    printf("%s: ", label);
+    for (int i = 0; i < 32; i++) {
+        printf("%02x", hash[i]);
+        if ((i + 1) % 4 == 0) printf(" ");
+    }
+    printf("\n");
+}
+
+static double elapsed_sec(const struct timeval *start, const struct timeval *end) {
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_usec - start->tv_usec) / 1000000.0;
+}
+
+int main() {
+    int failures = 0;
+
+    printf("--- SM3 16-Channel AVX-512 Correctness Test ---\n");
+
+    // --- 'abc' 在 16 个通道上 ---
+    unsigned char ref_abc[32];
+    sm3_single((const unsigned char*)"abc", 3, ref_abc);
+    print_hash("Single channel 'abc' hash", ref_abc);
+
+    const unsigned char *abc_ptrs[16];
+    size_t abc_lens[16];
+    unsigned char outputs_16x[16][32];
+    for (int ch = 0; ch < 16; ch++) {
+        abc_ptrs[ch] = (const unsigned char*)"abc";
+        abc_lens[ch] = 3;
+    }
+    sm3_16x(abc_ptrs, abc_lens, outputs_16x);
+    int abc_ok = 1;
+    for (int ch = 0; ch < 16; ch++) {
+        if (memcmp(outputs_16x[ch], ref_abc, 32) != 0) abc_ok = 0;
+    }
+    print_hash("16-lane 'abc' hash (lane 15)", outputs_16x[15]);
+    printf("16-lane 'abc' vs single: %s\n", abc_ok ? "PASS" : "FAIL");
+    failures += !abc_ok;
+
+    // --- 各通道长度不同 (覆盖 0、55、56、64 等填充边界) ---
+    unsigned char data[16][400];
+    const unsigned char *ptrs[16];
+    size_t lens[16];
+    for (int ch = 0; ch < 16; ch++) {
+        for (int i = 0; i < 400; i++) data[ch][i] = (unsigned char)(i * 7 + ch * 13);
+        ptrs[ch] = data[ch];
+    }
+    int mixed_ok = 1;
+    for (size_t base = 0; base < 150; base++) {
+        for (int ch = 0; ch < 16; ch++) lens[ch] = (base * (ch + 1)) % 300;
+        sm3_16x(ptrs, lens, outputs_16x);
+        for (int ch = 0; ch < 16; ch++) {
+            unsigned char ref[32];
+            sm3_single(ptrs[ch], lens[ch], ref);
+            if (memcmp(ref, outputs_16x[ch], 32) != 0) mixed_ok = 0;
+        }
+    }
+    printf("16-lane vs single (mixed lengths 0..299): %s\n", mixed_ok ? "PASS" : "FAIL");
+    failures += !mixed_ok;
+
+    // --- 广播前缀状态 + 各通道后缀 ---
+    sm3_context prefix_ctx;
+    sm3_starts(&prefix_ctx);
+    sm3_compress(prefix_ctx.state, data[0]);
+    sm3_16x_context ctx;
+    sm3_16x_broadcast_state(&ctx, prefix_ctx.state);
+    const unsigned char *suffix_ptrs[16];
+    size_t suffix_lens[16];
+    uint64_t prefix_lens[16];
+    for (int ch = 0; ch < 16; ch++) {
+        suffix_ptrs[ch] = data[0] + 64;
+        suffix_lens[ch] = (size_t)ch * 9;
+        prefix_lens[ch] = 64;
+    }
+    sm3_16x_finish(&ctx, suffix_ptrs, suffix_lens, prefix_lens, outputs_16x);
+    int bcast_ok = 1;
+    for (int ch = 0; ch < 16; ch++) {
+        unsigned char ref[32];
+        sm3_single(data[0], 64 + suffix_lens[ch], ref);
+        if (memcmp(ref, outputs_16x[ch], 32) != 0) bcast_ok = 0;
+    }
+    printf("Broadcast state + per-lane suffix: %s\n", bcast_ok ? "PASS" : "FAIL");
+    failures += !bcast_ok;
+
+    // --- 吞吐量测试部分 (与 sm3_avx_test 相同方法：每通道 1MB，100 次迭代) ---
+    printf("\n--- Throughput: 8-Channel AVX2 vs 16-Channel AVX-512 SM3 ---\n");
+
+    const size_t TEST_MESSAGE_SIZE = 1 * 1024 * 1024;
+    const int NUM_ITERATIONS = 100;
+
+    unsigned char* large_inputs[16];
+    size_t large_ilens[16];
+    unsigned char dummy_8x[8][32];
+    unsigned char dummy_16x[16][32];
+
+    for (int ch = 0; ch < 16; ++ch) {
+        large_inputs[ch] = (unsigned char*)malloc(TEST_MESSAGE_SIZE);
+        if (!large_inputs[ch]) {
+            perror("Failed to allocate memory for large input");
+            return 1;
+        }
+        memset(large_inputs[ch], ch + 'A', TEST_MESSAGE_SIZE);
+        large_ilens[ch] = TEST_MESSAGE_SIZE;
+    }
+
+    struct timeval start, end;
+    double mbps_8x, mbps_16x;
+
+    for (int i = 0; i < NUM_ITERATIONS / 10; ++i) {
+        sm3_8x((const unsigned char **)large_inputs, large_ilens, dummy_8x);
+    }
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+        sm3_8x((const unsigned char **)large_inputs, large_ilens, dummy_8x);
+    }
+    gettimeofday(&end, NULL);
+    mbps_8x = (double)NUM_ITERATIONS * 8 * TEST_MESSAGE_SIZE / elapsed_sec(&start, &end) / (1024.0 * 1024.0);
+
+    for (int i = 0; i < NUM_ITERATIONS / 10; ++i) {
+        sm3_16x((const unsigned char **)large_inputs, large_ilens, dummy_16x);
+    }
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < NUM_ITERATIONS; ++i) {
+        sm3_16x((const unsigned char **)large_inputs, large_ilens, dummy_16x);
+    }
+    gettimeofday(&end, NULL);
+    mbps_16x = (double)NUM_ITERATIONS * 16 * TEST_MESSAGE_SIZE / elapsed_sec(&start, &end) / (1024.0 * 1024.0);
+
+    int bulk_ok = memcmp(dummy_8x[3], dummy_16x[3], 32) == 0;
+    printf("sm3_8x  (AVX2,    8 lanes): %10.2f MB/s\n", mbps_8x);
+    printf("sm3_16x (AVX-512, 16 lanes): %9.2f MB/s  (%.2fx)\n", mbps_16x, mbps_16x / mbps_8x);
+    printf("1MB lane digest 8x == 16x: %s\n", bulk_ok ? "PASS" : "FAIL");
+    failures += !bulk_ok;
+
+    for (int ch = 0; ch < 16; ++ch) {
+        free(large_inputs[ch]);
+    }
+
+    return failures ? 1 : 0;
+}
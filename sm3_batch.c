@@ -0,0 +1,204 @@
+// author： https://github.com/8891689
+// sm3_batch.c
+#include "sm3_batch.h"
+#include "sm3_avx.h"
+#include <string.h>
+#include <immintrin.h>
+
+static const uint32_t SM3_IV[8] = {
+    0x7380166F, 0x4914B2B9, 0x172442D7, 0xDA8A0600,
+    0xA96F30BC, 0x163138AA, 0xE38DEE4D, 0xB0FB0E4E
+};
+
+// 作业调度器中一个通道当前承载的记录
+typedef struct {
+    const unsigned char *msg;
+    size_t len;
+    size_t index;    // 摘要输出位置
+    size_t block;    // 下一个要压缩的分组序号
+    size_t nblocks;  // 含填充在内的分组总数
+} sm3_batch_lane;
+
+// 位掩码 -> 每通道 32 位全 1 / 全 0 的向量掩码
+static inline __m256i lane_mask_from_bits(unsigned bits) {
+    const __m256i sel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i v = _mm256_and_si256(_mm256_set1_epi32((int)bits), sel);
+    return _mm256_cmpeq_epi32(v, sel);
+}
+
+// 直接在寄存器中构造一个通道的 64 字节分组 (消息字节 + 0x80 + 零 + 长度)，并翻转为大端字
+static inline void build_row(const unsigned char *p, int keep, int pad_pos, int last, uint64_t bits,
+                             __m256i *lo, __m256i *hi) {
+    const __m256i iota_lo = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                             16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+    const __m256i iota_hi = _mm256_add_epi8(iota_lo, _mm256_set1_epi8(32));
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i a, b;
+
+    if (keep >= 64) {
+        a = _mm256_loadu_si256((const __m256i*)p);
+        b = _mm256_loadu_si256((const __m256i*)(p + 32));
+    } else {
+        __m256i vkeep = _mm256_set1_epi8((char)keep);
+        __m256i vpad = _mm256_set1_epi8((char)pad_pos);
+        __m256i b80 = _mm256_set1_epi8((char)0x80);
+        if (keep > 0) {
+            a = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)p), _mm256_cmpgt_epi8(vkeep, iota_lo));
+            b = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(p + 32)), _mm256_cmpgt_epi8(vkeep, iota_hi));
+        } else {
+            a = _mm256_setzero_si256();
+            b = _mm256_setzero_si256();
+        }
+        a = _mm256_or_si256(a, _mm256_and_si256(_mm256_cmpeq_epi8(vpad, iota_lo), b80));
+        b = _mm256_or_si256(b, _mm256_and_si256(_mm256_cmpeq_epi8(vpad, iota_hi), b80));
+    }
+
+    a = _mm256_shuffle_epi8(a, bswap);
+    b = _mm256_shuffle_epi8(b, bswap);
+    if (last) {
+        // 字 14、15 为 64 位比特长度 (大端)
+        __m256i len_words = _mm256_setr_epi32(0, 0, 0, 0, 0, 0, (int)(uint32_t)(bits >> 32), (int)(uint32_t)bits);
+        b = _mm256_blend_epi32(b, len_words, 0xC0);
+    }
+    *lo = a;
+    *hi = b;
+}
+
+// 8x8 的 32 位转置：r[ch] 为通道 ch 的 8 个字，输出 t[i] 的第 ch 个元素为 r[ch][i]
+static inline void transpose_8x8(const __m256i r[8], __m256i t[8]) {
+    __m256i a0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    __m256i a1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    __m256i a2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    __m256i a3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    __m256i a4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    __m256i a5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    __m256i a6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    __m256i a7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    __m256i b0 = _mm256_unpacklo_epi64(a0, a2);
+    __m256i b1 = _mm256_unpackhi_epi64(a0, a2);
+    __m256i b2 = _mm256_unpacklo_epi64(a1, a3);
+    __m256i b3 = _mm256_unpackhi_epi64(a1, a3);
+    __m256i b4 = _mm256_unpacklo_epi64(a4, a6);
+    __m256i b5 = _mm256_unpackhi_epi64(a4, a6);
+    __m256i b6 = _mm256_unpacklo_epi64(a5, a7);
+    __m256i b7 = _mm256_unpackhi_epi64(a5, a7);
+
+    t[0] = _mm256_permute2x128_si256(b0, b4, 0x20);
+    t[1] = _mm256_permute2x128_si256(b1, b5, 0x20);
+    t[2] = _mm256_permute2x128_si256(b2, b6, 0x20);
+    t[3] = _mm256_permute2x128_si256(b3, b7, 0x20);
+    t[4] = _mm256_permute2x128_si256(b0, b4, 0x31);
+    t[5] = _mm256_permute2x128_si256(b1, b5, 0x31);
+    t[6] = _mm256_permute2x128_si256(b2, b6, 0x31);
+    t[7] = _mm256_permute2x128_si256(b3, b7, 0x31);
+}
+
+void sm3_batch(const unsigned char *buf, size_t buf_len, const size_t *offsets, const size_t *lens,
+               size_t count, unsigned char (*digests)[32]) {
+    sm3_8x_context ctx;
+    sm3_batch_lane lanes[8];
+    size_t next = 0;
+    size_t packed_off = 0;
+    unsigned active = 0;
+    unsigned loaded_active = 0xFF;
+
+    if (count == 0) {
+        return;
+    }
+    sm3_8x_starts(&ctx);
+
+    // 取下一条记录装入通道，没有剩余记录时通道变为空闲
+    #define ASSIGN_LANE(ch) do { \
+        if (next < count) { \
+            size_t off_ = offsets ? offsets[next] : packed_off; \
+            lanes[ch].msg = buf + off_; \
+            lanes[ch].len = lens[next]; \
+            lanes[ch].index = next; \
+            lanes[ch].block = 0; \
+            lanes[ch].nblocks = (lens[next] + 8) / 64 + 1; \
+            packed_off += lens[next]; \
+            next++; \
+            active |= 1u << (ch); \
+        } else { \
+            active &= ~(1u << (ch)); \
+        } \
+    } while (0)
+
+    for (int ch = 0; ch < 8; ch++) {
+        ASSIGN_LANE(ch);
+    }
+
+    while (active) {
+        __m256i lo[8], hi[8], w[16];
+
+        for (int ch = 0; ch < 8; ch++) {
+            if (!(active & (1u << ch))) {
+                lo[ch] = _mm256_setzero_si256();
+                hi[ch] = _mm256_setzero_si256();
+                continue;
+            }
+            const sm3_batch_lane *ln = &lanes[ch];
+            size_t start = ln->block * 64;
+            size_t avail = start < ln->len ? ln->len - start : 0;
+            int keep = avail >= 64 ? 64 : (int)avail;
+            int pad_pos = start <= ln->len && avail < 64 ? (int)(ln->len - start) : -1;
+            int last = ln->block + 1 == ln->nblocks;
+            const unsigned char *p = ln->msg + start;
+            unsigned char tmp[64];
+
+            // 记录位于缓冲区末尾时不能整块读取 64 字节，先拷贝到栈上
+            if (keep > 0 && (size_t)(p - buf) + 64 > buf_len) {
+                memset(tmp, 0, sizeof(tmp));
+                memcpy(tmp, p, (size_t)keep);
+                p = tmp;
+            }
+            build_row(p, keep, pad_pos, last, (uint64_t)ln->len * 8, &lo[ch], &hi[ch]);
+        }
+        transpose_8x8(lo, w);
+        transpose_8x8(hi, w + 8);
+
+        // 掩码只在通道变为空闲时变化 (批次末尾)
+        if (active != loaded_active) {
+            ctx.active_mask = lane_mask_from_bits(active);
+            loaded_active = active;
+        }
+        sm3_8x_compress_words(&ctx, w);
+
+        unsigned done = 0;
+        for (int ch = 0; ch < 8; ch++) {
+            if ((active & (1u << ch)) && ++lanes[ch].block == lanes[ch].nblocks) {
+                done |= 1u << ch;
+            }
+        }
+        if (!done) {
+            continue;
+        }
+
+        uint32_t st[8][8];
+        for (int i = 0; i < 8; i++) {
+            _mm256_storeu_si256((__m256i*)st[i], ctx.state[i]);
+        }
+        for (int ch = 0; ch < 8; ch++) {
+            if (!(done & (1u << ch))) {
+                continue;
+            }
+            unsigned char *out = digests[lanes[ch].index];
+            for (int i = 0; i < 8; i++) {
+                out[i*4]   = (unsigned char)(st[i][ch] >> 24);
+                out[i*4+1] = (unsigned char)(st[i][ch] >> 16);
+                out[i*4+2] = (unsigned char)(st[i][ch] >> 8);
+                out[i*4+3] = (unsigned char)(st[i][ch]);
+            }
+            ASSIGN_LANE(ch);
+        }
+        // 完成的通道重新装载 IV
+        __m256i reset = lane_mask_from_bits(done);
+        for (int i = 0; i < 8; i++) {
+            ctx.state[i] = _mm256_blendv_epi8(ctx.state[i], _mm256_set1_epi32((int)SM3_IV[i]), reset);
+        }
+    }
+
+    #undef ASSIGN_LANE
+}
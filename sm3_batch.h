@@ -0,0 +1,34 @@
+// author： https://github.com/8891689
+// sm3_batch.h
+#ifndef SM3_BATCH_H
+#define SM3_BATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 批量计算大量短记录的 SM3 摘要 (去重指纹、Merkle 叶子等)
+ *
+ * 所有记录位于同一个紧凑缓冲区中，第 i 条记录为 buf[offsets[i] .. offsets[i] + lens[i])。
+ * 内部的作业调度器让 8 个 AVX2 通道始终装满：某个通道的记录结束后立即换入下一条记录，
+ * 填充分组直接在寄存器中构造并转置，不经过 memset/memcpy。
+ *
+ * @param buf      紧凑缓冲区
+ * @param buf_len  缓冲区总长度；用于判断能否整块读取 64 字节，记录不得越过 buf_len
+ * @param offsets  每条记录的起始偏移；为 NULL 表示记录首尾相接，从偏移 0 开始
+ * @param lens     每条记录的长度
+ * @param count    记录数
+ * @param digests  输出，count 个 32 字节摘要
+ */
+void sm3_batch(const unsigned char *buf, size_t buf_len, const size_t *offsets, const size_t *lens,
+               size_t count, unsigned char (*digests)[32]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM3_BATCH_H
@@ -0,0 +1,126 @@
+//  gcc -O3 -mavx2 -march=native sm3_avx.c sm3_batch.c sm3_batch_test.c -o sm3_batch_test
+//  author： https://github.com/8891689
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include "sm3_avx.h"
+#include "sm3_batch.h"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// 与 sm3_single 逐条比较
+static int check_records(const unsigned char *buf, const size_t *offsets, const size_t *lens,
+                         size_t count, unsigned char (*digests)[32]) {
+    size_t off = 0;
+    for (size_t i = 0; i < count; i++) {
+        unsigned char ref[32];
+        size_t o = offsets ? offsets[i] : off;
+        sm3_single(buf + o, lens[i], ref);
+        if (memcmp(ref, digests[i], 32) != 0) {
+            return 0;
+        }
+        off += lens[i];
+    }
+    return 1;
+}
+
+int main() {
+    int failures = 0;
+
+    printf("--- SM3 Batch Correctness Test ---\n");
+
+    // 长度 0..600 的记录首尾相接，最后一条正好结束在缓冲区末尾
+    const size_t count = 601;
+    size_t *lens = (size_t*)malloc(count * sizeof(size_t));
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        lens[i] = (i * 37) % 601;
+        total += lens[i];
+    }
+    unsigned char *buf = (unsigned char*)malloc(total);
+    unsigned char (*digests)[32] = malloc(count * 32);
+    for (size_t i = 0; i < total; i++) buf[i] = (unsigned char)(i * 131 + (i >> 9));
+
+    sm3_batch(buf, total, NULL, lens, count, digests);
+    int packed_ok = check_records(buf, NULL, lens, count, digests);
+    printf("Packed records (lengths 0..600, offsets NULL): %s\n", packed_ok ? "PASS" : "FAIL");
+    failures += !packed_ok;
+
+    // 显式偏移：乱序、重叠的记录
+    size_t *offsets = (size_t*)malloc(count * sizeof(size_t));
+    for (size_t i = 0; i < count; i++) {
+        lens[i] = (i * 13) % 129;
+        offsets[i] = (i % 5 == 0) ? total - lens[i] : (i * 7919) % (total - lens[i] + 1);
+    }
+    sm3_batch(buf, total, offsets, lens, count, digests);
+    int offs_ok = check_records(buf, offsets, lens, count, digests);
+    printf("Explicit offsets (overlapping, up to buffer end): %s\n", offs_ok ? "PASS" : "FAIL");
+    failures += !offs_ok;
+
+    // 记录数不是 8 的倍数
+    int small_ok = 1;
+    for (size_t n = 1; n <= 17; n++) {
+        sm3_batch(buf, total, offsets, lens, n, digests);
+        small_ok &= check_records(buf, offsets, lens, n, digests);
+    }
+    printf("Batch sizes 1..17: %s\n", small_ok ? "PASS" : "FAIL");
+    failures += !small_ok;
+
+    free(offsets);
+    free(digests);
+    free(buf);
+    free(lens);
+
+    // --- 吞吐量测试部分 ---
+    printf("\n--- Throughput: records/s ---\n");
+    printf("%-8s %14s %14s %14s\n", "size", "sm3_single", "sm3_8x", "sm3_batch");
+
+    const size_t N = 1 << 18;
+    const size_t sizes[4] = {32, 64, 128, 512};
+    for (int s = 0; s < 4; s++) {
+        size_t rec = sizes[s];
+        unsigned char *data = (unsigned char*)malloc(N * rec);
+        size_t *rec_lens = (size_t*)malloc(N * sizeof(size_t));
+        unsigned char (*out)[32] = malloc(N * 32);
+        for (size_t i = 0; i < N * rec; i++) data[i] = (unsigned char)(i * 7);
+        for (size_t i = 0; i < N; i++) rec_lens[i] = rec;
+
+        double t0 = now_sec();
+        for (size_t i = 0; i < N; i++) {
+            sm3_single(data + i * rec, rec, out[i]);
+        }
+        double r_single = N / (now_sec() - t0);
+
+        t0 = now_sec();
+        for (size_t i = 0; i < N; i += 8) {
+            const unsigned char *ptrs[8];
+            size_t l8[8];
+            for (int ch = 0; ch < 8; ch++) {
+                ptrs[ch] = data + (i + ch) * rec;
+                l8[ch] = rec;
+            }
+            sm3_8x(ptrs, l8, (unsigned char (*)[32])out[i]);
+        }
+        double r_8x = N / (now_sec() - t0);
+
+        t0 = now_sec();
+        sm3_batch(data, N * rec, NULL, rec_lens, N, out);
+        double r_batch = N / (now_sec() - t0);
+
+        int ok = check_records(data, NULL, rec_lens, 64, out);
+        printf("%-8zu %14.0f %14.0f %14.0f  %s\n", rec, r_single, r_8x, r_batch, ok ? "" : "(MISMATCH)");
+        failures += !ok;
+
+        free(out);
+        free(rec_lens);
+        free(data);
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+// author： https://github.com/8891689
+// sm3_hmac.c
+#include "sm3_hmac.h"
+#include "sm3_avx.h"
+#include <string.h>
+
+#define SM3_BLOCK_SIZE 64
+
+// 从给定链接状态出发压缩剩余消息并完成填充，prefix_len 为已压缩的字节数
+static void sm3_finish_state(uint32_t state[8], const unsigned char *msg, size_t len,
+                             uint64_t prefix_len, unsigned char out[32]) {
+    unsigned char block[128];
+    uint64_t total_bits = (prefix_len + (uint64_t)len) * 8;
+
+    while (len >= SM3_BLOCK_SIZE) {
+        sm3_compress(state, msg);
+        msg += SM3_BLOCK_SIZE;
+        len -= SM3_BLOCK_SIZE;
+    }
+
+    size_t tail_len = (len < 56) ? 64 : 128;
+    memset(block, 0, tail_len);
+    memcpy(block, msg, len);
+    block[len] = 0x80;
+    for (int k = 0; k < 8; k++) {
+        block[tail_len - 1 - k] = (unsigned char)(total_bits >> (k * 8));
+    }
+    sm3_compress(state, block);
+    if (tail_len == 128) {
+        sm3_compress(state, block + 64);
+    }
+
+    for (int k = 0; k < 8; k++) {
+        out[k*4]   = (unsigned char)(state[k] >> 24);
+        out[k*4+1] = (unsigned char)(state[k] >> 16);
+        out[k*4+2] = (unsigned char)(state[k] >> 8);
+        out[k*4+3] = (unsigned char)(state[k]);
+    }
+}
+
+// 常数时间比较，相等返回 1
+static int ct_equal(const unsigned char *a, const unsigned char *b, size_t n) {
+    unsigned char diff = 0;
+    for (size_t i = 0; i < n; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return (int)((((unsigned int)diff) - 1) >> 8) & 1;
+}
+
+void sm3_hmac_key_init(sm3_hmac_key *hk, const unsigned char *key, size_t key_len) {
+    unsigned char k0[SM3_BLOCK_SIZE];
+    unsigned char pad[SM3_BLOCK_SIZE];
+    sm3_context ctx;
+
+    memset(k0, 0, sizeof(k0));
+    if (key_len > SM3_BLOCK_SIZE) {
+        sm3_single(key, key_len, k0);
+    } else if (key_len > 0) {
+        memcpy(k0, key, key_len);
+    }
+
+    for (int i = 0; i < SM3_BLOCK_SIZE; i++) pad[i] = k0[i] ^ 0x36;
+    sm3_starts(&ctx);
+    sm3_compress(ctx.state, pad);
+    memcpy(hk->ipad_state, ctx.state, sizeof(hk->ipad_state));
+
+    for (int i = 0; i < SM3_BLOCK_SIZE; i++) pad[i] = k0[i] ^ 0x5c;
+    sm3_starts(&ctx);
+    sm3_compress(ctx.state, pad);
+    memcpy(hk->opad_state, ctx.state, sizeof(hk->opad_state));
+
+    memset(k0, 0, sizeof(k0));
+    memset(pad, 0, sizeof(pad));
+}
+
+void sm3_hmac_key_clear(sm3_hmac_key *hk) {
+    volatile unsigned char *p = (volatile unsigned char*)hk;
+    for (size_t i = 0; i < sizeof(*hk); i++) {
+        p[i] = 0;
+    }
+}
+
+void sm3_hmac(const sm3_hmac_key *hk, const unsigned char *msg, size_t len, unsigned char mac[SM3_HMAC_SIZE]) {
+    uint32_t state[8];
+    unsigned char inner[32];
+
+    memcpy(state, hk->ipad_state, sizeof(state));
+    sm3_finish_state(state, msg, len, SM3_BLOCK_SIZE, inner);
+
+    // 外层只有 32 字节摘要，加上填充正好一个分组
+    memcpy(state, hk->opad_state, sizeof(state));
+    sm3_finish_state(state, inner, sizeof(inner), SM3_BLOCK_SIZE, mac);
+}
+
+void sm3_hmac_8x(const sm3_hmac_key *keys[8], const unsigned char *msgs[8], const size_t lens[8],
+                 unsigned char macs[8][SM3_HMAC_SIZE]) {
+    static const sm3_hmac_key unused_key;
+    static const unsigned char empty[1];
+    const uint32_t *states[8];
+    const unsigned char *lane_msgs[8];
+    size_t lane_lens[8];
+    const uint64_t prefix[8] = {64, 64, 64, 64, 64, 64, 64, 64};
+    unsigned char inner[8][32];
+    unsigned char outer[8][32];
+    sm3_8x_context ctx;
+
+    // 内层：K^ipad 之后的状态 + 消息
+    for (int ch = 0; ch < 8; ch++) {
+        const sm3_hmac_key *k = keys[ch] ? keys[ch] : &unused_key;
+        states[ch] = k->ipad_state;
+        lane_msgs[ch] = keys[ch] ? msgs[ch] : empty;
+        lane_lens[ch] = keys[ch] ? lens[ch] : 0;
+    }
+    sm3_8x_load_states(&ctx, states);
+    sm3_8x_finish(&ctx, lane_msgs, lane_lens, prefix, inner);
+
+    // 外层：K^opad 之后的状态 + 内层摘要 (一个分组)
+    for (int ch = 0; ch < 8; ch++) {
+        const sm3_hmac_key *k = keys[ch] ? keys[ch] : &unused_key;
+        states[ch] = k->opad_state;
+        lane_msgs[ch] = inner[ch];
+        lane_lens[ch] = 32;
+    }
+    sm3_8x_load_states(&ctx, states);
+    sm3_8x_finish(&ctx, lane_msgs, lane_lens, prefix, outer);
+
+    for (int ch = 0; ch < 8; ch++) {
+        if (keys[ch]) {
+            memcpy(macs[ch], outer[ch], SM3_HMAC_SIZE);
+        }
+    }
+}
+
+int sm3_hmac_verify(const sm3_hmac_key *hk, const unsigned char *msg, size_t len,
+                    const unsigned char *tag, size_t tag_len) {
+    unsigned char mac[SM3_HMAC_SIZE];
+    if (tag_len == 0 || tag_len > SM3_HMAC_SIZE) {
+        return 0;
+    }
+    sm3_hmac(hk, msg, len, mac);
+    int ok = ct_equal(mac, tag, tag_len);
+    memset(mac, 0, sizeof(mac));
+    return ok;
+}
+
+int sm3_hmac_verify_8x(const sm3_hmac_key *keys[8], const unsigned char *msgs[8], const size_t lens[8],
+                       const unsigned char *tags[8], size_t tag_len) {
+    unsigned char macs[8][SM3_HMAC_SIZE];
+    int result = 0;
+
+    if (tag_len == 0 || tag_len > SM3_HMAC_SIZE) {
+        return 0;
+    }
+    sm3_hmac_8x(keys, msgs, lens, macs);
+    for (int ch = 0; ch < 8; ch++) {
+        if (keys[ch]) {
+            result |= ct_equal(macs[ch], tags[ch], tag_len) << ch;
+        }
+    }
+    memset(macs, 0, sizeof(macs));
+    return result;
+}
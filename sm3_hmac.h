@@ -0,0 +1,62 @@
+// author： https://github.com/8891689
+// sm3_hmac.h
+#ifndef SM3_HMAC_H
+#define SM3_HMAC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SM3_HMAC_SIZE 32
+
+// HMAC-SM3 密钥上下文：缓存 (K ^ ipad)、(K ^ opad) 压缩后的链接状态，
+// 之后每条消息只需压缩自身分组再加一次外层压缩。
+typedef struct {
+    uint32_t ipad_state[8];
+    uint32_t opad_state[8];
+} sm3_hmac_key;
+
+/**
+ * @brief 预计算 HMAC-SM3 密钥上下文 (超过 64 字节的密钥先做 SM3)
+ */
+void sm3_hmac_key_init(sm3_hmac_key *hk, const unsigned char *key, size_t key_len);
+
+/**
+ * @brief 清除密钥上下文
+ */
+void sm3_hmac_key_clear(sm3_hmac_key *hk);
+
+/**
+ * @brief 单条消息 HMAC-SM3
+ */
+void sm3_hmac(const sm3_hmac_key *hk, const unsigned char *msg, size_t len, unsigned char mac[SM3_HMAC_SIZE]);
+
+/**
+ * @brief 8 通道 HMAC-SM3，每个通道可使用不同的密钥上下文
+ * keys[ch] 为 NULL 的通道不计算，macs[ch] 不被写入。
+ */
+void sm3_hmac_8x(const sm3_hmac_key *keys[8], const unsigned char *msgs[8], const size_t lens[8],
+                 unsigned char macs[8][SM3_HMAC_SIZE]);
+
+/**
+ * @brief 校验单条消息的标签（常数时间比较），tag_len 取 1..32 支持截断标签
+ * @return 标签正确返回 1，否则返回 0
+ */
+int sm3_hmac_verify(const sm3_hmac_key *hk, const unsigned char *msg, size_t len,
+                    const unsigned char *tag, size_t tag_len);
+
+/**
+ * @brief 在 8 个通道上批量校验 8 条消息（可使用不同密钥），比较为常数时间
+ * @return 位掩码，第 ch 位为 1 表示通道 ch 校验通过；keys[ch] 为 NULL 的通道为 0
+ */
+int sm3_hmac_verify_8x(const sm3_hmac_key *keys[8], const unsigned char *msgs[8], const size_t lens[8],
+                       const unsigned char *tags[8], size_t tag_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM3_HMAC_H
@@ -0,0 +1,54 @@
+// author： https://github.com/8891689
+// sm3_kdf.c
+#include "sm3_kdf.h"
+#include "sm3_avx.h"
+#include <string.h>
+
+void sm3_kdf(const unsigned char *z, size_t zlen, unsigned char *out, size_t klen) {
+    sm3_context prefix;
+    sm3_8x_context ctx;
+    size_t full_blocks = zlen / 64;
+    size_t rem = zlen % 64;
+    unsigned char tails[8][64 + 4];
+    const unsigned char *lanes[8];
+    size_t lens[8];
+    uint64_t prefix_lens[8];
+    unsigned char digests[8][32];
+    uint32_t ct = 1;
+
+    // Z 的公共前缀只压缩一次
+    sm3_starts(&prefix);
+    for (size_t i = 0; i < full_blocks; i++) {
+        sm3_compress(prefix.state, z + i * 64);
+    }
+
+    for (int ch = 0; ch < 8; ch++) {
+        memcpy(tails[ch], z + full_blocks * 64, rem);
+        lanes[ch] = tails[ch];
+        lens[ch] = rem + 4;
+        prefix_lens[ch] = (uint64_t)full_blocks * 64;
+    }
+
+    while (klen > 0) {
+        // 前缀状态广播到全部通道，每个通道只处理 Z 的剩余字节 + 计数器
+        sm3_8x_broadcast_state(&ctx, prefix.state);
+        for (int ch = 0; ch < 8; ch++) {
+            uint32_t c = ct + (uint32_t)ch;
+            tails[ch][rem]     = (unsigned char)(c >> 24);
+            tails[ch][rem + 1] = (unsigned char)(c >> 16);
+            tails[ch][rem + 2] = (unsigned char)(c >> 8);
+            tails[ch][rem + 3] = (unsigned char)c;
+        }
+        sm3_8x_finish(&ctx, lanes, lens, prefix_lens, digests);
+
+        size_t n = (klen < sizeof(digests)) ? klen : sizeof(digests);
+        memcpy(out, digests, n);
+        out += n;
+        klen -= n;
+        ct += 8;
+    }
+
+    memset(digests, 0, sizeof(digests));
+    memset(tails, 0, sizeof(tails));
+    memset(&prefix, 0, sizeof(prefix));
+}
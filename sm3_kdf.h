@@ -0,0 +1,30 @@
+// author： https://github.com/8891689
+// sm3_kdf.h
+#ifndef SM3_KDF_H
+#define SM3_KDF_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief GB/T 32918 (SM2) 密钥派生函数: K = SM3(Z || ct) || SM3(Z || ct+1) || ...，ct 从 1 开始
+ *
+ * Z 的完整分组只压缩一次，其链接状态广播到 8 个通道，
+ * 每次 8 通道压缩产生 8 个计数器值的输出 (256 字节)。
+ *
+ * @param z    共享秘密 Z
+ * @param zlen Z 的长度（字节）
+ * @param out  输出缓冲区
+ * @param klen 需要派生的字节数
+ */
+void sm3_kdf(const unsigned char *z, size_t zlen, unsigned char *out, size_t klen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM3_KDF_H
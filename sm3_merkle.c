@@ -0,0 +1,253 @@
+// author： https://github.com/8891689
+// sm3_merkle.c
+#include "sm3_merkle.h"
+#include "sm3_avx.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define NODE_SIZE 32
+
+// 节点标记字节，区分内部节点与 64 字节数据的 SM3 (叶子)
+#define NODE_TAG 0x01
+
+// 内部节点的输入为 left || right || 0x01 共 65 字节，第二个分组是固定的：0x01、0x80、零、比特长度 520
+static const unsigned char pad_block_65[64] = {
+    NODE_TAG, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x08
+};
+
+static void store_state_be(const uint32_t state[8], unsigned char out[32]) {
+    for (int k = 0; k < 8; k++) {
+        out[k*4]   = (unsigned char)(state[k] >> 24);
+        out[k*4+1] = (unsigned char)(state[k] >> 16);
+        out[k*4+2] = (unsigned char)(state[k] >> 8);
+        out[k*4+3] = (unsigned char)(state[k]);
+    }
+}
+
+// 单个父节点：SM3(left || right || 0x01)，两个子节点在扁平数组中相邻
+static void hash_pair(const unsigned char lr[64], unsigned char out[32]) {
+    sm3_context ctx;
+    sm3_starts(&ctx);
+    sm3_compress(ctx.state, lr);
+    sm3_compress(ctx.state, pad_block_65);
+    store_state_be(ctx.state, out);
+}
+
+// 一层的 npairs 个父节点，8 对一组：第一次压缩直接读取子节点存储，第二次压缩使用固定填充字
+static void hash_level_8x(const unsigned char *src, size_t npairs, unsigned char *dst) {
+    __m256i pad_words[16];
+    for (int i = 0; i < 16; i++) {
+        pad_words[i] = _mm256_setzero_si256();
+    }
+    pad_words[0] = _mm256_set1_epi32((int)((uint32_t)NODE_TAG << 24 | 0x800000U));
+    pad_words[15] = _mm256_set1_epi32(520);
+
+    for (size_t i = 0; i < npairs; i += 8) {
+        size_t m = npairs - i < 8 ? npairs - i : 8;
+        const unsigned char *lanes[8];
+        sm3_8x_context ctx;
+
+        for (size_t ch = 0; ch < 8; ch++) {
+            // 不足 8 对时多余通道重复读取第一对，结果丢弃
+            lanes[ch] = src + (i + (ch < m ? ch : 0)) * 64;
+        }
+        sm3_8x_starts(&ctx);
+        sm3_8x_compress_lanes(&ctx, lanes);
+        sm3_8x_compress_words(&ctx, pad_words);
+
+        if (m == 8) {
+            sm3_8x_final(&ctx, (unsigned char (*)[32])(dst + i * NODE_SIZE));
+        } else {
+            unsigned char out[8][32];
+            sm3_8x_final(&ctx, out);
+            memcpy(dst + i * NODE_SIZE, out, m * NODE_SIZE);
+        }
+    }
+}
+
+static unsigned char *node_at(const sm3_merkle *t, unsigned level, size_t index) {
+    return t->nodes + (t->level_off[level] + index) * NODE_SIZE;
+}
+
+// 容量为 cap 时第 k 层的起始位置：cap + cap/2 + ... 依次排列
+static void layout_levels(size_t cap, size_t level_off[SM3_MERKLE_MAX_DEPTH]) {
+    size_t off = 0;
+    size_t width = cap;
+    for (unsigned k = 0; k < SM3_MERKLE_MAX_DEPTH; k++) {
+        level_off[k] = off;
+        off += width;
+        width = width > 1 ? width / 2 : 1;
+    }
+}
+
+static size_t total_nodes(size_t cap) {
+    return 2 * cap;
+}
+
+// 扩容到至少 need 个叶子，已有各层节点按新布局搬移
+static int reserve(sm3_merkle *t, size_t need) {
+    if (need <= t->capacity) {
+        return 0;
+    }
+    size_t cap = t->capacity ? t->capacity : 1;
+    while (cap < need) {
+        cap *= 2;
+    }
+
+    unsigned char *nodes = (unsigned char*)malloc(total_nodes(cap) * NODE_SIZE);
+    if (!nodes) {
+        return -1;
+    }
+    size_t off[SM3_MERKLE_MAX_DEPTH];
+    layout_levels(cap, off);
+
+    size_t n = t->count;
+    for (unsigned k = 0; n > 0; k++) {
+        memcpy(nodes + off[k] * NODE_SIZE, node_at(t, k, 0), n * NODE_SIZE);
+        if (n == 1) {
+            break;
+        }
+        n = (n + 1) / 2;
+    }
+
+    free(t->nodes);
+    t->nodes = nodes;
+    t->capacity = cap;
+    memcpy(t->level_off, off, sizeof(off));
+    return 0;
+}
+
+// 从第 index 个叶子向上更新到根
+static void update_path(sm3_merkle *t, size_t index) {
+    size_t n = t->count;
+    for (unsigned k = 0; n > 1; k++) {
+        size_t left = index & ~(size_t)1;
+        unsigned char *parent = node_at(t, k + 1, index / 2);
+        if (left + 1 < n) {
+            hash_pair(node_at(t, k, left), parent);
+        } else {
+            memcpy(parent, node_at(t, k, left), NODE_SIZE);
+        }
+        index /= 2;
+        n = (n + 1) / 2;
+    }
+}
+
+int sm3_merkle_init(sm3_merkle *t, size_t capacity_hint) {
+    memset(t, 0, sizeof(*t));
+    return reserve(t, capacity_hint ? capacity_hint : 1);
+}
+
+void sm3_merkle_free(sm3_merkle *t) {
+    free(t->nodes);
+    memset(t, 0, sizeof(*t));
+}
+
+int sm3_merkle_build(sm3_merkle *t, const unsigned char (*leaves)[32], size_t n) {
+    t->count = 0;
+    if (reserve(t, n) != 0) {
+        return -1;
+    }
+    t->count = n;
+    if (n == 0) {
+        return 0;
+    }
+    memcpy(node_at(t, 0, 0), leaves, n * NODE_SIZE);
+
+    for (unsigned k = 0; n > 1; k++) {
+        hash_level_8x(node_at(t, k, 0), n / 2, node_at(t, k + 1, 0));
+        if (n & 1) {
+            memcpy(node_at(t, k + 1, n / 2), node_at(t, k, n - 1), NODE_SIZE);
+        }
+        n = (n + 1) / 2;
+    }
+    return 0;
+}
+
+int sm3_merkle_append(sm3_merkle *t, const unsigned char leaf[32]) {
+    if (reserve(t, t->count + 1) != 0) {
+        return -1;
+    }
+    memcpy(node_at(t, 0, t->count), leaf, NODE_SIZE);
+    t->count++;
+    update_path(t, t->count - 1);
+    return 0;
+}
+
+int sm3_merkle_update(sm3_merkle *t, size_t index, const unsigned char leaf[32]) {
+    if (index >= t->count) {
+        return -1;
+    }
+    memcpy(node_at(t, 0, index), leaf, NODE_SIZE);
+    update_path(t, index);
+    return 0;
+}
+
+void sm3_merkle_root(const sm3_merkle *t, unsigned char root[32]) {
+    static const unsigned char empty[1];
+    size_t n = t->count;
+    unsigned k = 0;
+
+    if (n == 0) {
+        sm3_single(empty, 0, root);
+        return;
+    }
+    while (n > 1) {
+        n = (n + 1) / 2;
+        k++;
+    }
+    memcpy(root, node_at(t, k, 0), NODE_SIZE);
+}
+
+size_t sm3_merkle_proof(const sm3_merkle *t, size_t index, unsigned char (*path)[32]) {
+    size_t n = t->count;
+    size_t len = 0;
+
+    if (index >= n) {
+        return 0;
+    }
+    for (unsigned k = 0; n > 1; k++) {
+        size_t sibling = index ^ 1;
+        if (sibling < n) {
+            memcpy(path[len++], node_at(t, k, sibling), NODE_SIZE);
+        }
+        index /= 2;
+        n = (n + 1) / 2;
+    }
+    return len;
+}
+
+int sm3_merkle_verify(const unsigned char leaf[32], size_t index, size_t count,
+                      const unsigned char (*path)[32], size_t path_len, const unsigned char root[32]) {
+    unsigned char buf[64];
+    unsigned char h[32];
+    size_t n = count;
+    size_t used = 0;
+
+    if (index >= count) {
+        return 0;
+    }
+    memcpy(h, leaf, NODE_SIZE);
+    while (n > 1) {
+        if ((index ^ 1) < n) {
+            if (used == path_len) {
+                return 0;
+            }
+            if (index & 1) {
+                memcpy(buf, path[used], NODE_SIZE);
+                memcpy(buf + NODE_SIZE, h, NODE_SIZE);
+            } else {
+                memcpy(buf, h, NODE_SIZE);
+                memcpy(buf + NODE_SIZE, path[used], NODE_SIZE);
+            }
+            used++;
+            hash_pair(buf, h);
+        }
+        index /= 2;
+        n = (n + 1) / 2;
+    }
+    return used == path_len && memcmp(h, root, NODE_SIZE) == 0;
+}
@@ -0,0 +1,82 @@
+// author： https://github.com/8891689
+// sm3_merkle.h
+#ifndef SM3_MERKLE_H
+#define SM3_MERKLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * SM3 Merkle 树
+ *
+ *   叶子为调用者给出的 32 字节摘要 (例如日志段的 SM3 或 sm3_batch 的输出)。
+ *   内部节点:  N = SM3(left || right || 0x01)，65 字节 = 一个消息分组 + 一个固定的分组 (标记字节与填充)。
+ *   末尾的 0x01 使内部节点不同于任何 64 字节数据的 SM3，叶子摘要不能冒充内部节点。
+ *   逐层两两配对，若某层节点数为奇数，最后一个节点原样提升到上一层。
+ *   树的形状与 sm3_tree 相同，但节点哈希不同 (sm3_tree 的节点带有各自的标记)，两者的根不能互换。
+ *   空树的根定义为 SM3("")。
+ *
+ * 所有节点存放在一块扁平数组中：第 k 层从 level_off[k] 开始连续存放，
+ * 相邻的两个子节点在内存中正好构成父节点的 64 字节输入，可以直接送入 SM3 压缩。
+ */
+#define SM3_MERKLE_MAX_DEPTH 64
+
+typedef struct {
+    unsigned char *nodes;                     // 扁平节点数组，每个节点 32 字节
+    size_t level_off[SM3_MERKLE_MAX_DEPTH];   // 第 k 层首节点的序号
+    size_t capacity;                          // 叶子容量 (2 的幂)
+    size_t count;                             // 当前叶子数
+} sm3_merkle;
+
+/**
+ * @brief 初始化空树，capacity_hint 为预计叶子数 (可为 0)
+ * @return 成功返回 0，内存分配失败返回 -1
+ */
+int sm3_merkle_init(sm3_merkle *t, size_t capacity_hint);
+
+void sm3_merkle_free(sm3_merkle *t);
+
+/**
+ * @brief 用 n 个叶子重建整棵树 (每层 8 对节点一组在 sm3_8x 通道上计算)
+ * @return 成功返回 0，内存分配失败返回 -1
+ */
+int sm3_merkle_build(sm3_merkle *t, const unsigned char (*leaves)[32], size_t n);
+
+/**
+ * @brief 追加一个叶子，只重新计算从新叶子到根的 O(log n) 条路径
+ * @return 成功返回 0，内存分配失败返回 -1
+ */
+int sm3_merkle_append(sm3_merkle *t, const unsigned char leaf[32]);
+
+/**
+ * @brief 替换第 index 个叶子并更新到根的路径
+ * @return 成功返回 0，index 越界返回 -1
+ */
+int sm3_merkle_update(sm3_merkle *t, size_t index, const unsigned char leaf[32]);
+
+void sm3_merkle_root(const sm3_merkle *t, unsigned char root[32]);
+
+/**
+ * @brief 生成第 index 个叶子的包含证明 (自底向上的兄弟节点，被提升的层没有兄弟节点)
+ * @param path     输出兄弟节点，至少 SM3_MERKLE_MAX_DEPTH 项
+ * @return 兄弟节点个数；index 越界返回 0 并且不写 path
+ */
+size_t sm3_merkle_proof(const sm3_merkle *t, size_t index, unsigned char (*path)[32]);
+
+/**
+ * @brief 校验包含证明：叶子 leaf 位于叶子数为 count 的树的第 index 个位置
+ * 根不包含叶子数，count 必须与根一起从可信来源获得
+ * @return 证明有效返回 1，否则返回 0
+ */
+int sm3_merkle_verify(const unsigned char leaf[32], size_t index, size_t count,
+                      const unsigned char (*path)[32], size_t path_len, const unsigned char root[32]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM3_MERKLE_H
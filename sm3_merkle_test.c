@@ -0,0 +1,169 @@
+//  gcc -O3 -mavx2 -march=native sm3_avx.c sm3_merkle.c sm3_merkle_test.c -o sm3_merkle_test
+//  author： https://github.com/8891689
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include "sm3_avx.h"
+#include "sm3_merkle.h"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// 参考实现：逐层用 sm3_single 计算 SM3(left || right || 0x01)，奇数节点提升
+static void node_ref(const unsigned char left[32], const unsigned char right[32], unsigned char out[32]) {
+    unsigned char buf[65];
+    memcpy(buf, left, 32);
+    memcpy(buf + 32, right, 32);
+    buf[64] = 0x01;
+    sm3_single(buf, sizeof(buf), out);
+}
+
+static void merkle_root_ref(const unsigned char (*leaves)[32], size_t n, unsigned char root[32]) {
+    if (n == 0) {
+        sm3_single((const unsigned char*)"", 0, root);
+        return;
+    }
+    unsigned char (*level)[32] = malloc(n * 32);
+    memcpy(level, leaves, n * 32);
+    while (n > 1) {
+        size_t m = 0;
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            node_ref(level[i], level[i + 1], level[m++]);
+        }
+        if (n & 1) {
+            memcpy(level[m++], level[n - 1], 32);
+        }
+        n = m;
+    }
+    memcpy(root, level[0], 32);
+    free(level);
+}
+
+static void make_leaf(size_t i, unsigned char leaf[32]) {
+    unsigned char seed[8];
+    for (int k = 0; k < 8; k++) seed[k] = (unsigned char)(i >> (k * 8));
+    sm3_single(seed, sizeof(seed), leaf);
+}
+
+int main() {
+    int failures = 0;
+    const size_t MAXN = 300;
+    unsigned char (*leaves)[32] = malloc(MAXN * 32);
+    unsigned char root[32], ref[32];
+    sm3_merkle t;
+
+    for (size_t i = 0; i < MAXN; i++) make_leaf(i, leaves[i]);
+
+    printf("--- SM3 Merkle Correctness Test ---\n");
+
+    // 批量构建 vs 参考实现 (0..300 个叶子)
+    int build_ok = 1;
+    sm3_merkle_init(&t, 0);
+    for (size_t n = 0; n <= MAXN; n++) {
+        sm3_merkle_build(&t, (const unsigned char (*)[32])leaves, n);
+        sm3_merkle_root(&t, root);
+        merkle_root_ref((const unsigned char (*)[32])leaves, n, ref);
+        if (memcmp(root, ref, 32) != 0) build_ok = 0;
+    }
+    printf("Build (8-lane levels) vs reference, 0..%zu leaves: %s\n", MAXN, build_ok ? "PASS" : "FAIL");
+    failures += !build_ok;
+    sm3_merkle_free(&t);
+
+    // 逐个追加 (从容量 1 开始扩容) vs 参考实现
+    int append_ok = 1;
+    sm3_merkle_init(&t, 0);
+    for (size_t n = 1; n <= MAXN; n++) {
+        sm3_merkle_append(&t, leaves[n - 1]);
+        sm3_merkle_root(&t, root);
+        merkle_root_ref((const unsigned char (*)[32])leaves, n, ref);
+        if (memcmp(root, ref, 32) != 0) append_ok = 0;
+    }
+    printf("Incremental append vs reference: %s\n", append_ok ? "PASS" : "FAIL");
+    failures += !append_ok;
+
+    // 更新叶子
+    int update_ok = 1;
+    for (size_t i = 0; i < MAXN; i += 17) {
+        make_leaf(i + 100000, leaves[i]);
+        sm3_merkle_update(&t, i, leaves[i]);
+    }
+    sm3_merkle_root(&t, root);
+    merkle_root_ref((const unsigned char (*)[32])leaves, MAXN, ref);
+    if (memcmp(root, ref, 32) != 0) update_ok = 0;
+    if (sm3_merkle_update(&t, MAXN, leaves[0]) != -1) update_ok = 0;
+    printf("Leaf update vs reference: %s\n", update_ok ? "PASS" : "FAIL");
+    failures += !update_ok;
+
+    // 包含证明：所有树大小、所有位置
+    int proof_ok = 1;
+    unsigned char path[SM3_MERKLE_MAX_DEPTH][32];
+    for (size_t n = 1; n <= 70; n++) {
+        sm3_merkle_build(&t, (const unsigned char (*)[32])leaves, n);
+        sm3_merkle_root(&t, root);
+        for (size_t i = 0; i < n; i++) {
+            size_t len = sm3_merkle_proof(&t, i, path);
+            if (!sm3_merkle_verify(leaves[i], i, n, (const unsigned char (*)[32])path, len, root)) proof_ok = 0;
+            // 错误位置、错误叶子、篡改路径都必须失败
+            if (n > 1 && sm3_merkle_verify(leaves[i], (i + 1) % n, n, (const unsigned char (*)[32])path, len, root)) proof_ok = 0;
+            if (sm3_merkle_verify(leaves[(i + 1) % MAXN], i, n, (const unsigned char (*)[32])path, len, root)) proof_ok = 0;
+            if (len > 0) {
+                path[len - 1][5] ^= 1;
+                if (sm3_merkle_verify(leaves[i], i, n, (const unsigned char (*)[32])path, len, root)) proof_ok = 0;
+            }
+        }
+    }
+    printf("Inclusion proofs (1..70 leaves, all indices, tampering rejected): %s\n", proof_ok ? "PASS" : "FAIL");
+    failures += !proof_ok;
+
+    // 第二原像：4 叶树中 a || b 这 64 字节作为数据段，其 SM3 不能冒充 2 叶树的叶子 0
+    int domain_ok = 1;
+    unsigned char seg_leaf[32], node_cd[32];
+    sm3_merkle_build(&t, (const unsigned char (*)[32])leaves, 4);
+    sm3_merkle_root(&t, root);
+    sm3_single(leaves[0], 64, seg_leaf);
+    node_ref(leaves[2], leaves[3], node_cd);
+    if (sm3_merkle_verify(seg_leaf, 0, 2, (const unsigned char (*)[32])&node_cd, 1, root)) domain_ok = 0;
+    printf("64-byte segment cannot pose as an inner node: %s\n", domain_ok ? "PASS" : "FAIL");
+    failures += !domain_ok;
+    sm3_merkle_free(&t);
+    free(leaves);
+
+    // --- 吞吐量测试部分 ---
+    printf("\n--- Throughput: 1M-leaf tree ---\n");
+    const size_t N = 1 << 20;
+    unsigned char (*big)[32] = malloc(N * 32);
+    for (size_t i = 0; i < N; i++) make_leaf(i, big[i]);
+
+    double t0 = now_sec();
+    merkle_root_ref((const unsigned char (*)[32])big, N, ref);
+    double el_ref = now_sec() - t0;
+
+    sm3_merkle_init(&t, N);
+    t0 = now_sec();
+    sm3_merkle_build(&t, (const unsigned char (*)[32])big, N);
+    double el_build = now_sec() - t0;
+    sm3_merkle_root(&t, root);
+    int big_ok = memcmp(root, ref, 32) == 0;
+
+    const size_t UPD = 100000;
+    t0 = now_sec();
+    for (size_t i = 0; i < UPD; i++) {
+        sm3_merkle_update(&t, (i * 7919) % N, big[i]);
+    }
+    double el_upd = now_sec() - t0;
+
+    printf("Scalar rebuild       : %10.0f nodes/s\n", (N - 1) / el_ref);
+    printf("8-lane build         : %10.0f nodes/s\n", (N - 1) / el_build);
+    printf("Leaf update (path)   : %10.0f updates/s\n", UPD / el_upd);
+    printf("1M-leaf root matches reference: %s\n", big_ok ? "PASS" : "FAIL");
+    failures += !big_ok;
+
+    sm3_merkle_free(&t);
+    free(big);
+    return failures ? 1 : 0;
+}
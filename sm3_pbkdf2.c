@@ -0,0 +1,219 @@
+// author： https://github.com/8891689
+// sm3_pbkdf2.c
+#include "sm3_pbkdf2.h"
+#include "sm3_hmac.h"
+#include "sm3_pbkdf2_internal.h"
+#include "sm3_avx.h"
+#include <string.h>
+#include <immintrin.h>
+
+// 32 字节摘要 + 固定填充，构成迭代中的单个消息分组
+static void init_iter_block(unsigned char block[64]) {
+    memset(block, 0, SM3_BLOCK_SIZE);
+    block[32] = 0x80;
+    block[62] = (unsigned char)(ITER_MSG_BITS >> 8);
+    block[63] = (unsigned char)ITER_MSG_BITS;
+}
+
+// U_1 = HMAC(P, S || INT(idx))，直接从盐压缩完整分组，剩余部分与计数器在栈上拼接
+void sm3_pbkdf2_u1(const sm3_hmac_key *hk, const unsigned char *salt, size_t salt_len,
+                   uint32_t idx, unsigned char u[32]) {
+    uint32_t state[8];
+    unsigned char buf[128];
+    size_t full = salt_len / SM3_BLOCK_SIZE * SM3_BLOCK_SIZE;
+    size_t rem = salt_len - full;
+    size_t tl = rem + 4;
+    size_t padded = (tl + 9 <= SM3_BLOCK_SIZE) ? SM3_BLOCK_SIZE : 2 * SM3_BLOCK_SIZE;
+    uint64_t total_bits = ((uint64_t)SM3_BLOCK_SIZE + salt_len + 4) * 8;
+
+    memcpy(state, hk->ipad_state, sizeof(state));
+    for (size_t off = 0; off < full; off += SM3_BLOCK_SIZE) {
+        sm3_compress(state, salt + off);
+    }
+
+    memset(buf, 0, padded);
+    memcpy(buf, salt + full, rem);
+    buf[rem]     = (unsigned char)(idx >> 24);
+    buf[rem + 1] = (unsigned char)(idx >> 16);
+    buf[rem + 2] = (unsigned char)(idx >> 8);
+    buf[rem + 3] = (unsigned char)idx;
+    buf[tl] = 0x80;
+    for (int k = 0; k < 8; k++) {
+        buf[padded - 1 - k] = (unsigned char)(total_bits >> (k * 8));
+    }
+    sm3_compress(state, buf);
+    if (padded > SM3_BLOCK_SIZE) {
+        sm3_compress(state, buf + SM3_BLOCK_SIZE);
+    }
+
+    init_iter_block(buf);
+    store_state_be(state, buf);
+    memcpy(state, hk->opad_state, sizeof(state));
+    sm3_compress(state, buf);
+    store_state_be(state, u);
+    memset(buf, 0, sizeof(buf));
+}
+
+// 单通道：T = U_1 ^ U_2 ^ ... ^ U_c
+static void pbkdf2_block(const sm3_hmac_key *hk, const unsigned char *salt, size_t salt_len,
+                         uint32_t idx, uint32_t iterations, unsigned char t[32]) {
+    unsigned char block[64];
+    uint32_t state[8];
+
+    init_iter_block(block);
+    sm3_pbkdf2_u1(hk, salt, salt_len, idx, block);
+    memcpy(t, block, 32);
+
+    for (uint32_t j = 1; j < iterations; j++) {
+        memcpy(state, hk->ipad_state, sizeof(state));
+        sm3_compress(state, block);
+        store_state_be(state, block);
+        memcpy(state, hk->opad_state, sizeof(state));
+        sm3_compress(state, block);
+        store_state_be(state, block);
+        for (int k = 0; k < 32; k++) {
+            t[k] ^= block[k];
+        }
+    }
+    memset(block, 0, sizeof(block));
+    memset(state, 0, sizeof(state));
+}
+
+// 8 通道：U 以转置字保存在 w[0..7]，w[8..15] 为固定填充字
+static void pbkdf2_block_8x(const sm3_hmac_key *keys[8], const unsigned char *salts[8], const size_t salt_lens[8],
+                            const uint32_t idx[8], uint32_t iterations, unsigned char t_out[8][32]) {
+    static const sm3_hmac_key unused_key;
+    unsigned char u1[8][32];
+    uint32_t lane_words[8][8];
+    __m256i ipad[8], opad[8], w[16], t[8];
+    sm3_8x_context ctx;
+
+    for (int ch = 0; ch < 8; ch++) {
+        if (keys[ch]) {
+            sm3_pbkdf2_u1(keys[ch], salts[ch], salt_lens[ch], idx[ch], u1[ch]);
+        } else {
+            memset(u1[ch], 0, 32);
+        }
+    }
+    for (int i = 0; i < 8; i++) {
+        for (int ch = 0; ch < 8; ch++) {
+            const sm3_hmac_key *k = keys[ch] ? keys[ch] : &unused_key;
+            lane_words[0][ch] = k->ipad_state[i];
+            lane_words[1][ch] = k->opad_state[i];
+            lane_words[2][ch] = load_be32(u1[ch] + i * 4);
+        }
+        ipad[i] = _mm256_loadu_si256((const __m256i*)lane_words[0]);
+        opad[i] = _mm256_loadu_si256((const __m256i*)lane_words[1]);
+        w[i] = _mm256_loadu_si256((const __m256i*)lane_words[2]);
+        t[i] = w[i];
+    }
+    w[8] = _mm256_set1_epi32((int)0x80000000U);
+    for (int i = 9; i < 15; i++) {
+        w[i] = _mm256_setzero_si256();
+    }
+    w[15] = _mm256_set1_epi32(ITER_MSG_BITS);
+
+    sm3_8x_starts(&ctx);
+    for (uint32_t j = 1; j < iterations; j++) {
+        for (int i = 0; i < 8; i++) ctx.state[i] = ipad[i];
+        sm3_8x_compress_words(&ctx, w);
+        for (int i = 0; i < 8; i++) {
+            w[i] = ctx.state[i];
+            ctx.state[i] = opad[i];
+        }
+        sm3_8x_compress_words(&ctx, w);
+        for (int i = 0; i < 8; i++) {
+            w[i] = ctx.state[i];
+            t[i] = _mm256_xor_si256(t[i], w[i]);
+        }
+    }
+
+    for (int i = 0; i < 8; i++) {
+        _mm256_storeu_si256((__m256i*)lane_words[i], t[i]);
+    }
+    for (int ch = 0; ch < 8; ch++) {
+        uint32_t st[8];
+        for (int i = 0; i < 8; i++) st[i] = lane_words[i][ch];
+        store_state_be(st, t_out[ch]);
+    }
+    memset(u1, 0, sizeof(u1));
+    memset(lane_words, 0, sizeof(lane_words));
+}
+
+int sm3_pbkdf2(const unsigned char *pass, size_t pass_len, const unsigned char *salt, size_t salt_len,
+               uint32_t iterations, unsigned char *out, size_t out_len) {
+    sm3_hmac_key hk;
+    unsigned char t[8][32];
+    size_t nblocks = (out_len + 31) / 32;
+
+    if (iterations == 0) {
+        return -1;
+    }
+    sm3_hmac_key_init(&hk, pass, pass_len);
+
+    if (nblocks == 1) {
+        pbkdf2_block(&hk, salt, salt_len, 1, iterations, t[0]);
+        memcpy(out, t[0], out_len);
+    } else {
+        // 不同输出分组互不依赖，8 个一组在通道上并行
+        for (size_t b = 0; b < nblocks; b += 8) {
+            const sm3_hmac_key *keys[8];
+            const unsigned char *salts[8];
+            size_t salt_lens[8];
+            uint32_t idx[8];
+            for (int ch = 0; ch < 8; ch++) {
+                keys[ch] = (b + ch < nblocks) ? &hk : NULL;
+                salts[ch] = salt;
+                salt_lens[ch] = salt_len;
+                idx[ch] = (uint32_t)(b + ch + 1);
+            }
+            pbkdf2_block_8x(keys, salts, salt_lens, idx, iterations, t);
+            for (int ch = 0; ch < 8 && b + ch < nblocks; ch++) {
+                size_t off = (b + ch) * 32;
+                size_t n = out_len - off < 32 ? out_len - off : 32;
+                memcpy(out + off, t[ch], n);
+            }
+        }
+    }
+    sm3_hmac_key_clear(&hk);
+    memset(t, 0, sizeof(t));
+    return 0;
+}
+
+int sm3_pbkdf2_8x(const unsigned char *passes[8], const size_t pass_lens[8],
+                  const unsigned char *salts[8], const size_t salt_lens[8],
+                  uint32_t iterations, unsigned char *outs[8], size_t out_len) {
+    sm3_hmac_key hks[8];
+    const sm3_hmac_key *keys[8];
+    unsigned char t[8][32];
+    size_t nblocks = (out_len + 31) / 32;
+
+    if (iterations == 0) {
+        return -1;
+    }
+    for (int ch = 0; ch < 8; ch++) {
+        keys[ch] = NULL;
+        if (passes[ch]) {
+            sm3_hmac_key_init(&hks[ch], passes[ch], pass_lens[ch]);
+            keys[ch] = &hks[ch];
+        }
+    }
+
+    for (size_t b = 0; b < nblocks; b++) {
+        uint32_t idx[8];
+        for (int ch = 0; ch < 8; ch++) idx[ch] = (uint32_t)(b + 1);
+        pbkdf2_block_8x(keys, salts, salt_lens, idx, iterations, t);
+        size_t n = out_len - b * 32 < 32 ? out_len - b * 32 : 32;
+        for (int ch = 0; ch < 8; ch++) {
+            if (keys[ch]) {
+                memcpy(outs[ch] + b * 32, t[ch], n);
+            }
+        }
+    }
+
+    for (int ch = 0; ch < 8; ch++) {
+        if (keys[ch]) sm3_hmac_key_clear(&hks[ch]);
+    }
+    memset(t, 0, sizeof(t));
+    return 0;
+}
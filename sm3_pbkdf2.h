@@ -0,0 +1,51 @@
+// author： https://github.com/8891689
+// sm3_pbkdf2.h
+#ifndef SM3_PBKDF2_H
+#define SM3_PBKDF2_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * PBKDF2-HMAC-SM3 (RFC 8018)，与 OpenSSL PKCS5_PBKDF2_HMAC(EVP_sm3()) 结果一致。
+ *
+ * 每次迭代 U_j = HMAC(P, U_{j-1}) 只需两次压缩：从缓存的 ipad/opad 链接状态出发，
+ * 各压缩一个 "32 字节摘要 + 固定填充" 的分组。同一次推导内的迭代前后依赖，
+ * 因此并行只发生在独立的口令 (批量接口) 或独立的输出分组 (单口令、out_len > 32) 之间。
+ * 迭代过程中摘要始终以转置后的字保存在寄存器中，不做字节序转换。
+ *
+ * RFC 8018 要求迭代次数 c >= 1：iterations 为 0 时各函数返回 -1 且不写输出，成功返回 0。
+ */
+
+/**
+ * @brief 单个口令的 PBKDF2-HMAC-SM3；out_len 超过 32 字节时各输出分组在 8 个通道上并行
+ */
+int sm3_pbkdf2(const unsigned char *pass, size_t pass_len, const unsigned char *salt, size_t salt_len,
+               uint32_t iterations, unsigned char *out, size_t out_len);
+
+/**
+ * @brief 8 个独立口令 (各自的盐) 并行推导，每个通道输出 out_len 字节到 outs[ch]
+ * passes[ch] 为 NULL 的通道不计算，outs[ch] 不被写入。
+ */
+int sm3_pbkdf2_8x(const unsigned char *passes[8], const size_t pass_lens[8],
+                  const unsigned char *salts[8], const size_t salt_lens[8],
+                  uint32_t iterations, unsigned char *outs[8], size_t out_len);
+
+/**
+ * @brief 16 通道版本 (AVX-512)，实现在 sm3_pbkdf2_avx512.c，与 sm3_avx512.c 一起以 -mavx512f -mavx512bw 编译
+ * 调用方自身不需要 AVX-512 编译选项，但须先确认 CPU 支持 avx512f/avx512bw；
+ * libsmcrypto 以 -DSMCRYPTO_AVX512=OFF 构建时不提供此函数。
+ */
+int sm3_pbkdf2_16x(const unsigned char *passes[16], const size_t pass_lens[16],
+                   const unsigned char *salts[16], const size_t salt_lens[16],
+                   uint32_t iterations, unsigned char *outs[16], size_t out_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM3_PBKDF2_H
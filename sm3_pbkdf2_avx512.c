@@ -0,0 +1,104 @@
+// author： https://github.com/8891689
+// sm3_pbkdf2_avx512.c：sm3_pbkdf2_16x，单独成文件以便只有它使用 -mavx512f -mavx512bw 编译
+#include "sm3_pbkdf2.h"
+#include "sm3_hmac.h"
+#include "sm3_pbkdf2_internal.h"
+#include "sm3_avx512.h"
+#include <string.h>
+#include <immintrin.h>
+
+static void pbkdf2_block_16x(const sm3_hmac_key *keys[16], const unsigned char *salts[16], const size_t salt_lens[16],
+                             uint32_t idx, uint32_t iterations, unsigned char t_out[16][32]) {
+    static const sm3_hmac_key unused_key;
+    unsigned char u1[16][32];
+    uint32_t lane_words[8][16];
+    __m512i ipad[8], opad[8], w[16], t[8];
+    sm3_16x_context ctx;
+
+    for (int ch = 0; ch < 16; ch++) {
+        if (keys[ch]) {
+            sm3_pbkdf2_u1(keys[ch], salts[ch], salt_lens[ch], idx, u1[ch]);
+        } else {
+            memset(u1[ch], 0, 32);
+        }
+    }
+    for (int i = 0; i < 8; i++) {
+        for (int ch = 0; ch < 16; ch++) {
+            const sm3_hmac_key *k = keys[ch] ? keys[ch] : &unused_key;
+            lane_words[0][ch] = k->ipad_state[i];
+            lane_words[1][ch] = k->opad_state[i];
+            lane_words[2][ch] = load_be32(u1[ch] + i * 4);
+        }
+        ipad[i] = _mm512_loadu_si512((const void*)lane_words[0]);
+        opad[i] = _mm512_loadu_si512((const void*)lane_words[1]);
+        w[i] = _mm512_loadu_si512((const void*)lane_words[2]);
+        t[i] = w[i];
+    }
+    w[8] = _mm512_set1_epi32((int)0x80000000U);
+    for (int i = 9; i < 15; i++) {
+        w[i] = _mm512_setzero_si512();
+    }
+    w[15] = _mm512_set1_epi32(ITER_MSG_BITS);
+
+    sm3_16x_starts(&ctx);
+    for (uint32_t j = 1; j < iterations; j++) {
+        for (int i = 0; i < 8; i++) ctx.state[i] = ipad[i];
+        sm3_16x_compress_words(&ctx, w);
+        for (int i = 0; i < 8; i++) {
+            w[i] = ctx.state[i];
+            ctx.state[i] = opad[i];
+        }
+        sm3_16x_compress_words(&ctx, w);
+        for (int i = 0; i < 8; i++) {
+            w[i] = ctx.state[i];
+            t[i] = _mm512_xor_si512(t[i], w[i]);
+        }
+    }
+
+    for (int i = 0; i < 8; i++) {
+        _mm512_storeu_si512((void*)lane_words[i], t[i]);
+    }
+    for (int ch = 0; ch < 16; ch++) {
+        uint32_t st[8];
+        for (int i = 0; i < 8; i++) st[i] = lane_words[i][ch];
+        store_state_be(st, t_out[ch]);
+    }
+    memset(u1, 0, sizeof(u1));
+    memset(lane_words, 0, sizeof(lane_words));
+}
+
+int sm3_pbkdf2_16x(const unsigned char *passes[16], const size_t pass_lens[16],
+                   const unsigned char *salts[16], const size_t salt_lens[16],
+                   uint32_t iterations, unsigned char *outs[16], size_t out_len) {
+    sm3_hmac_key hks[16];
+    const sm3_hmac_key *keys[16];
+    unsigned char t[16][32];
+    size_t nblocks = (out_len + 31) / 32;
+
+    if (iterations == 0) {
+        return -1;
+    }
+    for (int ch = 0; ch < 16; ch++) {
+        keys[ch] = NULL;
+        if (passes[ch]) {
+            sm3_hmac_key_init(&hks[ch], passes[ch], pass_lens[ch]);
+            keys[ch] = &hks[ch];
+        }
+    }
+
+    for (size_t b = 0; b < nblocks; b++) {
+        pbkdf2_block_16x(keys, salts, salt_lens, (uint32_t)(b + 1), iterations, t);
+        size_t n = out_len - b * 32 < 32 ? out_len - b * 32 : 32;
+        for (int ch = 0; ch < 16; ch++) {
+            if (keys[ch]) {
+                memcpy(outs[ch] + b * 32, t[ch], n);
+            }
+        }
+    }
+
+    for (int ch = 0; ch < 16; ch++) {
+        if (keys[ch]) sm3_hmac_key_clear(&hks[ch]);
+    }
+    memset(t, 0, sizeof(t));
+    return 0;
+}
@@ -0,0 +1,32 @@
+// author： https://github.com/8891689
+// sm3_pbkdf2_internal.h：sm3_pbkdf2.c 与 sm3_pbkdf2_avx512.c 共用的内部定义 (不安装)
+#ifndef SM3_PBKDF2_INTERNAL_H
+#define SM3_PBKDF2_INTERNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sm3_hmac.h"
+
+#define SM3_BLOCK_SIZE 64
+// 内层、外层消息长度都是 64 (pad) + 32 (摘要) 字节
+#define ITER_MSG_BITS ((SM3_BLOCK_SIZE + 32) * 8)
+
+static inline void store_state_be(const uint32_t state[8], unsigned char out[32]) {
+    for (int k = 0; k < 8; k++) {
+        out[k*4]   = (unsigned char)(state[k] >> 24);
+        out[k*4+1] = (unsigned char)(state[k] >> 16);
+        out[k*4+2] = (unsigned char)(state[k] >> 8);
+        out[k*4+3] = (unsigned char)(state[k]);
+    }
+}
+
+static inline uint32_t load_be32(const unsigned char *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+// U_1 = HMAC(P, S || INT(idx))，定义在 sm3_pbkdf2.c；不从共享库导出
+__attribute__((visibility("hidden")))
+void sm3_pbkdf2_u1(const sm3_hmac_key *hk, const unsigned char *salt, size_t salt_len,
+                   uint32_t idx, unsigned char u[32]);
+
+#endif // SM3_PBKDF2_INTERNAL_H
@@ -0,0 +1,140 @@
+//  gcc -O3 -mavx2 -mavx512f -mavx512bw -march=native sm3_avx.c sm3_avx512.c sm3_hmac.c sm3_pbkdf2.c sm3_pbkdf2_avx512.c sm3_pbkdf2_test.c -o sm3_pbkdf2_test
+//  (没有 AVX-512 时去掉 -mavx512f -mavx512bw、sm3_avx512.c 和 sm3_pbkdf2_avx512.c，16 通道部分自动跳过；
+//   CMake 构建定义 SMCRYPTO_HAVE_AVX512，16 通道部分在运行时按 CPU 决定是否执行)
+//  author： https://github.com/8891689
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include "sm3_pbkdf2.h"
+
+static int hex_equal(const unsigned char *buf, const char *hex, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unsigned int b;
+        sscanf(hex + 2 * i, "%2x", &b);
+        if (buf[i] != (unsigned char)b) return 0;
+    }
+    return 1;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+int main() {
+    int failures = 0;
+    unsigned char dk[80];
+
+    printf("--- PBKDF2-HMAC-SM3 Correctness Test ---\n");
+
+    // 测试向量 (与 OpenSSL PKCS5_PBKDF2_HMAC(EVP_sm3()) 结果一致)
+    struct {
+        const char *pass, *salt;
+        uint32_t iter;
+        size_t dklen;
+        const char *expected;
+    } vectors[] = {
+        {"password", "salt", 1, 32, "4612f922a1fdcefaf4312fc6f8f3322b489cbf24f2ea361b44c2bd8fa2c6dcb0"},
+        {"password", "salt", 4096, 32, "b6e8f2074c87432b78f62e5ced980fdff89e86af2f693dab1638e2b3683045dd"},
+        {"passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096, 80,
+         "3b6282ac8519f059e465abff0ea37b0dbfe6c672a76e6b805312d53900db630732ccc1a88fa5512a6e8bbd7e48d336632a"
+         "254dd72a4ced777cd6fa094665db77f64dcc35208fc0950b9745e424a665f6"},
+    };
+    for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v++) {
+        sm3_pbkdf2((const unsigned char*)vectors[v].pass, strlen(vectors[v].pass),
+                   (const unsigned char*)vectors[v].salt, strlen(vectors[v].salt),
+                   vectors[v].iter, dk, vectors[v].dklen);
+        int ok = hex_equal(dk, vectors[v].expected, vectors[v].dklen);
+        printf("Vector %zu (c=%u, dkLen=%zu): %s\n", v + 1, vectors[v].iter, vectors[v].dklen, ok ? "PASS" : "FAIL");
+        failures += !ok;
+    }
+
+    // 8 通道：不同口令、不同盐长度 (跨越分组边界)，通道 5 不使用
+    unsigned char pw[16][40], salt[16][140];
+    const unsigned char *passes[16], *salts[16];
+    size_t pass_lens[16], salt_lens[16];
+    unsigned char out[16][72];
+    unsigned char *outs[16];
+    for (int ch = 0; ch < 16; ch++) {
+        for (int i = 0; i < 40; i++) pw[ch][i] = (unsigned char)('a' + (ch * 3 + i) % 26);
+        for (int i = 0; i < 140; i++) salt[ch][i] = (unsigned char)(ch * 11 + i);
+        passes[ch] = pw[ch];
+        pass_lens[ch] = 4 + ch * 2;
+        salts[ch] = salt[ch];
+        salt_lens[ch] = (size_t)ch * 9;
+        outs[ch] = out[ch];
+    }
+    passes[5] = NULL;
+    memset(out[5], 0xEE, sizeof(out[5]));
+    sm3_pbkdf2_8x(passes, pass_lens, salts, salt_lens, 100, outs, 72);
+    int lanes_ok = 1;
+    for (int ch = 0; ch < 8; ch++) {
+        if (!passes[ch]) {
+            if (out[ch][0] != 0xEE) lanes_ok = 0;
+            continue;
+        }
+        sm3_pbkdf2(passes[ch], pass_lens[ch], salts[ch], salt_lens[ch], 100, dk, 72);
+        if (memcmp(dk, out[ch], 72) != 0) lanes_ok = 0;
+    }
+    printf("8-lane vs single (mixed passwords/salts, skipped lane): %s\n", lanes_ok ? "PASS" : "FAIL");
+    failures += !lanes_ok;
+    passes[5] = pw[5];
+
+#if defined(__AVX512F__) || defined(SMCRYPTO_HAVE_AVX512)
+    __builtin_cpu_init();
+    int have_avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    if (have_avx512) {
+        sm3_pbkdf2_16x(passes, pass_lens, salts, salt_lens, 100, outs, 72);
+        int lanes16_ok = 1;
+        for (int ch = 0; ch < 16; ch++) {
+            sm3_pbkdf2(passes[ch], pass_lens[ch], salts[ch], salt_lens[ch], 100, dk, 72);
+            if (memcmp(dk, out[ch], 72) != 0) lanes16_ok = 0;
+        }
+        printf("16-lane vs single: %s\n", lanes16_ok ? "PASS" : "FAIL");
+        failures += !lanes16_ok;
+    } else {
+        printf("16-lane vs single: skipped (CPU has no AVX-512)\n");
+    }
+#endif
+
+    // RFC 8018 要求 c >= 1：iterations 为 0 必须被拒绝，且不写输出
+    int zero_ok = 1;
+    memset(dk, 0xEE, 72);
+    for (int ch = 0; ch < 8; ch++) memset(out[ch], 0xEE, 72);
+    if (sm3_pbkdf2(pw[0], 8, salt[0], 16, 0, dk, 72) != -1 || dk[0] != 0xEE) zero_ok = 0;
+    if (sm3_pbkdf2_8x(passes, pass_lens, salts, salt_lens, 0, outs, 72) != -1) zero_ok = 0;
+    for (int ch = 0; ch < 8; ch++) {
+        if (out[ch][0] != 0xEE) zero_ok = 0;
+    }
+    printf("iterations = 0 rejected: %s\n", zero_ok ? "PASS" : "FAIL");
+    failures += !zero_ok;
+
+    // --- 吞吐量测试部分 (单核，每次迭代 = 2 次压缩) ---
+    printf("\n--- Throughput: PBKDF2 iterations/s per core (dkLen 32) ---\n");
+    const uint32_t ITER = 200000;
+    double t0, el;
+
+    t0 = now_sec();
+    sm3_pbkdf2(pw[0], 8, salt[0], 16, ITER, dk, 32);
+    el = now_sec() - t0;
+    printf("single            : %12.0f iter/s\n", ITER / el);
+
+    t0 = now_sec();
+    sm3_pbkdf2_8x(passes, pass_lens, salts, salt_lens, ITER, outs, 32);
+    el = now_sec() - t0;
+    printf("8-lane  (AVX2)    : %12.0f iter/s\n", 8.0 * ITER / el);
+
+#if defined(__AVX512F__) || defined(SMCRYPTO_HAVE_AVX512)
+    if (have_avx512) {
+        t0 = now_sec();
+        sm3_pbkdf2_16x(passes, pass_lens, salts, salt_lens, ITER, outs, 32);
+        el = now_sec() - t0;
+        printf("16-lane (AVX-512) : %12.0f iter/s\n", 16.0 * ITER / el);
+    }
+#endif
+
+    return failures ? 1 : 0;
+}
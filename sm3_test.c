@@ -1,4 +1,5 @@
 /* sm3_test.c   gcc -O3 -march=native sm3.c sm3_test.c -o sm3_test 
+ *              ./sm3_test [流式测试 GiB 数, 默认 0 表示跳过; 16 时与参考摘要比对]
  */
 #include <stdio.h>
 #include <string.h>
@@ -6,6 +7,12 @@
 #include <stdlib.h>
 #include "sm3.h"
 
+#define STREAM_16GIB_EXPECTED "57111395 fa42c19c d9b4abd3 0658f638 e93e07ce ef31f9e8 7d03308c ac46a86c"
+static const uint8_t stream_16gib_expected[32] = {
+    0x57, 0x11, 0x13, 0x95, 0xfa, 0x42, 0xc1, 0x9c, 0xd9, 0xb4, 0xab, 0xd3, 0x06, 0x58, 0xf6, 0x38,
+    0xe9, 0x3e, 0x07, 0xce, 0xef, 0x31, 0xf9, 0xe8, 0x7d, 0x03, 0x30, 0x8c, 0xac, 0x46, 0xa8, 0x6c
+};
+
 void print_digest(const char* label, const uint8_t digest[32]) {
     printf("%s:\n   ", label);
     for (int i = 0; i < 32; i++) {
@@ -41,6 +48,50 @@ void test_vectors() {
     printf("Expected: debe9ff9 2275b8a1 38604889 c18e5a4d 6fdb70e5 387e5765 293dcba3 9c0c5732\n\n");
 }
 
+int test_midstate() {
+    uint8_t msg[300];
+    uint8_t expected[32], digest[32];
+    uint8_t blob[SM3_EXPORT_MAX_SIZE];
+    int ok = 1;
+    
+    for (int i = 0; i < 300; i++) msg[i] = (uint8_t)(i * 7 + 1);
+    
+    printf("Test 4: Midstate export/import and clone\n");
+    for (size_t split = 0; split <= 300; split += 13) {
+        sm3_ctx_t ctx, restored, forked;
+        sm3(msg, 300, expected);
+        
+        sm3_init(&ctx);
+        sm3_update(&ctx, msg, split);
+        size_t blob_len = sm3_export(&ctx, blob);
+        
+        // 恢复后继续处理剩余数据
+        if (blob_len != SM3_MIDSTATE_SIZE + split % 64 ||
+            sm3_import(&restored, blob, blob_len) != 0) {
+            ok = 0;
+            continue;
+        }
+        sm3_update(&restored, msg + split, 300 - split);
+        sm3_final(&restored, digest);
+        if (memcmp(digest, expected, 32) != 0) ok = 0;
+        
+        // 克隆后两个分支分别完成
+        sm3_clone(&forked, &ctx);
+        sm3_update(&forked, msg + split, 300 - split);
+        sm3_final(&forked, digest);
+        if (memcmp(digest, expected, 32) != 0) ok = 0;
+        
+        sm3_update(&ctx, msg + split, 300 - split);
+        sm3_final(&ctx, digest);
+        if (memcmp(digest, expected, 32) != 0) ok = 0;
+        
+        // 长度字段与缓冲长度不一致的数据必须被拒绝
+        if (sm3_import(&restored, blob, blob_len + 1) == 0) ok = 0;
+    }
+    printf("Result: %s\n\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
+
 static double get_elapsed_time_sec(struct timespec *start, struct timespec *end) {
     return (double)(end->tv_sec - start->tv_sec) + 
            (double)(end->tv_nsec - start->tv_nsec) / 1000000000.0;
@@ -90,12 +141,59 @@ void performance_test() {
     free(buffer);
 }
 
-int main() {
+/* 大数据流式测试：以 1 MiB 分块向同一上下文输入 total_gib GiB 数据 (长度超过 32 位) */
+int streaming_benchmark(unsigned int total_gib) {
+    printf("Streaming Test: %u GiB through 1 MiB sm3_update calls\n", total_gib);
+    
+    const size_t chunk_size = 1024 * 1024;
+    const size_t num_chunks = (size_t)total_gib * 1024;
+    uint8_t *chunk = (uint8_t*)malloc(chunk_size);
+    if (!chunk) {
+        perror("Memory allocation failed");
+        return 0;
+    }
+    memset(chunk, 'a', chunk_size);
+    
+    sm3_ctx_t ctx;
+    uint8_t digest[32];
+    struct timespec start_time, end_time;
+    
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    sm3_init(&ctx);
+    for (size_t i = 0; i < num_chunks; i++) {
+        sm3_update(&ctx, chunk, chunk_size);
+    }
+    sm3_final(&ctx, digest);
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    
+    double elapsed = get_elapsed_time_sec(&start_time, &end_time);
+    double total_mb = (double)num_chunks * chunk_size / (1024.0 * 1024.0);
+    
+    print_digest("Hash", digest);
+    int ok = 1;
+    if (total_gib == 16) {
+        // 16 GiB 个 'a' 的参考摘要 (由独立的 SM3 实现计算)
+        printf("Expected: %s\n", STREAM_16GIB_EXPECTED);
+        ok = memcmp(digest, stream_16gib_expected, 32) == 0;
+        printf("Result: %s\n", ok ? "PASS" : "FAIL");
+    }
+    printf("Total time elapsed: %.4f seconds\n", elapsed);
+    printf("Total data processed: %.2f MB\n", total_mb);
+    printf("Throughput: %.2f MB/s\n", total_mb / elapsed);
+    printf("----------------------------------------\n");
+    
+    free(chunk);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
     printf("----------------------------------------\n");
     printf("SM3 Functionality Verification\n");
     printf("----------------------------------------\n");
     
+    int failures = 0;
     test_vectors();
+    if (!test_midstate()) failures++;
     
     printf("\n----------------------------------------\n");
     printf("SM3 Performance Test\n");
@@ -103,5 +201,12 @@ int main() {
     
     performance_test();
     
-    return 0;
+    // 可通过命令行参数指定流式测试的数据量 (GiB)，默认跳过；ctest 另以参数 16 单独登记
+    unsigned int stream_gib = (argc > 1) ? (unsigned int)strtoul(argv[1], NULL, 10) : 0;
+    if (stream_gib > 0) {
+        printf("\n");
+        if (!streaming_benchmark(stream_gib)) failures++;
+    }
+    
+    return failures ? 1 : 0;
 }
@@ -0,0 +1,309 @@
+// author： https://github.com/8891689
+// sm3_tree.c
+#include "sm3_tree.h"
+#include "sm3_avx.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <threads.h>
+#include <stdatomic.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define LEAF_SUFFIX 0x00
+#define NODE_SUFFIX 0x01
+#define ROOT_SUFFIX 0x02
+
+// 每个任务处理的子树叶子数 (2 的幂，2 MiB 数据)。
+// 按层配对的树在 2 的幂边界上可分解，所以该值不影响摘要。
+#define SUBTREE_LEAVES 256
+
+static const unsigned char zero_block[64] = {0};
+
+// 8 通道计算 SM3(msg || suffix)，各通道长度可不同。
+// n 为有效通道数，其余通道不参与压缩。
+static void sm3_8x_with_suffix(const unsigned char *msgs[8], const size_t lens[8], int n,
+                               unsigned char suffix, unsigned char outputs[8][32]) {
+    sm3_8x_context ctx;
+    unsigned char tail[8][128];
+    size_t direct_blocks[8];
+    size_t total_blocks[8];
+    size_t max_blocks = 0;
+
+    sm3_8x_starts(&ctx);
+
+    for (int ch = 0; ch < 8; ch++) {
+        if (ch >= n) {
+            direct_blocks[ch] = 0;
+            total_blocks[ch] = 0;
+            continue;
+        }
+        size_t rem = lens[ch] % 64;
+        uint64_t total_bits = ((uint64_t)lens[ch] + 1) * 8;
+        size_t tail_len = (rem + 1 + 1 + 8 <= 64) ? 64 : 128;
+
+        direct_blocks[ch] = lens[ch] / 64;
+        total_blocks[ch] = direct_blocks[ch] + tail_len / 64;
+
+        memset(tail[ch], 0, tail_len);
+        memcpy(tail[ch], msgs[ch] + direct_blocks[ch] * 64, rem);
+        tail[ch][rem] = suffix;
+        tail[ch][rem + 1] = 0x80;
+        for (int k = 0; k < 8; k++) {
+            tail[ch][tail_len - 1 - k] = (unsigned char)(total_bits >> (k * 8));
+        }
+        if (total_blocks[ch] > max_blocks) {
+            max_blocks = total_blocks[ch];
+        }
+    }
+
+    const unsigned char *lanes[8];
+    uint32_t mask[8] = {0};
+    int mask_dirty = 1;
+
+    for (size_t b = 0; b < max_blocks; b++) {
+        for (int ch = 0; ch < 8; ch++) {
+            uint32_t m;
+            if (b < direct_blocks[ch]) {
+                lanes[ch] = msgs[ch] + b * 64;
+                m = 0xFFFFFFFF;
+            } else if (b < total_blocks[ch]) {
+                lanes[ch] = tail[ch] + (b - direct_blocks[ch]) * 64;
+                m = 0xFFFFFFFF;
+            } else {
+                lanes[ch] = zero_block;
+                m = 0;
+            }
+            if (mask[ch] != m) {
+                mask[ch] = m;
+                mask_dirty = 1;
+            }
+        }
+        if (mask_dirty) {
+            ctx.active_mask = _mm256_loadu_si256((const __m256i*)mask);
+            mask_dirty = 0;
+        }
+        sm3_8x_compress_lanes(&ctx, lanes);
+    }
+
+    unsigned char all_outputs[8][32];
+    sm3_8x_final(&ctx, all_outputs);
+    memcpy(outputs, all_outputs, (size_t)n * 32);
+}
+
+// 计算 count 个叶子的摘要，first 为第一个叶子的起始地址
+static void hash_leaves(const unsigned char *first, size_t count, size_t last_len,
+                        unsigned char (*digests)[32]) {
+    const unsigned char *msgs[8];
+    size_t lens[8];
+
+    for (size_t i = 0; i < count; i += 8) {
+        int n = (count - i < 8) ? (int)(count - i) : 8;
+        for (int ch = 0; ch < n; ch++) {
+            msgs[ch] = first + (i + ch) * SM3_TREE_LEAF_SIZE;
+            lens[ch] = (i + ch == count - 1) ? last_len : SM3_TREE_LEAF_SIZE;
+        }
+        sm3_8x_with_suffix(msgs, lens, n, LEAF_SUFFIX, digests + i);
+    }
+}
+
+// 将一层 n 个节点原地合并为上一层，返回新节点数
+static size_t reduce_level(unsigned char (*nodes)[32], size_t n) {
+    size_t pairs = n / 2;
+    const unsigned char *msgs[8];
+    size_t lens[8];
+    unsigned char out[8][32];
+
+    for (size_t i = 0; i < pairs; i += 8) {
+        int cnt = (pairs - i < 8) ? (int)(pairs - i) : 8;
+        for (int ch = 0; ch < cnt; ch++) {
+            msgs[ch] = nodes[2 * (i + ch)];
+            lens[ch] = 64;
+        }
+        // 先完成本批全部读取再写回，保证原地合并安全
+        sm3_8x_with_suffix(msgs, lens, cnt, NODE_SUFFIX, out);
+        memcpy(nodes[i], out, (size_t)cnt * 32);
+    }
+    if (n & 1) {
+        memcpy(nodes[pairs], nodes[n - 1], 32);
+        pairs++;
+    }
+    return pairs;
+}
+
+static void reduce_to_root(unsigned char (*nodes)[32], size_t n) {
+    while (n > 1) {
+        n = reduce_level(nodes, n);
+    }
+}
+
+typedef struct {
+    const unsigned char *data;
+    size_t len;
+    size_t num_leaves;
+    size_t num_subtrees;
+    unsigned char (*roots)[32];
+    atomic_size_t next;
+} tree_job;
+
+static int tree_worker(void *arg) {
+    tree_job *job = (tree_job*)arg;
+    unsigned char digests[SUBTREE_LEAVES][32];
+
+    for (;;) {
+        size_t s = atomic_fetch_add(&job->next, 1);
+        if (s >= job->num_subtrees) {
+            break;
+        }
+        size_t first_leaf = s * SUBTREE_LEAVES;
+        size_t count = job->num_leaves - first_leaf;
+        if (count > SUBTREE_LEAVES) {
+            count = SUBTREE_LEAVES;
+        }
+        size_t last_len = SM3_TREE_LEAF_SIZE;
+        if (first_leaf + count == job->num_leaves) {
+            last_len = job->len - (job->num_leaves - 1) * SM3_TREE_LEAF_SIZE;
+        }
+        hash_leaves(job->data + first_leaf * SM3_TREE_LEAF_SIZE, count, last_len, digests);
+        reduce_to_root(digests, count);
+        memcpy(job->roots[s], digests[0], 32);
+    }
+    return 0;
+}
+
+static unsigned int online_cpus(void) {
+#if defined(_WIN32) || defined(_WIN64)
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return si.dwNumberOfProcessors > 0 ? (unsigned int)si.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (unsigned int)n : 1;
+#endif
+}
+
+int sm3_tree(const unsigned char *data, size_t len, unsigned int nthreads, unsigned char digest[32]) {
+    static const unsigned char empty[1] = {0};
+    tree_job job;
+
+    if (len == 0) {
+        data = empty;
+    }
+
+    job.data = data;
+    job.len = len;
+    job.num_leaves = (len == 0) ? 1 : (len + SM3_TREE_LEAF_SIZE - 1) / SM3_TREE_LEAF_SIZE;
+    job.num_subtrees = (job.num_leaves + SUBTREE_LEAVES - 1) / SUBTREE_LEAVES;
+    job.roots = (unsigned char (*)[32])malloc(job.num_subtrees * 32);
+    if (!job.roots) {
+        return -1;
+    }
+    atomic_init(&job.next, 0);
+
+    // 常量表需在启动线程前初始化
+    sm3_8x_context warmup;
+    sm3_8x_starts(&warmup);
+
+    if (nthreads == 0) {
+        nthreads = online_cpus();
+    }
+    if (nthreads > job.num_subtrees) {
+        nthreads = (unsigned int)job.num_subtrees;
+    }
+
+    if (nthreads <= 1) {
+        tree_worker(&job);
+    } else {
+        thrd_t *threads = (thrd_t*)malloc((nthreads - 1) * sizeof(thrd_t));
+        unsigned int started = 0;
+        if (threads) {
+            for (; started < nthreads - 1; started++) {
+                if (thrd_create(&threads[started], tree_worker, &job) != thrd_success) {
+                    break;
+                }
+            }
+        }
+        // 调用线程同样参与计算，线程创建失败时由它完成剩余子树
+        tree_worker(&job);
+        for (unsigned int i = 0; i < started; i++) {
+            thrd_join(threads[i], NULL);
+        }
+        free(threads);
+    }
+
+    reduce_to_root(job.roots, job.num_subtrees);
+
+    unsigned char final_msg[32 + 8 + 2];
+    memcpy(final_msg, job.roots[0], 32);
+    for (int k = 0; k < 8; k++) {
+        final_msg[32 + k] = (unsigned char)((uint64_t)len >> (56 - 8 * k));
+    }
+    final_msg[40] = ROOT_SUFFIX;
+    final_msg[41] = SM3_TREE_VERSION;
+    sm3_single(final_msg, sizeof(final_msg), digest);
+
+    free(job.roots);
+    return 0;
+}
+
+int sm3_tree_file(const char *path, unsigned int nthreads, unsigned char digest[32]) {
+#if defined(_WIN32) || defined(_WIN64)
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        return -1;
+    }
+    if (fseek(fp, 0, SEEK_END) != 0) {
+        fclose(fp);
+        return -1;
+    }
+    long size = ftell(fp);
+    if (size < 0) {
+        fclose(fp);
+        return -1;
+    }
+    rewind(fp);
+    unsigned char *buf = (unsigned char*)malloc(size > 0 ? (size_t)size : 1);
+    if (!buf || fread(buf, 1, (size_t)size, fp) != (size_t)size) {
+        free(buf);
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+    int ret = sm3_tree(buf, (size_t)size, nthreads, digest);
+    free(buf);
+    return ret;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t)st.st_size;
+    if (size == 0) {
+        close(fd);
+        return sm3_tree(NULL, 0, nthreads, digest);
+    }
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+#ifdef MADV_SEQUENTIAL
+    madvise(map, size, MADV_SEQUENTIAL);
+#endif
+    int ret = sm3_tree((const unsigned char*)map, size, nthreads, digest);
+    munmap(map, size);
+    return ret;
+#endif
+}
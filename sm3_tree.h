@@ -0,0 +1,54 @@
+// author： https://github.com/8891689
+// sm3_tree.h
+#ifndef SM3_TREE_H
+#define SM3_TREE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * SM3 树哈希格式 (版本 1)
+ *
+ *   1. 输入按 SM3_TREE_LEAF_SIZE (8 KiB) 切分为叶子，最后一个叶子可以较短；
+ *      空输入视为一个长度为 0 的叶子。
+ *   2. 叶子摘要:   L = SM3(leaf || 0x00)
+ *   3. 内部节点:   N = SM3(left || right || 0x01)
+ *      逐层两两配对，若某层节点数为奇数，最后一个节点原样提升到上一层
+ *      （与 RFC 6962 的左满二叉树形状一致）。
+ *   4. 最终摘要:   SM3(root || be64(总字节数) || 0x02 || SM3_TREE_VERSION)
+ *
+ * 后缀字节用于区分叶子/节点/根，不会增加压缩次数 (8 KiB 叶子与 64 字节
+ * 节点本来就需要一个额外的填充分组)。树的形状只取决于叶子数量，
+ * 因此摘要与线程数、SIMD 宽度无关，可用于内容寻址。
+ */
+#define SM3_TREE_VERSION   1
+#define SM3_TREE_LEAF_SIZE 8192
+
+/**
+ * @brief 计算内存数据的 SM3 树哈希
+ * @param data     输入数据 (len 为 0 时可为 NULL)
+ * @param len      输入长度（字节）
+ * @param nthreads 工作线程数，0 表示使用全部在线 CPU
+ * @param digest   输出 32 字节摘要
+ * @return 成功返回 0，内存分配失败返回 -1
+ */
+int sm3_tree(const unsigned char *data, size_t len, unsigned int nthreads, unsigned char digest[32]);
+
+/**
+ * @brief 计算文件的 SM3 树哈希（POSIX 下使用 mmap，无需整体读入内存）
+ * @param path     文件路径
+ * @param nthreads 工作线程数，0 表示使用全部在线 CPU
+ * @param digest   输出 32 字节摘要
+ * @return 成功返回 0，失败返回 -1
+ */
+int sm3_tree_file(const char *path, unsigned int nthreads, unsigned char digest[32]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM3_TREE_H
@@ -0,0 +1,144 @@
+//  gcc -O3 -mavx2 -march=native sm3_avx.c sm3_tree.c sm3_tree_test.c -o sm3_tree_test
+//  author： https://github.com/8891689
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include "sm3_avx.h"
+#include "sm3_tree.h"
+
+void print_hash(const char* label, const unsigned char* hash) {
+    printf("%s: ", label);
+    for (int i = 0; i < 32; i++) {
+        printf("%02x", hash[i]);
+        if ((i + 1) % 4 == 0) printf(" ");
+    }
+    printf("\n");
+}
+
+// 按格式说明逐步实现的标量参考版本
+static void sm3_with_suffix_ref(const unsigned char *msg, size_t len, unsigned char suffix, unsigned char out[32]) {
+    unsigned char *buf = (unsigned char*)malloc(len + 1);
+    memcpy(buf, msg, len);
+    buf[len] = suffix;
+    sm3_single(buf, len + 1, out);
+    free(buf);
+}
+
+static void sm3_tree_ref(const unsigned char *data, size_t len, unsigned char digest[32]) {
+    size_t n = (len == 0) ? 1 : (len + SM3_TREE_LEAF_SIZE - 1) / SM3_TREE_LEAF_SIZE;
+    unsigned char (*nodes)[32] = malloc(n * 32);
+
+    for (size_t i = 0; i < n; i++) {
+        size_t off = i * SM3_TREE_LEAF_SIZE;
+        size_t l = (len - off < SM3_TREE_LEAF_SIZE) ? len - off : SM3_TREE_LEAF_SIZE;
+        sm3_with_suffix_ref(data + off, l, 0x00, nodes[i]);
+    }
+    while (n > 1) {
+        size_t m = 0;
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            sm3_with_suffix_ref(nodes[i], 64, 0x01, nodes[m++]);
+        }
+        if (n & 1) {
+            memcpy(nodes[m++], nodes[n - 1], 32);
+        }
+        n = m;
+    }
+
+    unsigned char final_msg[42];
+    memcpy(final_msg, nodes[0], 32);
+    for (int k = 0; k < 8; k++) {
+        final_msg[32 + k] = (unsigned char)((uint64_t)len >> (56 - 8 * k));
+    }
+    final_msg[40] = 0x02;
+    final_msg[41] = SM3_TREE_VERSION;
+    sm3_single(final_msg, sizeof(final_msg), digest);
+    free(nodes);
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+int main() {
+    printf("--- SM3 Tree Hash (format v%d, %d-byte leaves) Correctness Test ---\n",
+           SM3_TREE_VERSION, SM3_TREE_LEAF_SIZE);
+
+    const size_t lengths[] = {
+        0, 1, 63, 64, 8191, 8192, 8193, 3 * 8192 + 5, 17 * 8192,
+        256 * 8192, 256 * 8192 + 1, 600 * 8192 + 777
+    };
+    const size_t max_len = 600 * 8192 + 777;
+    unsigned char *data = (unsigned char*)malloc(max_len);
+    if (!data) {
+        perror("Failed to allocate test data");
+        return 1;
+    }
+    for (size_t i = 0; i < max_len; i++) {
+        data[i] = (unsigned char)(i * 131 + (i >> 13));
+    }
+
+    int failures = 0;
+    for (size_t t = 0; t < sizeof(lengths) / sizeof(lengths[0]); t++) {
+        unsigned char ref[32], d1[32], d4[32];
+        sm3_tree_ref(data, lengths[t], ref);
+        sm3_tree(data, lengths[t], 1, d1);
+        sm3_tree(data, lengths[t], 4, d4);
+        int ok = memcmp(ref, d1, 32) == 0 && memcmp(ref, d4, 32) == 0;
+        printf("len %8zu: ", lengths[t]);
+        for (int i = 0; i < 32; i++) printf("%02x", d1[i]);
+        printf(ok ? " (MATCHES reference)\n" : " (MISMATCH with reference!)\n");
+        failures += !ok;
+    }
+
+    // 文件入口
+    const char *tmp_path = "sm3_tree_test.tmp";
+    FILE *fp = fopen(tmp_path, "wb");
+    if (fp) {
+        fwrite(data, 1, max_len, fp);
+        fclose(fp);
+        unsigned char ref[32], df[32];
+        sm3_tree_ref(data, max_len, ref);
+        int ok = sm3_tree_file(tmp_path, 0, df) == 0 && memcmp(ref, df, 32) == 0;
+        printf("file entry (%zu bytes): %s\n", max_len, ok ? "PASS" : "FAIL");
+        failures += !ok;
+        remove(tmp_path);
+    }
+    free(data);
+
+    // --- 吞吐量测试部分 ---
+    printf("\n--- Throughput: SM3 tree vs. sequential sm3_single ---\n");
+    const size_t BENCH_SIZE = 256 * 1024 * 1024;
+    unsigned char *big = (unsigned char*)malloc(BENCH_SIZE);
+    if (!big) {
+        perror("Failed to allocate benchmark buffer");
+        return 1;
+    }
+    memset(big, 'a', BENCH_SIZE);
+    unsigned char digest[32];
+
+    double t0 = now_sec();
+    sm3_single(big, BENCH_SIZE, digest);
+    double t_seq = now_sec() - t0;
+    printf("sm3_single           : %8.2f MB/s\n", BENCH_SIZE / (1024.0 * 1024.0) / t_seq);
+
+    const unsigned int thread_counts[] = {1, 2, 4, 0};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        t0 = now_sec();
+        sm3_tree(big, BENCH_SIZE, thread_counts[t], digest);
+        double el = now_sec() - t0;
+        if (thread_counts[t] == 0) {
+            printf("sm3_tree (all cpus)  : %8.2f MB/s\n", BENCH_SIZE / (1024.0 * 1024.0) / el);
+        } else {
+            printf("sm3_tree (%u thread%s) : %8.2f MB/s\n", thread_counts[t],
+                   thread_counts[t] == 1 ? " " : "s", BENCH_SIZE / (1024.0 * 1024.0) / el);
+        }
+    }
+    print_hash("tree digest", digest);
+    free(big);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,664 @@
+// 作者：https://github.com/8891689
+// sm_aead.c
+#include "sm_aead.h"
+#include "zuc_eea3.h"
+#include "zuc_eia3.h"
+#include <immintrin.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 一次交给 SM4 内核的最多计数器块数
+#define SM_AEAD_CHUNK_BLOCKS 64
+// 批量接口每次处理的消息数 (每个消息的 J0/A0 密钥流和中间标签放在栈上)
+#define SM_AEAD_GROUP 32
+// 批量 ZUC 至少有这么多个消息才走 8 通道内核，否则逐个用标量 ZUC
+#define SM_AEAD_ZUC_8CH_MIN 2
+
+// GCM：明文最长 2^36 - 32 字节 (NIST SP 800-38D)；CCM 也沿用这个上限，保证计数器只在低 32 位变化
+#define SM_AEAD_MAX_LEN ((1ULL << 36) - 32)
+
+size_t sm_aead_key_size(sm_aead_alg alg) {
+    return alg == SM_AEAD_ZUC_EEA3_EIA3 ? 32 : 16;
+}
+
+size_t sm_aead_nonce_size(sm_aead_alg alg) {
+    return alg == SM_AEAD_ZUC_EEA3_EIA3 ? 5 : 12;
+}
+
+// 密钥对象创建后轮密钥已经展开，8 分组内核不会再写 ctx，可以在多个线程间只读共享
+static inline sm4_avx_ctx *key_sm4(const sm_aead_key *key) {
+    return (sm4_avx_ctx *)&key->sm4;
+}
+
+static inline uint32_t load_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline void store_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static inline void xor_block(uint8_t *out, const uint8_t *a, const uint8_t *b) {
+    uint64_t x[2], y[2];
+    memcpy(x, a, 16);
+    memcpy(y, b, 16);
+    x[0] ^= y[0];
+    x[1] ^= y[1];
+    memcpy(out, x, 16);
+}
+
+static void xor_bytes(uint8_t *out, const uint8_t *in, const uint8_t *ks, size_t len) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) xor_block(out + i, in + i, ks + i);
+    for (; i < len; i++) out[i] = in[i] ^ ks[i];
+}
+
+// 常数时间比较前 len 字节
+static int tag_equal(const uint8_t *a, const uint8_t *b, size_t len) {
+    uint8_t diff = 0;
+    for (size_t i = 0; i < len; i++) diff |= a[i] ^ b[i];
+    return diff == 0;
+}
+
+// ===================== GHASH (PCLMULQDQ) =====================
+
+/*
+ * 分组按字节反转后装入 __m128i，GF(2^128) 中的乘法为 256 位无进位乘积左移 1 位后
+ * 按 x^128 + x^7 + x^2 + x + 1 约简 (Intel GCM 白皮书的做法)。
+ * 左移和约简都是线性的，8 个分组各自乘以 H^8..H^1 的积可以先异或在一起，只约简一次。
+ */
+static inline __m128i bswap128(__m128i x) {
+    const __m128i rev = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm_shuffle_epi8(x, rev);
+}
+
+// a * b 的 256 位无进位乘积累加到 (lo, hi)
+static inline void clmul_acc(__m128i a, __m128i b, __m128i *lo, __m128i *hi) {
+    __m128i t0 = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i t1 = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i t2 = _mm_clmulepi64_si128(a, b, 0x11);
+    *lo = _mm_xor_si128(*lo, _mm_xor_si128(t0, _mm_slli_si128(t1, 8)));
+    *hi = _mm_xor_si128(*hi, _mm_xor_si128(t2, _mm_srli_si128(t1, 8)));
+}
+
+static inline __m128i gf_reduce(__m128i lo, __m128i hi) {
+    // 整体左移 1 位 (比特反转表示下的乘以 x)
+    __m128i c_lo = _mm_srli_epi32(lo, 31);
+    __m128i c_hi = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    hi = _mm_or_si128(hi, _mm_srli_si128(c_lo, 12));
+    lo = _mm_or_si128(lo, _mm_slli_si128(c_lo, 4));
+    hi = _mm_or_si128(hi, _mm_slli_si128(c_hi, 4));
+
+    // 约简：低 128 位乘以 x^7 + x^2 + x + 1 折回高 128 位
+    __m128i a = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)),
+                              _mm_slli_epi32(lo, 25));
+    __m128i carry = _mm_srli_si128(a, 4);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(a, 12));
+    __m128i b = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)),
+                              _mm_srli_epi32(lo, 7));
+    b = _mm_xor_si128(b, carry);
+    return _mm_xor_si128(hi, _mm_xor_si128(lo, b));
+}
+
+static inline __m128i gf_mul(__m128i a, __m128i b) {
+    __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+    clmul_acc(a, b, &lo, &hi);
+    return gf_reduce(lo, hi);
+}
+
+// 把 len 字节 (最后不足一块补零) 吸收进 GHASH 状态 x
+static __m128i ghash_update(const sm_aead_key *key, __m128i x, const uint8_t *p, size_t len) {
+    const __m128i h1 = _mm_loadu_si128((const __m128i *)key->htab[0]);
+
+    while (len >= 128) {
+        __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+        for (int i = 0; i < 8; i++) {
+            __m128i c = bswap128(_mm_loadu_si128((const __m128i *)(p + 16 * i)));
+            if (i == 0) c = _mm_xor_si128(c, x);
+            clmul_acc(c, _mm_loadu_si128((const __m128i *)key->htab[7 - i]), &lo, &hi);
+        }
+        x = gf_reduce(lo, hi);
+        p += 128;
+        len -= 128;
+    }
+    for (; len >= 16; p += 16, len -= 16) {
+        x = gf_mul(_mm_xor_si128(x, bswap128(_mm_loadu_si128((const __m128i *)p))), h1);
+    }
+    if (len > 0) {
+        uint8_t last[16] = {0};
+        memcpy(last, p, len);
+        x = gf_mul(_mm_xor_si128(x, bswap128(_mm_loadu_si128((const __m128i *)last))), h1);
+    }
+    return x;
+}
+
+// GHASH(AAD, C) 含最后的长度块，按大端字节序写出 16 字节
+static void gcm_ghash(const sm_aead_key *key, const uint8_t *aad, size_t aad_len,
+                      const uint8_t *c, size_t len, uint8_t out[16]) {
+    __m128i x = _mm_setzero_si128();
+    x = ghash_update(key, x, aad, aad_len);
+    x = ghash_update(key, x, c, len);
+    __m128i lens = _mm_set_epi64x((long long)((uint64_t)aad_len * 8), (long long)((uint64_t)len * 8));
+    x = gf_mul(_mm_xor_si128(x, lens), _mm_loadu_si128((const __m128i *)key->htab[0]));
+    _mm_storeu_si128((__m128i *)out, bswap128(x));
+}
+
+// ===================== 密钥对象 =====================
+
+int sm_aead_key_init(sm_aead_key *key, sm_aead_alg alg, const uint8_t *k, size_t tag_len) {
+    memset(key, 0, sizeof(*key));
+    key->alg = alg;
+
+    switch (alg) {
+    case SM_AEAD_SM4_GCM: {
+        if (tag_len == 0) tag_len = 16;
+        if (tag_len != 4 && tag_len != 8 && (tag_len < 12 || tag_len > 16)) return -1;
+        sm4_avx_init(&key->sm4, k, 1);
+        // H = E(K, 0^128)，预先算好 H^1..H^8
+        uint8_t zero[16] = {0}, h[16];
+        sm4_avx_encrypt_blocks(&key->sm4, zero, h, 1);
+        __m128i hx = bswap128(_mm_loadu_si128((const __m128i *)h));
+        __m128i p = hx;
+        for (int i = 0; i < 8; i++) {
+            _mm_storeu_si128((__m128i *)key->htab[i], p);
+            p = gf_mul(p, hx);
+        }
+        memset(h, 0, sizeof(h));
+        break;
+    }
+    case SM_AEAD_SM4_CCM:
+        if (tag_len == 0) tag_len = 16;
+        if (tag_len < 4 || tag_len > 16 || tag_len % 2 != 0) return -1;
+        sm4_avx_init(&key->sm4, k, 1);
+        break;
+    case SM_AEAD_ZUC_EEA3_EIA3:
+        if (tag_len == 0) tag_len = 4;
+        if (tag_len != 4) return -1;
+        memcpy(key->ck, k, 16);
+        memcpy(key->ik, k + 16, 16);
+        break;
+    default:
+        return -1;
+    }
+    key->tag_len = tag_len;
+    return 0;
+}
+
+void sm_aead_key_clear(sm_aead_key *key) {
+    memset(key, 0, sizeof(*key));
+}
+
+// 检查单个消息的参数
+static int msg_valid(const sm_aead_key *key, const sm_aead_msg *m) {
+    if (m->tag == NULL || (m->len > 0 && (m->in == NULL || m->out == NULL)) ||
+        (m->aad_len > 0 && m->aad == NULL) || m->nonce == NULL) {
+        return 0;
+    }
+    switch (key->alg) {
+    case SM_AEAD_SM4_GCM:
+        return m->nonce_len == 12 && (uint64_t)m->len <= SM_AEAD_MAX_LEN;
+    case SM_AEAD_SM4_CCM: {
+        if (m->nonce_len < 7 || m->nonce_len > 13) return 0;
+        // 长度字段 L = 15 - nonce_len 字节；AAD 长度编码只支持到 2^32 - 1
+        size_t L = 15 - m->nonce_len;
+        if (L < 8 && (uint64_t)m->len >> (8 * L) != 0) return 0;
+        return (uint64_t)m->len <= SM_AEAD_MAX_LEN && (uint64_t)m->aad_len <= 0xFFFFFFFFULL;
+    }
+    case SM_AEAD_ZUC_EEA3_EIA3:
+        // EIA3 的比特长度为 32 位，覆盖 AAD || 密文
+        return m->nonce_len == 5 && (m->nonce[4] & 3) == 0 &&
+               (uint64_t)m->aad_len + m->len < (1ULL << 29);
+    }
+    return 0;
+}
+
+static int batch_valid(const sm_aead_key *key, const sm_aead_msg *msgs, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (!msg_valid(key, &msgs[i])) return 0;
+    }
+    return 1;
+}
+
+// ===================== CTR (GCM / CCM 共用) =====================
+
+/*
+ * 一组消息的 CTR 加解密：消息 i 的第 j 个计数器块是 ctr0[i] 的低 32 位 (大端) 加 j。
+ * 各消息的计数器块依次拼入同一个缓冲区，凑满 SM_AEAD_CHUNK_BLOCKS 块后一次交给 8 分组内核，
+ * 小消息也能填满内核。第 0 块 (GCM 的 J0 / CCM 的 A0) 不用于数据，加密结果写入 s0[i] 留给标签。
+ */
+static void ctr_batch(const sm_aead_key *key, sm_aead_msg *msgs, size_t n,
+                      const uint8_t ctr0[][16], uint8_t s0[][16]) {
+    uint8_t ks[SM_AEAD_CHUNK_BLOCKS * 16];
+    size_t mi = 0, bj = 0;      // 下一个要生成的计数器块：消息 mi 的第 bj 块
+
+    while (mi < n) {
+        size_t cm = mi, cb = bj, nb = 0;
+        while (mi < n && nb < SM_AEAD_CHUNK_BLOCKS) {
+            size_t total = 1 + (msgs[mi].len + 15) / 16;
+            size_t take = total - bj;
+            if (take > SM_AEAD_CHUNK_BLOCKS - nb) take = SM_AEAD_CHUNK_BLOCKS - nb;
+            uint32_t base = load_be32(ctr0[mi] + 12);
+            for (size_t k = 0; k < take; k++) {
+                memcpy(ks + 16 * (nb + k), ctr0[mi], 12);
+                store_be32(ks + 16 * (nb + k) + 12, base + (uint32_t)(bj + k));
+            }
+            nb += take;
+            bj += take;
+            if (bj == total) {
+                mi++;
+                bj = 0;
+            }
+        }
+        sm4_avx_encrypt_blocks(key_sm4(key), ks, ks, nb);
+
+        // 按同样的顺序把密钥流分给各消息
+        for (size_t off = 0; off < nb;) {
+            sm_aead_msg *m = &msgs[cm];
+            size_t total = 1 + (m->len + 15) / 16;
+            size_t take = total - cb;
+            if (take > nb - off) take = nb - off;
+            size_t k = 0;
+            if (cb == 0) {
+                memcpy(s0[cm], ks + 16 * off, 16);
+                k = 1;
+            }
+            // 数据块 d 对应计数器块 d + 1
+            size_t p = (cb + k - 1) * 16;
+            size_t end = (cb + take - 1) * 16;
+            if (end > m->len) end = m->len;
+            if (end > p) xor_bytes(m->out + p, m->in + p, ks + 16 * (off + k), end - p);
+            off += take;
+            cb += take;
+            if (cb == total) {
+                cm++;
+                cb = 0;
+            }
+        }
+    }
+    memset(ks, 0, sizeof(ks));
+}
+
+// ===================== GCM =====================
+
+static void gcm_ctr0(const sm_aead_msg *m, uint8_t ctr0[16]) {
+    memcpy(ctr0, m->nonce, 12);
+    store_be32(ctr0 + 12, 1);
+}
+
+static void gcm_seal_group(const sm_aead_key *key, sm_aead_msg *msgs, size_t n) {
+    uint8_t ctr0[SM_AEAD_GROUP][16], s0[SM_AEAD_GROUP][16], t[16];
+
+    for (size_t i = 0; i < n; i++) gcm_ctr0(&msgs[i], ctr0[i]);
+    ctr_batch(key, msgs, n, ctr0, s0);
+    for (size_t i = 0; i < n; i++) {
+        gcm_ghash(key, msgs[i].aad, msgs[i].aad_len, msgs[i].out, msgs[i].len, t);
+        xor_block(t, t, s0[i]);
+        memcpy(msgs[i].tag, t, key->tag_len);
+    }
+    memset(s0, 0, sizeof(s0));
+}
+
+static int gcm_open_group(const sm_aead_key *key, sm_aead_msg *msgs, size_t n) {
+    uint8_t ctr0[SM_AEAD_GROUP][16], s0[SM_AEAD_GROUP][16], t[SM_AEAD_GROUP][16];
+    int ret = 0;
+
+    // 先对密文做 GHASH (解密可能是原地的)
+    for (size_t i = 0; i < n; i++) {
+        gcm_ghash(key, msgs[i].aad, msgs[i].aad_len, msgs[i].in, msgs[i].len, t[i]);
+        gcm_ctr0(&msgs[i], ctr0[i]);
+    }
+    ctr_batch(key, msgs, n, ctr0, s0);
+    for (size_t i = 0; i < n; i++) {
+        xor_block(t[i], t[i], s0[i]);
+        msgs[i].status = tag_equal(t[i], msgs[i].tag, key->tag_len) ? 0 : -1;
+        if (msgs[i].status != 0) {
+            memset(msgs[i].out, 0, msgs[i].len);
+            ret = -1;
+        }
+    }
+    memset(s0, 0, sizeof(s0));
+    return ret;
+}
+
+// ===================== CCM =====================
+
+// CBC-MAC 的输入：B0 || AAD 长度编码 || AAD || 补零 || 明文 || 补零 (RFC 3610)
+static inline size_t ccm_aad_hdr_len(size_t aad_len) {
+    return aad_len == 0 ? 0 : aad_len < 0xFF00 ? 2 : 6;
+}
+
+static inline size_t ccm_aad_blocks(size_t aad_len) {
+    return (ccm_aad_hdr_len(aad_len) + aad_len + 15) / 16;
+}
+
+// 第 idx 个 CBC-MAC 输入块；payload 为明文 (加密时是 in，解密时是已解密的 out)
+static void ccm_block(const sm_aead_msg *m, const uint8_t *payload, size_t tag_len, size_t idx,
+                      uint8_t b[16]) {
+    memset(b, 0, 16);
+    if (idx == 0) {
+        size_t L = 15 - m->nonce_len;
+        b[0] = (uint8_t)((m->aad_len > 0 ? 0x40 : 0) | ((tag_len - 2) / 2) << 3 | (L - 1));
+        memcpy(b + 1, m->nonce, m->nonce_len);
+        uint64_t len = m->len;
+        for (size_t i = 0; i < L && i < 8; i++, len >>= 8) b[15 - i] = (uint8_t)len;
+        return;
+    }
+
+    size_t off = (idx - 1) * 16;
+    size_t aad_end = ccm_aad_blocks(m->aad_len) * 16;
+    if (off < aad_end) {
+        uint8_t hdr[6];
+        size_t h = ccm_aad_hdr_len(m->aad_len);
+        if (h == 2) {
+            hdr[0] = (uint8_t)(m->aad_len >> 8);
+            hdr[1] = (uint8_t)m->aad_len;
+        } else if (h == 6) {
+            hdr[0] = 0xFF;
+            hdr[1] = 0xFE;
+            store_be32(hdr + 2, (uint32_t)m->aad_len);
+        }
+        // 块内 [0, 16) 对应字节流 [off, off + 16)：先是长度编码，然后是 AAD
+        size_t j = 0;
+        for (; j < 16 && off + j < h; j++) b[j] = hdr[off + j];
+        size_t a = off + j - h;
+        if (a < m->aad_len) {
+            size_t n = m->aad_len - a < 16 - j ? m->aad_len - a : 16 - j;
+            memcpy(b + j, m->aad + a, n);
+        }
+        return;
+    }
+
+    size_t p = off - aad_end;
+    size_t n = m->len - p < 16 ? m->len - p : 16;
+    memcpy(b, payload + p, n);
+}
+
+static inline size_t ccm_mac_blocks(const sm_aead_msg *m) {
+    return 1 + ccm_aad_blocks(m->aad_len) + (m->len + 15) / 16;
+}
+
+/*
+ * 一组消息的 CBC-MAC。同一个消息的各块前后相互依赖，这里改为 8 个消息并行：
+ * 每个通道负责一个消息，每一步把 8 个通道的当前链值作为 8 个分组一次交给内核；
+ * 某个通道的消息结束后立即装入下一个消息 (与 zuc_eea3 作业管理器相同的做法)。
+ * use_out 为 0 时明文在 in，否则在 out。
+ */
+static void ccm_cbc_mac_batch(const sm_aead_key *key, const sm_aead_msg *msgs, size_t n, int use_out,
+                              uint8_t mac[][16]) {
+    struct {
+        size_t msg, blk, nblk;
+    } lane[8];
+    uint8_t x[8 * 16], b[16];
+    size_t active = 0, next = 0;
+
+    for (;;) {
+        while (active < 8 && next < n) {
+            lane[active].msg = next;
+            lane[active].blk = 0;
+            lane[active].nblk = ccm_mac_blocks(&msgs[next]);
+            memset(x + 16 * active, 0, 16);
+            active++;
+            next++;
+        }
+        if (active == 0) break;
+
+        for (size_t l = 0; l < active; l++) {
+            const sm_aead_msg *m = &msgs[lane[l].msg];
+            ccm_block(m, use_out ? m->out : m->in, key->tag_len, lane[l].blk++, b);
+            xor_block(x + 16 * l, x + 16 * l, b);
+        }
+        sm4_avx_encrypt_blocks(key_sm4(key), x, x, active);
+
+        // 结束的通道用最后一个通道补位
+        for (size_t l = 0; l < active;) {
+            if (lane[l].blk == lane[l].nblk) {
+                memcpy(mac[lane[l].msg], x + 16 * l, 16);
+                active--;
+                lane[l] = lane[active];
+                memcpy(x + 16 * l, x + 16 * active, 16);
+            } else {
+                l++;
+            }
+        }
+    }
+    memset(x, 0, sizeof(x));
+}
+
+static void ccm_ctr0(const sm_aead_msg *m, uint8_t ctr0[16]) {
+    memset(ctr0, 0, 16);
+    ctr0[0] = (uint8_t)(15 - m->nonce_len - 1);
+    memcpy(ctr0 + 1, m->nonce, m->nonce_len);
+}
+
+static void ccm_seal_group(const sm_aead_key *key, sm_aead_msg *msgs, size_t n) {
+    uint8_t ctr0[SM_AEAD_GROUP][16], s0[SM_AEAD_GROUP][16], t[SM_AEAD_GROUP][16];
+
+    // 先对明文算 MAC (加密可能是原地的)
+    ccm_cbc_mac_batch(key, msgs, n, 0, t);
+    for (size_t i = 0; i < n; i++) ccm_ctr0(&msgs[i], ctr0[i]);
+    ctr_batch(key, msgs, n, ctr0, s0);
+    for (size_t i = 0; i < n; i++) {
+        xor_block(t[i], t[i], s0[i]);
+        memcpy(msgs[i].tag, t[i], key->tag_len);
+    }
+    memset(s0, 0, sizeof(s0));
+    memset(t, 0, sizeof(t));
+}
+
+static int ccm_open_group(const sm_aead_key *key, sm_aead_msg *msgs, size_t n) {
+    uint8_t ctr0[SM_AEAD_GROUP][16], s0[SM_AEAD_GROUP][16], t[SM_AEAD_GROUP][16];
+    int ret = 0;
+
+    for (size_t i = 0; i < n; i++) ccm_ctr0(&msgs[i], ctr0[i]);
+    ctr_batch(key, msgs, n, ctr0, s0);
+    ccm_cbc_mac_batch(key, msgs, n, 1, t);
+    for (size_t i = 0; i < n; i++) {
+        xor_block(t[i], t[i], s0[i]);
+        msgs[i].status = tag_equal(t[i], msgs[i].tag, key->tag_len) ? 0 : -1;
+        if (msgs[i].status != 0) {
+            memset(msgs[i].out, 0, msgs[i].len);
+            ret = -1;
+        }
+    }
+    memset(s0, 0, sizeof(s0));
+    memset(t, 0, sizeof(t));
+    return ret;
+}
+
+// ===================== ZUC EEA3 + EIA3 =====================
+
+static void zuc_nonce(const sm_aead_msg *m, uint32_t *count, uint8_t *bearer, uint8_t *direction) {
+    *count = load_be32(m->nonce);
+    *bearer = m->nonce[4] >> 3;
+    *direction = (m->nonce[4] >> 2) & 1;
+}
+
+// 一组消息中需要拼接 AAD || data 的字节数 (没有 AAD 的消息直接使用 data)
+static size_t zuc_group_scratch(const sm_aead_msg *msgs, size_t n) {
+    size_t len = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (msgs[i].aad_len > 0) len += msgs[i].aad_len + msgs[i].len;
+    }
+    return len;
+}
+
+// 整个批量调用所需的临时缓冲区 (各组中的最大值)，在处理任何消息之前一次分配
+static size_t zuc_batch_scratch(const sm_aead_msg *msgs, size_t n) {
+    size_t max = 0;
+    for (size_t i = 0; i < n; i += SM_AEAD_GROUP) {
+        size_t g = n - i < SM_AEAD_GROUP ? n - i : SM_AEAD_GROUP;
+        size_t len = zuc_group_scratch(msgs + i, g);
+        if (len > max) max = len;
+    }
+    return max;
+}
+
+/*
+ * 对 AAD || data 计算 EIA3，结果写入 mac[i]。EIA3 需要连续的消息，
+ * 有 AAD 的消息先拼到 scratch (至少 zuc_group_scratch 字节；没有 AAD 时直接使用 data)。
+ * use_out 为 0 时 data 在 in，否则在 out。
+ */
+static void zuc_mac_group(const sm_aead_key *key, const sm_aead_msg *msgs, size_t n, int use_out,
+                          uint8_t *scratch, uint32_t mac[]) {
+    zuc_eia3_job jobs[SM_AEAD_GROUP];
+    uint8_t *p = scratch;
+
+    for (size_t i = 0; i < n; i++) {
+        const sm_aead_msg *m = &msgs[i];
+        const uint8_t *data = use_out ? m->out : m->in;
+        jobs[i].key = key->ik;
+        zuc_nonce(m, &jobs[i].count, &jobs[i].bearer, &jobs[i].direction);
+        jobs[i].bitlen = (uint32_t)((m->aad_len + m->len) * 8);
+        if (m->aad_len > 0) {
+            memcpy(p, m->aad, m->aad_len);
+            if (m->len > 0) memcpy(p + m->aad_len, data, m->len);
+            jobs[i].msg = p;
+            p += m->aad_len + m->len;
+        } else {
+            jobs[i].msg = data;
+        }
+    }
+
+    if (n >= SM_AEAD_ZUC_8CH_MIN) {
+        zuc_eia3_8ch(jobs, n);
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            jobs[i].mac = zuc_eia3(jobs[i].key, jobs[i].count, jobs[i].bearer, jobs[i].direction,
+                                   jobs[i].msg, jobs[i].bitlen);
+        }
+    }
+    for (size_t i = 0; i < n; i++) mac[i] = jobs[i].mac;
+}
+
+// 只处理 sel[i] 非 0 的消息
+static void zuc_crypt_group(const sm_aead_key *key, const sm_aead_msg *msgs, size_t n, const int *sel) {
+    zuc_eea3_job jobs[SM_AEAD_GROUP];
+    size_t nj = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        const sm_aead_msg *m = &msgs[i];
+        if ((sel && !sel[i]) || m->len == 0) continue;
+        jobs[nj].key = key->ck;
+        zuc_nonce(m, &jobs[nj].count, &jobs[nj].bearer, &jobs[nj].direction);
+        jobs[nj].in = m->in;
+        jobs[nj].out = m->out;
+        jobs[nj].bitlen = (uint32_t)(m->len * 8);
+        nj++;
+    }
+    if (nj >= SM_AEAD_ZUC_8CH_MIN) {
+        zuc_eea3_8ch(jobs, nj);
+    } else {
+        for (size_t i = 0; i < nj; i++) {
+            zuc_eea3(jobs[i].key, jobs[i].count, jobs[i].bearer, jobs[i].direction,
+                     jobs[i].in, jobs[i].out, jobs[i].bitlen);
+        }
+    }
+}
+
+static void zuc_seal_group(const sm_aead_key *key, sm_aead_msg *msgs, size_t n, uint8_t *scratch) {
+    uint32_t mac[SM_AEAD_GROUP];
+
+    zuc_crypt_group(key, msgs, n, NULL);
+    zuc_mac_group(key, msgs, n, 1, scratch, mac);
+    for (size_t i = 0; i < n; i++) store_be32(msgs[i].tag, mac[i]);
+}
+
+static int zuc_open_group(const sm_aead_key *key, sm_aead_msg *msgs, size_t n, uint8_t *scratch) {
+    uint32_t mac[SM_AEAD_GROUP];
+    int ok[SM_AEAD_GROUP], ret = 0;
+    uint8_t t[4];
+
+    // 先验证，只解密通过的消息
+    zuc_mac_group(key, msgs, n, 0, scratch, mac);
+    for (size_t i = 0; i < n; i++) {
+        store_be32(t, mac[i]);
+        ok[i] = tag_equal(t, msgs[i].tag, 4);
+        msgs[i].status = ok[i] ? 0 : -1;
+        if (!ok[i]) {
+            memset(msgs[i].out, 0, msgs[i].len);
+            ret = -1;
+        }
+    }
+    zuc_crypt_group(key, msgs, n, ok);
+    return ret;
+}
+
+// ===================== 公共接口 =====================
+
+int sm_aead_seal_batch(const sm_aead_key *key, sm_aead_msg *msgs, size_t n) {
+    uint8_t *scratch = NULL;
+    size_t scratch_len;
+
+    if (!batch_valid(key, msgs, n)) return -1;
+    if (key->alg == SM_AEAD_ZUC_EEA3_EIA3 && (scratch_len = zuc_batch_scratch(msgs, n)) > 0 &&
+        (scratch = malloc(scratch_len)) == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; i += SM_AEAD_GROUP) {
+        size_t g = n - i < SM_AEAD_GROUP ? n - i : SM_AEAD_GROUP;
+        switch (key->alg) {
+        case SM_AEAD_SM4_GCM:
+            gcm_seal_group(key, msgs + i, g);
+            break;
+        case SM_AEAD_SM4_CCM:
+            ccm_seal_group(key, msgs + i, g);
+            break;
+        case SM_AEAD_ZUC_EEA3_EIA3:
+            zuc_seal_group(key, msgs + i, g, scratch);
+            break;
+        }
+    }
+    free(scratch);
+    return 0;
+}
+
+int sm_aead_open_batch(const sm_aead_key *key, sm_aead_msg *msgs, size_t n) {
+    uint8_t *scratch = NULL;
+    size_t scratch_len;
+    int ret = 0;
+
+    if (!batch_valid(key, msgs, n)) return -1;
+    if (key->alg == SM_AEAD_ZUC_EEA3_EIA3 && (scratch_len = zuc_batch_scratch(msgs, n)) > 0 &&
+        (scratch = malloc(scratch_len)) == NULL) {
+        // 与参数无效相同：不处理任何消息，out 不被写入
+        for (size_t i = 0; i < n; i++) msgs[i].status = -1;
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; i += SM_AEAD_GROUP) {
+        size_t g = n - i < SM_AEAD_GROUP ? n - i : SM_AEAD_GROUP;
+        switch (key->alg) {
+        case SM_AEAD_SM4_GCM:
+            ret |= gcm_open_group(key, msgs + i, g);
+            break;
+        case SM_AEAD_SM4_CCM:
+            ret |= ccm_open_group(key, msgs + i, g);
+            break;
+        case SM_AEAD_ZUC_EEA3_EIA3:
+            ret |= zuc_open_group(key, msgs + i, g, scratch);
+            break;
+        }
+    }
+    free(scratch);
+    return ret;
+}
+
+int sm_aead_seal(const sm_aead_key *key, const uint8_t *nonce, size_t nonce_len,
+                 const uint8_t *aad, size_t aad_len, const uint8_t *in, uint8_t *out, size_t len,
+                 uint8_t *tag) {
+    sm_aead_msg m = {nonce, nonce_len, aad, aad_len, in, out, len, tag, 0};
+    return sm_aead_seal_batch(key, &m, 1);
+}
+
+int sm_aead_open(const sm_aead_key *key, const uint8_t *nonce, size_t nonce_len,
+                 const uint8_t *aad, size_t aad_len, const uint8_t *in, uint8_t *out, size_t len,
+                 const uint8_t *tag) {
+    sm_aead_msg m = {nonce, nonce_len, aad, aad_len, in, out, len, (uint8_t *)tag, 0};
+    return sm_aead_open_batch(key, &m, 1);
+}
@@ -0,0 +1,112 @@
+// 作者：https://github.com/8891689
+// sm_aead.h
+#ifndef SM_AEAD_H
+#define SM_AEAD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sm4_avx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 统一的 AEAD 接口：seal (加密 + 认证) / open (验证 + 解密)，以及处理多个独立消息的批量版本。
+ *
+ * - SM4-GCM：nonce 12 字节，标签 4~16 字节 (RFC 8998)
+ * - SM4-CCM：nonce 7~13 字节，标签 4~16 字节中的偶数 (RFC 8998)
+ * - ZUC EEA3+EIA3：密钥 32 字节 = CK (128-EEA3) || IK (128-EIA3)；nonce 5 字节，
+ *   即 EEA3 IV 的前 5 字节：COUNT (大端 32 位) || BEARER (高 5 位) | DIRECTION (第 2 位)。
+ *   先用 EEA3 加密，再对 AAD || 密文计算 EIA3，标签固定 4 字节。这是本库的组合方式，
+ *   不是 3GPP 定义的 AEAD；open 先验证，通过后才解密。
+ *
+ * 与每个密钥相关的准备工作 (SM4 轮密钥、GHASH 的 H 幂次表、ZUC 的 CK/IK) 在 sm_aead_key_init
+ * 中一次完成，之后同一个密钥对象可以反复使用，也可以被多个线程同时只读使用。
+ *
+ * 批量接口按算法把多个消息交给多通道内核：
+ * - GCM/CCM：各消息的计数器块拼在一起交给 8 分组 SM4 内核；CCM 的 CBC-MAC 在消息内是串行的，
+ *   改为 8 个消息各占一个分组位置并行计算
+ * - ZUC：交给 zuc_eea3_8ch / zuc_eia3_8ch (8 通道，通道空出后立即装入下一个消息)
+ */
+typedef enum {
+    SM_AEAD_SM4_GCM = 0,
+    SM_AEAD_SM4_CCM,
+    SM_AEAD_ZUC_EEA3_EIA3,
+} sm_aead_alg;
+
+#define SM_AEAD_MAX_TAG 16
+
+typedef struct {
+    sm_aead_alg alg;
+    size_t tag_len;
+    sm4_avx_ctx sm4;            // GCM/CCM：加密方向轮密钥
+    uint8_t htab[8][16];        // GCM：H^1..H^8，按字节反转后的形式，供 8 块聚合的 GHASH 使用
+    uint8_t ck[16], ik[16];     // ZUC：加密/完整性密钥
+} sm_aead_key;
+
+// 批量接口中的一个消息；in 与 out 可以相同，各消息之间不能重叠
+typedef struct {
+    const uint8_t *nonce;
+    size_t nonce_len;
+    const uint8_t *aad;
+    size_t aad_len;
+    const uint8_t *in;
+    uint8_t *out;
+    size_t len;
+    uint8_t *tag;           // seal：输出 tag_len 字节；open：输入
+    int status;             // open_batch 输出：0 验证通过，-1 失败 (out 被清零)
+} sm_aead_msg;
+
+/**
+ * @brief 算法的密钥/nonce 长度 (字节)；CCM 的 nonce 可以是 7~13 字节，这里返回常用的 12
+ */
+size_t sm_aead_key_size(sm_aead_alg alg);
+size_t sm_aead_nonce_size(sm_aead_alg alg);
+
+/**
+ * @brief 建立密钥对象。tag_len 为 0 时取默认值 (GCM/CCM 16，ZUC 4)
+ * @return 成功返回 0；未知算法或标签长度不支持返回 -1
+ */
+int sm_aead_key_init(sm_aead_key *key, sm_aead_alg alg, const uint8_t *k, size_t tag_len);
+
+/**
+ * @brief 清零密钥对象
+ */
+void sm_aead_key_clear(sm_aead_key *key);
+
+/**
+ * @brief 加密 len 字节并输出 key->tag_len 字节的标签
+ * @return 成功返回 0；nonce 长度不支持或消息过长返回 -1
+ */
+int sm_aead_seal(const sm_aead_key *key, const uint8_t *nonce, size_t nonce_len,
+                 const uint8_t *aad, size_t aad_len, const uint8_t *in, uint8_t *out, size_t len,
+                 uint8_t *tag);
+
+/**
+ * @brief 验证标签并解密
+ * @return 成功返回 0；参数无效或验证失败返回 -1 (此时 out 被清零)
+ */
+int sm_aead_open(const sm_aead_key *key, const uint8_t *nonce, size_t nonce_len,
+                 const uint8_t *aad, size_t aad_len, const uint8_t *in, uint8_t *out, size_t len,
+                 const uint8_t *tag);
+
+/**
+ * @brief 批量加密 n 个消息，所有消息使用同一个密钥对象 (nonce 各自不同)。
+ * 先检查全部参数 (ZUC 还要分配拼接 AAD 的临时缓冲区)，有任何一个无效或分配失败则不处理任何消息。
+ * @return 成功返回 0，参数无效或分配失败返回 -1
+ */
+int sm_aead_seal_batch(const sm_aead_key *key, sm_aead_msg *msgs, size_t n);
+
+/**
+ * @brief 批量验证并解密，每个消息的结果写入 msgs[i].status
+ * @return 全部通过返回 0；参数无效 (不处理任何消息) 或至少一个验证失败返回 -1；
+ *         ZUC 临时缓冲区分配失败时不处理任何消息 (out 不被写入)，所有 status 置为 -1 并返回 -1
+ */
+int sm_aead_open_batch(const sm_aead_key *key, sm_aead_msg *msgs, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM_AEAD_H
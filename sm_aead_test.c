@@ -0,0 +1,369 @@
+// gcc -O3 -mavx2 -march=native sm4_avx.c zuc.c zuc_avx2.c zuc_eea3.c zuc_eia3.c sm_aead.c sm_aead_test.c -o sm_aead_test
+// https://github.com/8891689
+// sm_aead_test.c
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sm_aead.h"
+#include "zuc_eea3.h"
+#include "zuc_eia3.h"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+static void hex2bin(const char *hex, uint8_t *out) {
+    for (size_t i = 0; hex[2 * i]; i++) {
+        unsigned v;
+        sscanf(hex + 2 * i, "%2x", &v);
+        out[i] = (uint8_t)v;
+    }
+}
+
+// RFC 8998 附录 A.1 / A.2
+static const char *kat_key = "0123456789ABCDEFFEDCBA9876543210";
+static const char *kat_nonce = "00001234567800000000ABCD";
+static const char *kat_aad = "FEEDFACEDEADBEEFFEEDFACEDEADBEEFABADDAD2";
+static const char *kat_plain =
+    "AAAAAAAAAAAAAAAABBBBBBBBBBBBBBBBCCCCCCCCCCCCCCCCDDDDDDDDDDDDDDDD"
+    "EEEEEEEEEEEEEEEEFFFFFFFFFFFFFFFFEEEEEEEEEEEEEEEEAAAAAAAAAAAAAAAA";
+static const char *kat_gcm_cipher =
+    "17F399F08C67D5EE19D0DC9969C4BB7D5FD46FD3756489069157B282BB200735"
+    "D82710CA5C22F0CCFA7CBF93D496AC15A56834CBCF98C397B4024A2691233B8D";
+static const char *kat_gcm_tag = "83DE3541E4C2B58177E065A9BF7B62EC";
+static const char *kat_ccm_cipher =
+    "48AF93501FA62ADBCD414CCE6034D895DDA1BF8F132F042098661572E7483094"
+    "FD12E518CE062C98ACEE28D95DF4416BED31A2F04476C18BB40C84A74B97DC5B";
+static const char *kat_ccm_tag = "16842D4FA186F56AB33256971FA110F4";
+
+static int kat(sm_aead_alg alg, const char *cipher_hex, const char *tag_hex) {
+    uint8_t key[16], nonce[12], aad[20], plain[64], cipher[64], tag[16];
+    uint8_t out[64], out_tag[16], dec[64];
+    sm_aead_key k;
+
+    hex2bin(kat_key, key);
+    hex2bin(kat_nonce, nonce);
+    hex2bin(kat_aad, aad);
+    hex2bin(kat_plain, plain);
+    hex2bin(cipher_hex, cipher);
+    hex2bin(tag_hex, tag);
+    sm_aead_key_init(&k, alg, key, 16);
+    int ok = sm_aead_seal(&k, nonce, 12, aad, 20, plain, out, 64, out_tag) == 0 &&
+             memcmp(out, cipher, 64) == 0 && memcmp(out_tag, tag, 16) == 0;
+    ok &= sm_aead_open(&k, nonce, 12, aad, 20, cipher, dec, 64, tag) == 0 && memcmp(dec, plain, 64) == 0;
+    return ok;
+}
+
+// ---------------- 参照实现 ----------------
+
+// GF(2^128) 逐比特乘法 (NIST SP 800-38D 算法 1)
+static void ref_gf_mul(uint8_t x[16], const uint8_t h[16]) {
+    uint8_t z[16] = {0}, v[16];
+    memcpy(v, h, 16);
+    for (int i = 0; i < 128; i++) {
+        if (x[i / 8] & (0x80 >> (i % 8))) {
+            for (int j = 0; j < 16; j++) z[j] ^= v[j];
+        }
+        int lsb = v[15] & 1;
+        for (int j = 15; j > 0; j--) v[j] = (uint8_t)((v[j] >> 1) | (v[j - 1] << 7));
+        v[0] >>= 1;
+        if (lsb) v[0] ^= 0xE1;
+    }
+    memcpy(x, z, 16);
+}
+
+static void ref_ghash(const uint8_t h[16], uint8_t x[16], const uint8_t *p, size_t len) {
+    for (size_t i = 0; i < len; i += 16) {
+        for (size_t j = 0; j < 16 && i + j < len; j++) x[j] ^= p[i + j];
+        ref_gf_mul(x, h);
+    }
+}
+
+static void ref_ctr(sm4_avx_ctx *sm4, uint8_t ctr[16], const uint8_t *in, uint8_t *out, size_t len) {
+    uint8_t ks[16];
+    for (size_t i = 0; i < len; i += 16) {
+        for (int j = 15; j >= 12 && ++ctr[j] == 0; j--) {
+        }
+        sm4_avx_encrypt_blocks(sm4, ctr, ks, 1);
+        for (size_t j = 0; j < 16 && i + j < len; j++) out[i + j] = in[i + j] ^ ks[j];
+    }
+}
+
+static void ref_gcm(const uint8_t key[16], const uint8_t nonce[12], const uint8_t *aad, size_t aad_len,
+                    const uint8_t *in, uint8_t *out, size_t len, uint8_t tag[16]) {
+    sm4_avx_ctx sm4;
+    uint8_t h[16] = {0}, j0[16], ctr[16], x[16] = {0}, lens[16] = {0}, s[16];
+
+    sm4_avx_init(&sm4, key, 1);
+    sm4_avx_encrypt_blocks(&sm4, h, h, 1);
+    memcpy(j0, nonce, 12);
+    j0[12] = j0[13] = j0[14] = 0;
+    j0[15] = 1;
+    memcpy(ctr, j0, 16);
+    ref_ctr(&sm4, ctr, in, out, len);
+    ref_ghash(h, x, aad, aad_len);
+    ref_ghash(h, x, out, len);
+    for (int i = 0; i < 8; i++) {
+        lens[7 - i] = (uint8_t)(((uint64_t)aad_len * 8) >> (8 * i));
+        lens[15 - i] = (uint8_t)(((uint64_t)len * 8) >> (8 * i));
+    }
+    ref_ghash(h, x, lens, 16);
+    sm4_avx_encrypt_blocks(&sm4, j0, s, 1);
+    for (int i = 0; i < 16; i++) tag[i] = x[i] ^ s[i];
+}
+
+// CCM：拼出完整的 CBC-MAC 输入后逐块处理
+static void ref_ccm(const uint8_t key[16], const uint8_t *nonce, size_t nonce_len,
+                    const uint8_t *aad, size_t aad_len, const uint8_t *in, uint8_t *out, size_t len,
+                    size_t tag_len, uint8_t tag[16]) {
+    sm4_avx_ctx sm4;
+    size_t L = 15 - nonce_len, pos = 0;
+    uint8_t *b = calloc(16 + 6 + aad_len + 16 + len + 16, 1);
+    uint8_t x[16] = {0}, a[16] = {0}, s0[16];
+
+    sm4_avx_init(&sm4, key, 1);
+    b[0] = (uint8_t)((aad_len ? 0x40 : 0) | ((tag_len - 2) / 2) << 3 | (L - 1));
+    memcpy(b + 1, nonce, nonce_len);
+    for (size_t i = 0; i < L; i++) b[15 - i] = (uint8_t)((uint64_t)len >> (8 * i));
+    pos = 16;
+    if (aad_len >= 0xFF00) {
+        b[pos++] = 0xFF;
+        b[pos++] = 0xFE;
+        for (int i = 3; i >= 0; i--) b[pos++] = (uint8_t)(aad_len >> (8 * i));
+    } else if (aad_len) {
+        b[pos++] = (uint8_t)(aad_len >> 8);
+        b[pos++] = (uint8_t)aad_len;
+    }
+    if (aad_len) {
+        memcpy(b + pos, aad, aad_len);
+        pos = (pos + aad_len + 15) / 16 * 16;
+    }
+    memcpy(b + pos, in, len);
+    pos = (pos + len + 15) / 16 * 16;
+    for (size_t i = 0; i < pos; i += 16) {
+        for (int j = 0; j < 16; j++) x[j] ^= b[i + j];
+        sm4_avx_encrypt_blocks(&sm4, x, x, 1);
+    }
+    a[0] = (uint8_t)(L - 1);
+    memcpy(a + 1, nonce, nonce_len);
+    sm4_avx_encrypt_blocks(&sm4, a, s0, 1);
+    ref_ctr(&sm4, a, in, out, len);
+    for (int i = 0; i < 16; i++) tag[i] = x[i] ^ s0[i];
+    free(b);
+}
+
+// ZUC：EEA3 加密后对 AAD || 密文做 EIA3
+static void ref_zuc(const uint8_t key[32], const uint8_t nonce[5], const uint8_t *aad, size_t aad_len,
+                    const uint8_t *in, uint8_t *out, size_t len, uint8_t tag[4]) {
+    uint32_t count = ((uint32_t)nonce[0] << 24) | ((uint32_t)nonce[1] << 16) | ((uint32_t)nonce[2] << 8) | nonce[3];
+    uint8_t bearer = nonce[4] >> 3, direction = (nonce[4] >> 2) & 1;
+    uint8_t *m = malloc(aad_len + len + 1);
+
+    zuc_eea3(key, count, bearer, direction, in, out, (uint32_t)(len * 8));
+    memcpy(m, aad, aad_len);
+    memcpy(m + aad_len, out, len);
+    uint32_t mac = zuc_eia3(key + 16, count, bearer, direction, m, (uint32_t)((aad_len + len) * 8));
+    tag[0] = (uint8_t)(mac >> 24);
+    tag[1] = (uint8_t)(mac >> 16);
+    tag[2] = (uint8_t)(mac >> 8);
+    tag[3] = (uint8_t)mac;
+    free(m);
+}
+
+static const struct { sm_aead_alg alg; const char *name; } algs[] = {
+    {SM_AEAD_SM4_GCM,       "SM4-GCM"},
+    {SM_AEAD_SM4_CCM,       "SM4-CCM"},
+    {SM_AEAD_ZUC_EEA3_EIA3, "ZUC-EEA3+EIA3"},
+};
+
+static void reference(sm_aead_alg alg, const uint8_t *key, const sm_aead_msg *m, size_t tag_len,
+                      uint8_t *out, uint8_t *tag) {
+    switch (alg) {
+    case SM_AEAD_SM4_GCM:
+        ref_gcm(key, m->nonce, m->aad, m->aad_len, m->in, out, m->len, tag);
+        break;
+    case SM_AEAD_SM4_CCM:
+        ref_ccm(key, m->nonce, m->nonce_len, m->aad, m->aad_len, m->in, out, m->len, tag_len, tag);
+        break;
+    case SM_AEAD_ZUC_EEA3_EIA3:
+        ref_zuc(key, m->nonce, m->aad, m->aad_len, m->in, out, m->len, tag);
+        break;
+    }
+}
+
+// 随机消息：长度集中在小包，偶尔很长；ZUC 的 nonce 低 2 位清零
+#define NMSG 100
+#define MAXLEN 3000
+
+static void random_msgs(sm_aead_alg alg, sm_aead_msg *msgs, size_t n, uint8_t *plain, uint8_t (*nonces)[13],
+                        uint8_t *aads, uint8_t *outs, uint8_t (*tags)[16]) {
+    for (size_t i = 0; i < n; i++) {
+        size_t nl = alg == SM_AEAD_SM4_GCM ? 12 : alg == SM_AEAD_ZUC_EEA3_EIA3 ? 5 : 7 + (size_t)(rand() % 7);
+        for (size_t j = 0; j < 13; j++) nonces[i][j] = (uint8_t)rand();
+        if (alg == SM_AEAD_ZUC_EEA3_EIA3) nonces[i][4] &= 0xFC;
+        msgs[i].nonce = nonces[i];
+        msgs[i].nonce_len = nl;
+        msgs[i].aad = aads + 64 * i;
+        msgs[i].aad_len = rand() % 3 == 0 ? 0 : (size_t)(rand() % 65);
+        msgs[i].in = plain + MAXLEN * i;
+        msgs[i].out = outs + MAXLEN * i;
+        msgs[i].len = rand() % 6 == 0 ? (size_t)(rand() % MAXLEN) : (size_t)(rand() % 200);
+        // CCM L = 2 时长度不能超过 65535，这里总是满足
+        msgs[i].tag = tags[i];
+        msgs[i].status = 1;
+    }
+}
+
+int main() {
+    int failures = 0;
+
+    printf("--- Known answer (RFC 8998) ---\n");
+    int ok = kat(SM_AEAD_SM4_GCM, kat_gcm_cipher, kat_gcm_tag);
+    printf("SM4-GCM: %s\n", ok ? "PASS" : "FAIL");
+    failures += !ok;
+    ok = kat(SM_AEAD_SM4_CCM, kat_ccm_cipher, kat_ccm_tag);
+    printf("SM4-CCM: %s\n", ok ? "PASS" : "FAIL");
+    failures += !ok;
+
+    // 随机消息：单个 seal 与参照一致，批量 seal 与单个一致，批量 open 恢复原文，篡改被拒绝
+    printf("\n--- Random messages: reference / batch / open / tamper ---\n");
+    uint8_t *plain = malloc(NMSG * MAXLEN), *outs = malloc(NMSG * MAXLEN), *ref = malloc(MAXLEN);
+    uint8_t *batch_out = malloc(NMSG * MAXLEN), *aads = malloc(NMSG * 64);
+    uint8_t nonces[NMSG][13], tags[NMSG][16], batch_tags[NMSG][16], ref_tag[16];
+    sm_aead_msg msgs[NMSG], bmsgs[NMSG];
+    uint8_t key[32];
+    srand(2025);
+    for (size_t i = 0; i < NMSG * MAXLEN; i++) plain[i] = (uint8_t)rand();
+    for (size_t i = 0; i < NMSG * 64; i++) aads[i] = (uint8_t)rand();
+    for (size_t i = 0; i < sizeof(key); i++) key[i] = (uint8_t)rand();
+
+    for (size_t a = 0; a < sizeof(algs) / sizeof(algs[0]); a++) {
+        sm_aead_alg alg = algs[a].alg;
+        sm_aead_key k;
+        ok = 1;
+        for (int trial = 0; trial < 4; trial++) {
+            // GCM 标签 4/8/12~16 字节，CCM 4~16 的偶数，ZUC 固定 4
+            static const size_t gcm_tags[] = {16, 4, 8, 12, 13, 14, 15};
+            size_t tag_len = alg == SM_AEAD_ZUC_EEA3_EIA3 ? 4
+                           : alg == SM_AEAD_SM4_GCM ? gcm_tags[trial == 0 ? 0 : rand() % 7]
+                           : (size_t)(trial == 0 ? 16 : 4 + 2 * (rand() % 7));
+            ok &= sm_aead_key_init(&k, alg, key, tag_len) == 0;
+            random_msgs(alg, msgs, NMSG, plain, nonces, aads, outs, tags);
+
+            for (size_t i = 0; i < NMSG; i++) {
+                sm_aead_msg *m = &msgs[i];
+                ok &= sm_aead_seal(&k, m->nonce, m->nonce_len, m->aad, m->aad_len, m->in, m->out, m->len,
+                                   m->tag) == 0;
+                reference(alg, key, m, tag_len, ref, ref_tag);
+                ok &= memcmp(m->out, ref, m->len) == 0 && memcmp(m->tag, ref_tag, tag_len) == 0;
+            }
+
+            // 批量 seal
+            memcpy(bmsgs, msgs, sizeof(msgs));
+            for (size_t i = 0; i < NMSG; i++) {
+                bmsgs[i].out = batch_out + MAXLEN * i;
+                bmsgs[i].tag = batch_tags[i];
+            }
+            ok &= sm_aead_seal_batch(&k, bmsgs, NMSG) == 0;
+            for (size_t i = 0; i < NMSG; i++) {
+                ok &= memcmp(bmsgs[i].out, msgs[i].out, msgs[i].len) == 0 &&
+                      memcmp(bmsgs[i].tag, msgs[i].tag, tag_len) == 0;
+            }
+
+            // 批量原地 open，篡改其中几个 (标签、密文、AAD 各一种)
+            for (size_t i = 0; i < NMSG; i++) {
+                bmsgs[i].in = bmsgs[i].out;
+            }
+            bmsgs[3].tag[0] ^= 1;
+            if (bmsgs[10].len > 0) bmsgs[10].out[bmsgs[10].len - 1] ^= 0x80;
+            else bmsgs[10].tag[tag_len - 1] ^= 0x80;
+            bmsgs[50].aad_len++;
+            ok &= sm_aead_open_batch(&k, bmsgs, NMSG) == -1;
+            for (size_t i = 0; i < NMSG; i++) {
+                int bad = i == 3 || i == 10 || i == 50;
+                if (bad) {
+                    int zero = 1;
+                    for (size_t j = 0; j < bmsgs[i].len; j++) zero &= bmsgs[i].out[j] == 0;
+                    ok &= bmsgs[i].status == -1 && zero;
+                } else {
+                    ok &= bmsgs[i].status == 0 && memcmp(bmsgs[i].out, msgs[i].in, msgs[i].len) == 0;
+                }
+            }
+
+            // 单个 open
+            sm_aead_msg *m = &msgs[7];
+            ok &= sm_aead_open(&k, m->nonce, m->nonce_len, m->aad, m->aad_len, m->out, ref, m->len, m->tag) == 0 &&
+                  memcmp(ref, m->in, m->len) == 0;
+        }
+
+        // 参数检查：无效的批量不处理任何消息
+        uint8_t nonce13[13] = {0}, t[16];
+        ok &= sm_aead_seal(&k, nonce13, alg == SM_AEAD_SM4_CCM ? 6 : 13, NULL, 0, plain, outs, 16, t) == -1;
+        ok &= sm_aead_key_init(&k, alg, key, 3) == -1;
+        if (alg == SM_AEAD_SM4_CCM) {
+            // L = 2：最多 65535 字节
+            sm_aead_key_init(&k, alg, key, 16);
+            ok &= sm_aead_seal(&k, nonce13, 13, NULL, 0, plain, outs, 65536, t) == -1;
+            // AAD >= 0xFF00 时长度编码为 0xFFFE || 32 位长度
+            sm_aead_msg big = {nonce13, 13, plain, 0xFF05, plain, outs, 100, t, 0};
+            ok &= sm_aead_seal(&k, big.nonce, 13, big.aad, big.aad_len, big.in, big.out, big.len, t) == 0;
+            reference(alg, key, &big, 16, ref, ref_tag);
+            ok &= memcmp(outs, ref, 100) == 0 && memcmp(t, ref_tag, 16) == 0;
+        }
+        printf("%-14s: %s\n", algs[a].name, ok ? "PASS" : "FAIL");
+        failures += !ok;
+        sm_aead_key_clear(&k);
+    }
+
+    // --- 吞吐量：逐个 seal vs seal_batch ---
+    printf("\n--- Throughput: seal one by one vs seal_batch (64 messages per batch) ---\n");
+    const size_t sizes[] = {64, 256, 1500};
+    const size_t BATCH = 64;
+    for (size_t a = 0; a < sizeof(algs) / sizeof(algs[0]); a++) {
+        sm_aead_key k;
+        sm_aead_key_init(&k, algs[a].alg, key, 0);
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            size_t len = sizes[s];
+            for (size_t i = 0; i < BATCH; i++) {
+                msgs[i].nonce = nonces[i];
+                msgs[i].nonce_len = sm_aead_nonce_size(algs[a].alg);
+                nonces[i][4] &= 0xFC;
+                msgs[i].aad = aads;
+                msgs[i].aad_len = 16;
+                msgs[i].in = plain + MAXLEN * i;
+                msgs[i].out = outs + MAXLEN * i;
+                msgs[i].len = len;
+                msgs[i].tag = tags[i];
+            }
+            int iters = (int)(20000000 / (len * BATCH)) + 1;
+            double t0 = now_sec();
+            for (int it = 0; it < iters; it++) {
+                for (size_t i = 0; i < BATCH; i++) {
+                    sm_aead_msg *m = &msgs[i];
+                    sm_aead_seal(&k, m->nonce, m->nonce_len, m->aad, m->aad_len, m->in, m->out, m->len, m->tag);
+                }
+            }
+            double single = now_sec() - t0;
+            t0 = now_sec();
+            for (int it = 0; it < iters; it++) {
+                sm_aead_seal_batch(&k, msgs, BATCH);
+            }
+            double batch = now_sec() - t0;
+            double total = (double)iters * BATCH;
+            printf("%-14s %5zu B: single %6.3f M msg/s (%7.2f MB/s), batch %6.3f M msg/s (%7.2f MB/s)\n",
+                   algs[a].name, len, total / single / 1e6, total * len / single / 1e6,
+                   total / batch / 1e6, total * len / batch / 1e6);
+        }
+    }
+
+    free(plain);
+    free(outs);
+    free(ref);
+    free(batch_out);
+    free(aads);
+    return failures ? 1 : 0;
+}
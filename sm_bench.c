@@ -0,0 +1,649 @@
+// gcc -O3 -mavx2 -march=native -pthread sm3.c sm3_avx.c sm3_avx512.c sm3_hmac.c sm3_tree.c sm4.c sm4_avx.c zuc.c zuc_avx2.c zuc_avx512.c zuc_eea3.c zuc_eia3.c sm_cipher.c sm_aead.c sm_bench.c -o sm_bench
+// https://github.com/8891689
+// sm_bench.c
+//
+// 统一的基准测试程序：覆盖所有原语/模式，按消息长度 (16 B ~ 16 MiB) 和线程数扫描，
+// 报告 MB/s、cycles/byte 和单次调用延迟的分位数，输出表格、CSV 或 JSON，便于跨版本比较。
+//
+//   sm_bench [--list] [--filter sm4,zuc] [--sizes 16,1K,64K] [--threads 1,2,4] [--time 0.2]
+//            [--format table|csv|json] [--output FILE] [--no-pin]
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <x86intrin.h>
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#include "sm3.h"
+#include "sm3_avx.h"
+#include "sm3_hmac.h"
+#include "sm3_tree.h"
+#include "sm4.h"
+#include "sm4_avx.h"
+#include "zuc.h"
+#include "zuc_avx2.h"
+#include "zuc_eea3.h"
+#include "zuc_eia3.h"
+#include "sm_cipher.h"
+#include "sm_aead.h"
+
+// 16 通道内核：-march=native 时自动启用，分 ISA 构建时由 CMake 定义 SMCRYPTO_HAVE_AVX512
+#if defined(__AVX512F__) || defined(SMCRYPTO_HAVE_AVX512)
+#define BENCH_AVX512 1
+#include "sm3_avx512.h"
+#include "zuc_avx512.h"
+#endif
+
+#define MAX_LANES 16
+#define MAX_THREADS 256
+#define LAT_SAMPLES 2000        // 每个线程最多记录的单次调用延迟样本数
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+static inline uint64_t tsc_begin(void) {
+    _mm_lfence();
+    return __rdtsc();
+}
+
+static inline uint64_t tsc_end(void) {
+    unsigned aux;
+    uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+}
+
+// ===================== 各原语的运行环境 =====================
+
+typedef struct {
+    size_t size;                        // 每个消息的字节数
+    uint8_t *in, *out;                  // in：size 字节 (各通道共用)；out：lanes * size 字节
+    const uint8_t *ins[MAX_LANES];
+    uint8_t *outs[MAX_LANES];
+    size_t lens[MAX_LANES];
+    uint8_t key[32], iv[32], digest[MAX_LANES][32];
+    sm4_ctx sm4;
+    sm4_avx_ctx sm4_avx;
+    sm_cipher_ctx cipher;
+    zuc_ctx zuc;
+    sm3_hmac_key hk;
+    const sm3_hmac_key *hks[8];
+    sm_aead_key aead;
+    sm_aead_msg msgs[8];
+    uint8_t nonces[8][13], tags[8][16];
+    zuc_eea3_job eea3[8];
+    zuc_eia3_job eia3[8];
+    uint8_t keys[MAX_LANES][16], ivs[MAX_LANES][16];
+    zuc_state_8ch z8;
+#ifdef BENCH_AVX512
+    zuc_state_16ch z16;
+#endif
+} bench_env;
+
+typedef struct {
+    const char *name;
+    int lanes;              // 每次调用处理的消息数
+    int block;              // 消息长度向下取整到 block 的倍数 (SM4 分组模式为 16)
+    int need_avx512;
+    void (*setup)(bench_env *e);
+    void (*run)(bench_env *e);
+} bench_case;
+
+static void setup_none(bench_env *e) { (void)e; }
+
+// ---- SM3 ----
+static void run_sm3(bench_env *e) { sm3(e->in, e->size, e->digest[0]); }
+static void run_sm3_8x(bench_env *e) { sm3_8x(e->ins, e->lens, e->digest); }
+#ifdef BENCH_AVX512
+static void run_sm3_16x(bench_env *e) { sm3_16x(e->ins, e->lens, e->digest); }
+#endif
+static void setup_hmac(bench_env *e) {
+    sm3_hmac_key_init(&e->hk, e->key, 32);
+    for (int i = 0; i < 8; i++) e->hks[i] = &e->hk;
+}
+static void run_hmac(bench_env *e) { sm3_hmac(&e->hk, e->in, e->size, e->digest[0]); }
+static void run_hmac_8x(bench_env *e) { sm3_hmac_8x(e->hks, e->ins, e->lens, e->digest); }
+static void run_sm3_tree(bench_env *e) { sm3_tree(e->in, e->size, 1, e->digest[0]); }
+
+// ---- SM4 ----
+static void setup_sm4(bench_env *e) {
+    sm4_init_enc(&e->sm4, e->key);
+    sm4_avx_init(&e->sm4_avx, e->key, 1);
+}
+static void run_sm4(bench_env *e) {
+    for (size_t i = 0; i < e->size; i += 16) sm4_crypt_block(&e->sm4, e->in + i, e->out + i);
+}
+static void run_sm4_avx(bench_env *e) { sm4_avx_encrypt_blocks(&e->sm4_avx, e->in, e->out, e->size / 16); }
+
+static void run_cipher(bench_env *e, sm_cipher_alg alg, int enc) {
+    size_t n, fin;
+    sm_cipher_init(&e->cipher, alg, e->key, e->iv, enc);
+    sm_cipher_set_padding(&e->cipher, 0);
+    n = sm_cipher_update(&e->cipher, e->in, e->out, e->size);
+    sm_cipher_final(&e->cipher, e->out + n, &fin);
+}
+static void run_cbc_enc(bench_env *e) { run_cipher(e, SM_CIPHER_SM4_CBC, 1); }
+static void run_cbc_dec(bench_env *e) { run_cipher(e, SM_CIPHER_SM4_CBC, 0); }
+static void run_ctr(bench_env *e) { run_cipher(e, SM_CIPHER_SM4_CTR, 1); }
+
+// ---- ZUC ----
+static void run_zuc(bench_env *e) {
+    zuc_init(&e->zuc, e->key, e->iv);
+    zuc_xor(&e->zuc, e->in, e->out, e->size);
+}
+static void run_zuc256(bench_env *e) {
+    zuc256_init(&e->zuc, e->key, e->iv, 0);
+    zuc_xor(&e->zuc, e->in, e->out, e->size);
+}
+static void run_zuc_8ch(bench_env *e) {
+    zuc_init_8ch(&e->z8, (const uint8_t (*)[16])e->keys, (const uint8_t (*)[16])e->ivs);
+    zuc_xor_8ch_n(&e->z8, e->ins, e->outs, e->size);
+}
+#ifdef BENCH_AVX512
+// 16 通道只有密钥流接口：每次 zuc_generate_16ch_x16 每个通道 64 字节
+static void run_zuc_16ch(bench_env *e) {
+    uint32_t ks[16][16];
+    zuc_init_16ch(&e->z16, (const uint8_t (*)[16])e->keys, (const uint8_t (*)[16])e->ivs);
+    for (size_t i = 0; i < e->size; i += 64) zuc_generate_16ch_x16(&e->z16, ks);
+    memcpy(e->out, ks, sizeof(ks) < e->size ? sizeof(ks) : e->size);
+}
+#endif
+
+static void setup_3gpp(bench_env *e) {
+    for (int i = 0; i < 8; i++) {
+        e->eea3[i] = (zuc_eea3_job){e->keys[i], 0x12345678u + (uint32_t)i, (uint8_t)i, 1,
+                                    e->ins[i], e->outs[i], (uint32_t)(e->size * 8)};
+        e->eia3[i] = (zuc_eia3_job){e->keys[i], 0x12345678u + (uint32_t)i, (uint8_t)i, 1,
+                                    e->ins[i], (uint32_t)(e->size * 8), 0};
+    }
+}
+static void run_eea3(bench_env *e) {
+    zuc_eea3(e->key, 0x12345678u, 3, 1, e->in, e->out, (uint32_t)(e->size * 8));
+}
+static void run_eea3_8ch(bench_env *e) { zuc_eea3_8ch(e->eea3, 8); }
+static void run_eia3(bench_env *e) {
+    e->digest[0][0] = (uint8_t)zuc_eia3(e->key, 0x12345678u, 3, 1, e->in, (uint32_t)(e->size * 8));
+}
+static void run_eia3_8ch(bench_env *e) { zuc_eia3_8ch(e->eia3, 8); }
+
+// ---- AEAD (AAD 为空) ----
+static void setup_aead(bench_env *e, sm_aead_alg alg) {
+    // CCM 用 11 字节 nonce (长度字段 4 字节)，16 MiB 的消息也能表示
+    size_t nonce_len = alg == SM_AEAD_SM4_CCM ? 11 : sm_aead_nonce_size(alg);
+    sm_aead_key_init(&e->aead, alg, e->key, 0);
+    for (int i = 0; i < 8; i++) {
+        memset(e->nonces[i], 0, sizeof(e->nonces[i]));
+        e->nonces[i][0] = (uint8_t)i;
+        e->msgs[i] = (sm_aead_msg){e->nonces[i], nonce_len, NULL, 0, e->ins[i], e->outs[i], e->size, e->tags[i], 0};
+    }
+}
+static void setup_gcm(bench_env *e) { setup_aead(e, SM_AEAD_SM4_GCM); }
+static void setup_ccm(bench_env *e) { setup_aead(e, SM_AEAD_SM4_CCM); }
+static void setup_zuc_aead(bench_env *e) { setup_aead(e, SM_AEAD_ZUC_EEA3_EIA3); }
+static void run_seal(bench_env *e) { sm_aead_seal_batch(&e->aead, e->msgs, 1); }
+static void run_seal_8(bench_env *e) { sm_aead_seal_batch(&e->aead, e->msgs, 8); }
+
+static const bench_case cases[] = {
+    {"sm3",                1,  1, 0, setup_none,     run_sm3},
+    {"sm3-8x",             8,  1, 0, setup_none,     run_sm3_8x},
+#ifdef BENCH_AVX512
+    {"sm3-16x",            16, 1, 1, setup_none,     run_sm3_16x},
+#endif
+    {"sm3-hmac",           1,  1, 0, setup_hmac,     run_hmac},
+    {"sm3-hmac-8x",        8,  1, 0, setup_hmac,     run_hmac_8x},
+    {"sm3-tree",           1,  1, 0, setup_none,     run_sm3_tree},
+    {"sm4-ecb-scalar",     1, 16, 0, setup_sm4,      run_sm4},
+    {"sm4-ecb",            1, 16, 0, setup_sm4,      run_sm4_avx},
+    {"sm4-cbc-enc",        1, 16, 0, setup_none,     run_cbc_enc},
+    {"sm4-cbc-dec",        1, 16, 0, setup_none,     run_cbc_dec},
+    {"sm4-ctr",            1,  1, 0, setup_none,     run_ctr},
+    {"sm4-gcm-seal",       1,  1, 0, setup_gcm,      run_seal},
+    {"sm4-gcm-seal-x8",    8,  1, 0, setup_gcm,      run_seal_8},
+    {"sm4-ccm-seal",       1,  1, 0, setup_ccm,      run_seal},
+    {"sm4-ccm-seal-x8",    8,  1, 0, setup_ccm,      run_seal_8},
+    {"zuc-128",            1,  1, 0, setup_none,     run_zuc},
+    {"zuc-256",            1,  1, 0, setup_none,     run_zuc256},
+    {"zuc-8ch",            8,  1, 0, setup_none,     run_zuc_8ch},
+#ifdef BENCH_AVX512
+    {"zuc-16ch-keystream", 16, 64, 1, setup_none,    run_zuc_16ch},
+#endif
+    {"zuc-eea3",           1,  1, 0, setup_none,     run_eea3},
+    {"zuc-eea3-8ch",       8,  1, 0, setup_3gpp,     run_eea3_8ch},
+    {"zuc-eia3",           1,  1, 0, setup_none,     run_eia3},
+    {"zuc-eia3-8ch",       8,  1, 0, setup_3gpp,     run_eia3_8ch},
+    {"zuc-aead-seal",      1,  1, 0, setup_zuc_aead, run_seal},
+    {"zuc-aead-seal-x8",   8,  1, 0, setup_zuc_aead, run_seal_8},
+};
+#define NCASES (sizeof(cases) / sizeof(cases[0]))
+
+// ===================== 计数器 =====================
+
+static double tsc_hz;           // rdtsc 频率 (启动时对照 CLOCK_MONOTONIC 校准)
+static int use_perf;            // perf_event 可用时 cycles 为核心周期，否则为 TSC 周期 (挂钟时间)
+
+static void calibrate_tsc(void) {
+    double t0 = now_sec();
+    uint64_t c0 = __rdtsc();
+    while (now_sec() - t0 < 0.05) {
+    }
+    tsc_hz = (double)(__rdtsc() - c0) / (now_sec() - t0);
+}
+
+#ifdef __linux__
+static int perf_open_cycles(void) {
+    struct perf_event_attr pe;
+    memset(&pe, 0, sizeof(pe));
+    pe.type = PERF_TYPE_HARDWARE;
+    pe.size = sizeof(pe);
+    pe.config = PERF_COUNT_HW_CPU_CYCLES;
+    pe.disabled = 1;
+    pe.exclude_kernel = 1;
+    pe.exclude_hv = 1;
+    return (int)syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0);
+}
+
+static uint64_t perf_read(int fd) {
+    uint64_t v = 0;
+    if (read(fd, &v, sizeof(v)) != (ssize_t)sizeof(v)) return 0;
+    return v;
+}
+#endif
+
+// ===================== 工作线程 =====================
+
+typedef struct {
+    const bench_case *c;
+    size_t size;
+    int cpu;                    // 绑定的 CPU，-1 不绑定
+    double min_time;
+    pthread_barrier_t *barrier;
+    // 结果
+    int ok;
+    uint64_t iters, cycles;
+    double seconds;
+    uint64_t lat[LAT_SAMPLES];  // 单次调用的 TSC 周期
+    size_t nlat;
+} worker;
+
+static void *worker_main(void *arg) {
+    worker *w = arg;
+    const bench_case *c = w->c;
+    bench_env *e = aligned_alloc(64, (sizeof(bench_env) + 63) / 64 * 64);
+    size_t out_len = (size_t)c->lanes * w->size + 64;
+
+#ifdef __linux__
+    if (w->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(w->cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+
+    // 分配失败时这个点记为失败，但仍要走到两个 barrier，否则其他线程会一直等待
+    w->ok = e != NULL;
+    if (e) {
+        memset(e, 0, sizeof(*e));
+        e->size = w->size;
+        e->in = malloc(w->size + 64);
+        e->out = malloc(out_len);
+        w->ok = e->in != NULL && e->out != NULL;
+    }
+    if (w->ok) {
+        for (size_t i = 0; i < w->size; i++) e->in[i] = (uint8_t)(i * 131 + 7);
+        memset(e->out, 0, out_len);
+        for (int i = 0; i < 32; i++) e->key[i] = e->iv[i] = (uint8_t)(i * 17 + 1);
+        for (int l = 0; l < MAX_LANES; l++) {
+            e->ins[l] = e->in;
+            e->outs[l] = e->out + (l < c->lanes ? (size_t)l * w->size : 0);
+            e->lens[l] = w->size;
+            for (int i = 0; i < 16; i++) {
+                e->keys[l][i] = (uint8_t)(l * 16 + i);
+                e->ivs[l][i] = (uint8_t)(l + i * 3);
+            }
+        }
+        c->setup(e);
+        // 预热：至少一次，最多 20 ms
+        double t0 = now_sec();
+        for (int i = 0; i < 10 && (i == 0 || now_sec() - t0 < 0.02); i++) c->run(e);
+    }
+
+    // 吞吐量阶段：所有线程同时开始；每一轮调用 chunk 次再看时钟，避免小消息被 clock_gettime 拖慢
+    pthread_barrier_wait(w->barrier);
+    int fd = -1;
+#ifdef __linux__
+    if (use_perf) fd = perf_open_cycles();   // 失败时这个线程退回 TSC
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    uint64_t c0 = __rdtsc(), iters = 0, chunk = 1;
+    double t0 = now_sec(), el = 0;
+    while (w->ok) {
+        double r0 = now_sec();
+        for (uint64_t i = 0; i < chunk; i++) c->run(e);
+        iters += chunk;
+        double r1 = now_sec();
+        el = r1 - t0;
+        if (el >= w->min_time) break;
+        if (r1 - r0 < 0.001) chunk *= 2;
+    }
+    w->cycles = __rdtsc() - c0;
+#ifdef __linux__
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        w->cycles = perf_read(fd);
+        close(fd);
+    }
+#endif
+    w->iters = iters;
+    w->seconds = el;
+    pthread_barrier_wait(w->barrier);
+
+    // 延迟阶段：逐次计时，最多 LAT_SAMPLES 次或 min_time / 2 秒
+    w->nlat = 0;
+    t0 = now_sec();
+    while (w->ok && w->nlat < LAT_SAMPLES) {
+        uint64_t s = tsc_begin();
+        c->run(e);
+        w->lat[w->nlat++] = tsc_end() - s;
+        if ((w->nlat & 15) == 0 && now_sec() - t0 >= w->min_time / 2) break;
+    }
+
+    if (e) {
+        free(e->in);
+        free(e->out);
+        free(e);
+    }
+    return NULL;
+}
+
+// ===================== 结果 =====================
+
+typedef struct {
+    const char *name;
+    size_t size;
+    int threads, lanes;
+    uint64_t iters;
+    double seconds, mb_s, cycles_per_byte, p50_ns, p90_ns, p99_ns;
+} bench_result;
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static double percentile_ns(const uint64_t *v, size_t n, double p) {
+    if (n == 0) return 0;
+    size_t i = (size_t)(p * (double)(n - 1) + 0.5);
+    return (double)v[i] / tsc_hz * 1e9;
+}
+
+static int run_point(const bench_case *c, size_t size, int nthreads, const int *cpus, int ncpus,
+                     double min_time, bench_result *r) {
+    worker *w = calloc((size_t)nthreads, sizeof(worker));
+    pthread_t tid[MAX_THREADS];
+    pthread_barrier_t barrier;
+    int ok = 1;
+
+    memset(r, 0, sizeof(*r));
+    r->name = c->name;
+    r->size = size;
+    r->threads = nthreads;
+    r->lanes = c->lanes;
+    if (!w) return 0;
+
+    pthread_barrier_init(&barrier, NULL, (unsigned)nthreads);
+    for (int t = 0; t < nthreads; t++) {
+        w[t].c = c;
+        w[t].size = size;
+        w[t].cpu = ncpus > 0 ? cpus[t % ncpus] : -1;
+        w[t].min_time = min_time;
+        w[t].barrier = &barrier;
+        pthread_create(&tid[t], NULL, worker_main, &w[t]);
+    }
+    for (int t = 0; t < nthreads; t++) pthread_join(tid[t], NULL);
+    pthread_barrier_destroy(&barrier);
+
+    uint64_t iters = 0, cycles = 0, *lat = malloc(sizeof(uint64_t) * LAT_SAMPLES * (size_t)nthreads);
+    size_t nlat = 0;
+    double seconds = 0;
+    ok = lat != NULL;
+    for (int t = 0; t < nthreads; t++) {
+        ok &= w[t].ok;
+        iters += w[t].iters;
+        cycles += w[t].cycles;
+        if (w[t].seconds > seconds) seconds = w[t].seconds;
+        if (lat) {
+            memcpy(lat + nlat, w[t].lat, w[t].nlat * sizeof(uint64_t));
+            nlat += w[t].nlat;
+        }
+    }
+    if (lat) qsort(lat, nlat, sizeof(uint64_t), cmp_u64);
+
+    double bytes = (double)iters * (double)c->lanes * (double)size;
+    r->iters = iters;
+    r->seconds = seconds;
+    r->mb_s = seconds > 0 ? bytes / seconds / 1e6 : 0;
+    r->cycles_per_byte = bytes > 0 ? (double)cycles / bytes : 0;
+    r->p50_ns = percentile_ns(lat, nlat, 0.50);
+    r->p90_ns = percentile_ns(lat, nlat, 0.90);
+    r->p99_ns = percentile_ns(lat, nlat, 0.99);
+    free(lat);
+    free(w);
+    return ok;
+}
+
+static void cpu_model(char *buf, size_t len) {
+    snprintf(buf, len, "unknown");
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (!f) return;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "model name", 10) == 0) {
+            char *p = strchr(line, ':');
+            if (p) {
+                p += 1 + (p[1] == ' ');
+                p[strcspn(p, "\n")] = 0;
+                snprintf(buf, len, "%s", p);
+            }
+            break;
+        }
+    }
+    fclose(f);
+}
+
+// JSON 字符串中只会出现 CPU 型号这类可打印字符，转义引号和反斜杠即可
+static void json_str(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', out);
+        fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+// ===================== 命令行 =====================
+
+static size_t parse_size(const char *s) {
+    char *end;
+    double v = strtod(s, &end);
+    if (*end == 'K' || *end == 'k') v *= 1024;
+    else if (*end == 'M' || *end == 'm') v *= 1024 * 1024;
+    return (size_t)v;
+}
+
+// 逗号分隔的列表
+static int parse_list(const char *s, size_t *out, int max, int is_size) {
+    int n = 0;
+    while (*s && n < max) {
+        out[n++] = is_size ? parse_size(s) : (size_t)strtoul(s, NULL, 10);
+        s = strchr(s, ',');
+        if (!s) break;
+        s++;
+    }
+    return n;
+}
+
+static int case_selected(const bench_case *c, const char *filter) {
+    if (!filter) return 1;
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", filter);
+    for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+        if (strstr(c->name, tok)) return 1;
+    }
+    return 0;
+}
+
+static void usage(void) {
+    printf("usage: sm_bench [--list] [--filter a,b] [--sizes 16,1K,1M] [--threads 1,2]\n"
+           "                [--time SEC] [--format table|csv|json] [--output FILE] [--no-pin]\n"
+           "default sizes: 16 B .. 16 MiB in steps of 4x; default threads: 1; default time: 0.2 s per point\n");
+}
+
+int main(int argc, char **argv) {
+    size_t sizes[64], threads[64];
+    int nsizes = 0, nthreads = 1, pin = 1;
+    const char *filter = NULL, *format = "table", *output = NULL;
+    double min_time = 0.2;
+
+    threads[0] = 1;
+    for (size_t s = 16; s <= 16u << 20; s *= 4) sizes[nsizes++] = s;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i], *v = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(a, "--list") == 0) {
+            for (size_t k = 0; k < NCASES; k++) {
+                printf("%-20s %2d message(s) per call%s\n", cases[k].name, cases[k].lanes,
+                       cases[k].need_avx512 ? " (AVX-512)" : "");
+            }
+            return 0;
+        } else if (strcmp(a, "--no-pin") == 0) {
+            pin = 0;
+        } else if (v && strcmp(a, "--filter") == 0) {
+            filter = v, i++;
+        } else if (v && strcmp(a, "--sizes") == 0) {
+            nsizes = parse_list(v, sizes, 64, 1), i++;
+        } else if (v && strcmp(a, "--threads") == 0) {
+            nthreads = parse_list(v, threads, 64, 0), i++;
+        } else if (v && strcmp(a, "--time") == 0) {
+            min_time = atof(v), i++;
+        } else if (v && strcmp(a, "--format") == 0) {
+            format = v, i++;
+        } else if (v && strcmp(a, "--output") == 0) {
+            output = v, i++;
+        } else {
+            usage();
+            return strcmp(a, "--help") == 0 ? 0 : 2;
+        }
+    }
+    for (int i = 0; i < nthreads; i++) {
+        if (threads[i] < 1 || threads[i] > MAX_THREADS) {
+            fprintf(stderr, "thread count must be 1..%d\n", MAX_THREADS);
+            return 2;
+        }
+    }
+    int fmt = strcmp(format, "json") == 0 ? 2 : strcmp(format, "csv") == 0 ? 1 : 0;
+    FILE *out = output ? fopen(output, "w") : stdout;
+    if (!out) {
+        perror(output);
+        return 1;
+    }
+
+    // 可以使用的 CPU 列表，线程 t 绑定到第 t % ncpus 个
+    int cpus[1024], ncpus = 0;
+#ifdef __linux__
+    if (pin) {
+        cpu_set_t set;
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int i = 0; i < CPU_SETSIZE && ncpus < 1024; i++) {
+                if (CPU_ISSET(i, &set)) cpus[ncpus++] = i;
+            }
+        }
+    }
+#endif
+    __builtin_cpu_init();
+    int have_avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    calibrate_tsc();
+    char model[256];
+    cpu_model(model, sizeof(model));
+
+    // perf_event 是否可用 (容器/虚拟机里常被禁止)，表头/元数据里要写明 cycles 的来源
+#ifdef __linux__
+    int probe = perf_open_cycles();
+    if (probe >= 0) {
+        use_perf = 1;
+        close(probe);
+    }
+#endif
+    bench_result r;
+    const char *cycle_src = use_perf ? "perf-cpu-cycles" : "tsc";
+
+    if (fmt == 2) {
+        time_t now = time(NULL);
+        char stamp[32];
+        strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+        fprintf(out, "{\n  \"meta\": {\"cpu\": ");
+        json_str(out, model);
+        fprintf(out, ", \"tsc_ghz\": %.4f, \"cycle_source\": \"%s\", \"compiler\": ", tsc_hz / 1e9, cycle_src);
+        json_str(out, __VERSION__);
+        fprintf(out, ", \"timestamp\": \"%s\", \"min_time_s\": %g, \"pinned\": %s},\n  \"results\": [",
+                stamp, min_time, ncpus > 0 ? "true" : "false");
+    } else if (fmt == 1) {
+        fprintf(out, "primitive,size,threads,messages_per_call,iterations,seconds,mb_per_s,cycles_per_byte,"
+                     "lat_p50_ns,lat_p90_ns,lat_p99_ns\n");
+    } else {
+        fprintf(out, "# %s, TSC %.3f GHz, cycles: %s, %.2f s per point\n", model, tsc_hz / 1e9, cycle_src, min_time);
+        fprintf(out, "%-20s %10s %3s %10s %9s %12s %12s %12s\n",
+                "primitive", "size", "thr", "MB/s", "cyc/B", "p50 ns", "p90 ns", "p99 ns");
+    }
+
+    int first = 1, failures = 0;
+    for (size_t k = 0; k < NCASES; k++) {
+        const bench_case *c = &cases[k];
+        if (!case_selected(c, filter) || (c->need_avx512 && !have_avx512)) continue;
+        for (int s = 0; s < nsizes; s++) {
+            size_t size = sizes[s] / (size_t)c->block * (size_t)c->block;
+            if (size == 0) continue;
+            for (int t = 0; t < nthreads; t++) {
+                if (!run_point(c, size, (int)threads[t], cpus, ncpus, min_time, &r)) {
+                    fprintf(stderr, "%s: out of memory at %zu bytes\n", c->name, size);
+                    failures++;
+                    continue;
+                }
+                if (fmt == 2) {
+                    fprintf(out, "%s\n    {\"primitive\": \"%s\", \"size\": %zu, \"threads\": %d, "
+                                 "\"messages_per_call\": %d, \"iterations\": %llu, \"seconds\": %.6f, "
+                                 "\"mb_per_s\": %.3f, \"cycles_per_byte\": %.4f, "
+                                 "\"lat_p50_ns\": %.1f, \"lat_p90_ns\": %.1f, \"lat_p99_ns\": %.1f}",
+                            first ? "" : ",", r.name, r.size, r.threads, r.lanes, (unsigned long long)r.iters,
+                            r.seconds, r.mb_s, r.cycles_per_byte, r.p50_ns, r.p90_ns, r.p99_ns);
+                } else if (fmt == 1) {
+                    fprintf(out, "%s,%zu,%d,%d,%llu,%.6f,%.3f,%.4f,%.1f,%.1f,%.1f\n", r.name, r.size, r.threads,
+                            r.lanes, (unsigned long long)r.iters, r.seconds, r.mb_s, r.cycles_per_byte,
+                            r.p50_ns, r.p90_ns, r.p99_ns);
+                } else {
+                    fprintf(out, "%-20s %10zu %3d %10.2f %9.2f %12.1f %12.1f %12.1f\n", r.name, r.size,
+                            r.threads, r.mb_s, r.cycles_per_byte, r.p50_ns, r.p90_ns, r.p99_ns);
+                }
+                fflush(out);
+                first = 0;
+            }
+        }
+    }
+    if (fmt == 2) fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) fclose(out);
+    return failures ? 1 : 0;
+}
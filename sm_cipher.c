@@ -0,0 +1,243 @@
+// 作者：https://github.com/8891689
+// sm_cipher.c
+#include "sm_cipher.h"
+#include <string.h>
+
+// 一次交给 SM4 内核的最多分组数 (CTR 计数器块 / CBC 解密的临时输出)
+#define SM_CIPHER_CHUNK_BLOCKS 64
+
+size_t sm_cipher_key_size(sm_cipher_alg alg) {
+    return alg == SM_CIPHER_ZUC256 ? 32 : 16;
+}
+
+size_t sm_cipher_iv_size(sm_cipher_alg alg) {
+    switch (alg) {
+    case SM_CIPHER_SM4_ECB: return 0;
+    case SM_CIPHER_ZUC256:  return 23;
+    default:                return 16;
+    }
+}
+
+int sm_cipher_init(sm_cipher_ctx *ctx, sm_cipher_alg alg, const uint8_t *key, const uint8_t *iv, int enc) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->alg = alg;
+    ctx->enc = enc != 0;
+    ctx->padding = 1;
+
+    switch (alg) {
+    case SM_CIPHER_SM4_ECB:
+    case SM_CIPHER_SM4_CBC:
+        sm4_avx_init(&ctx->sm4, key, ctx->enc);
+        if (alg == SM_CIPHER_SM4_CBC) memcpy(ctx->iv, iv, 16);
+        return 0;
+    case SM_CIPHER_SM4_CTR:
+        // CTR 解密也是用加密方向生成密钥流
+        sm4_avx_init(&ctx->sm4, key, 1);
+        memcpy(ctx->iv, iv, 16);
+        return 0;
+    case SM_CIPHER_ZUC:
+        zuc_init(&ctx->zuc, key, iv);
+        return 0;
+    case SM_CIPHER_ZUC256:
+        zuc256_init(&ctx->zuc, key, iv, 0);
+        return 0;
+    }
+    return -1;
+}
+
+void sm_cipher_set_padding(sm_cipher_ctx *ctx, int padding) {
+    ctx->padding = padding != 0;
+}
+
+static inline void xor_block(uint8_t *out, const uint8_t *a, const uint8_t *b) {
+    uint64_t x[2], y[2];
+    memcpy(x, a, 16);
+    memcpy(y, b, 16);
+    x[0] ^= y[0];
+    x[1] ^= y[1];
+    memcpy(out, x, 16);
+}
+
+static void xor_bytes(uint8_t *out, const uint8_t *in, const uint8_t *ks, size_t len) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) xor_block(out + i, in + i, ks + i);
+    for (; i < len; i++) out[i] = in[i] ^ ks[i];
+}
+
+// 128 位大端计数器加 1
+static inline void ctr_inc(uint8_t ctr[16]) {
+    for (int i = 15; i >= 0; i--) {
+        if (++ctr[i] != 0) break;
+    }
+}
+
+// ===================== ECB / CBC =====================
+
+// nblocks 个整块直接从 in 写到 out
+static void sm4_blocks(sm_cipher_ctx *ctx, const uint8_t *in, uint8_t *out, size_t nblocks) {
+    if (ctx->alg == SM_CIPHER_SM4_ECB) {
+        sm4_avx_encrypt_blocks(&ctx->sm4, in, out, nblocks);
+    } else if (ctx->enc) {
+        // CBC 加密前后分组相互依赖，只能逐块
+        for (size_t i = 0; i < nblocks; i++) {
+            xor_block(ctx->iv, ctx->iv, in + 16 * i);
+            sm4_avx_encrypt_blocks(&ctx->sm4, ctx->iv, ctx->iv, 1);
+            memcpy(out + 16 * i, ctx->iv, 16);
+        }
+    } else {
+        // CBC 解密各分组独立：整段先用 8 分组内核解密到临时区，再与前一个密文异或
+        uint8_t tmp[SM_CIPHER_CHUNK_BLOCKS * 16];
+        while (nblocks > 0) {
+            size_t n = nblocks < SM_CIPHER_CHUNK_BLOCKS ? nblocks : SM_CIPHER_CHUNK_BLOCKS;
+            sm4_avx_encrypt_blocks(&ctx->sm4, in, tmp, n);
+            for (size_t i = 0; i < n; i++) {
+                uint8_t c[16];
+                memcpy(c, in + 16 * i, 16);     // in == out 时先取出密文
+                xor_block(out + 16 * i, tmp + 16 * i, ctx->iv);
+                memcpy(ctx->iv, c, 16);
+            }
+            in += 16 * n;
+            out += 16 * n;
+            nblocks -= n;
+        }
+        memset(tmp, 0, sizeof(tmp));
+    }
+}
+
+// 每次交给 sm4_blocks 的字节数：CBC 加密逐块，其余凑齐 8 块 (8 分组内核的宽度)
+static inline size_t block_group(const sm_cipher_ctx *ctx) {
+    return ctx->alg == SM_CIPHER_SM4_CBC && ctx->enc ? 16 : SM_CIPHER_BUF_SIZE;
+}
+
+static size_t block_update(sm_cipher_ctx *ctx, const uint8_t *in, uint8_t *out, size_t len) {
+    // 解密且有填充时，最后一个整块要留到 final 去掉填充
+    const int hold = !ctx->enc && ctx->padding;
+    const size_t group = block_group(ctx);
+    size_t written = 0;
+
+    if (ctx->buf_len > 0) {
+        size_t n = group - ctx->buf_len;
+        if (n > len) n = len;
+        memcpy(ctx->buf + ctx->buf_len, in, n);
+        ctx->buf_len += n;
+        in += n;
+        len -= n;
+        if (ctx->buf_len < group || (hold && len == 0)) return 0;
+        sm4_blocks(ctx, ctx->buf, out, group / 16);
+        ctx->buf_len = 0;
+        out += group;
+        written = group;
+    }
+
+    size_t ngroups = len / group;
+    size_t tail = len % group;
+    if (hold && tail == 0 && ngroups > 0) {
+        ngroups--;
+        tail = group;
+    }
+    sm4_blocks(ctx, in, out, ngroups * group / 16);
+    memcpy(ctx->buf, in + ngroups * group, tail);
+    ctx->buf_len = tail;
+    return written + ngroups * group;
+}
+
+static int block_final(sm_cipher_ctx *ctx, uint8_t *out, size_t *outlen) {
+    *outlen = 0;
+    if (!ctx->padding) {
+        if (ctx->buf_len % 16 != 0) return -1;
+        sm4_blocks(ctx, ctx->buf, out, ctx->buf_len / 16);
+        *outlen = ctx->buf_len;
+        return 0;
+    }
+    if (ctx->enc) {
+        uint8_t pad = (uint8_t)(16 - ctx->buf_len % 16);
+        memset(ctx->buf + ctx->buf_len, pad, pad);
+        sm4_blocks(ctx, ctx->buf, out, (ctx->buf_len + pad) / 16);
+        *outlen = ctx->buf_len + pad;
+        return 0;
+    }
+
+    if (ctx->buf_len == 0 || ctx->buf_len % 16 != 0) return -1;
+    size_t n = ctx->buf_len - 16;
+    uint8_t last[16];
+    sm4_blocks(ctx, ctx->buf, out, n / 16);
+    sm4_blocks(ctx, ctx->buf + n, last, 1);
+    uint8_t pad = last[15];
+    int bad = pad == 0 || pad > 16;
+    for (int i = 16 - (pad > 16 ? 16 : pad); i < 16; i++) bad |= last[i] != pad;
+    if (!bad) {
+        memcpy(out + n, last, 16 - pad);
+        *outlen = n + 16 - pad;
+    } else {
+        memset(out, 0, n);
+    }
+    memset(last, 0, sizeof(last));
+    return bad ? -1 : 0;
+}
+
+// ===================== CTR =====================
+
+static void ctr_update(sm_cipher_ctx *ctx, const uint8_t *in, uint8_t *out, size_t len) {
+    // 先用完上次剩余的密钥流
+    if (ctx->buf_len > 0) {
+        size_t n = ctx->buf_len < len ? ctx->buf_len : len;
+        xor_bytes(out, in, ctx->buf + SM_CIPHER_BUF_SIZE - ctx->buf_len, n);
+        ctx->buf_len -= n;
+        in += n;
+        out += n;
+        len -= n;
+    }
+
+    uint8_t ks[SM_CIPHER_CHUNK_BLOCKS * 16];
+    while (len > 0) {
+        // 按 8 块的倍数生成，多出的密钥流留给下一次调用
+        size_t nblocks = ((len + 127) / 128) * 8;
+        if (nblocks > SM_CIPHER_CHUNK_BLOCKS) nblocks = SM_CIPHER_CHUNK_BLOCKS;
+        for (size_t i = 0; i < nblocks; i++) {
+            memcpy(ks + 16 * i, ctx->iv, 16);
+            ctr_inc(ctx->iv);
+        }
+        sm4_avx_encrypt_blocks(&ctx->sm4, ks, ks, nblocks);
+
+        size_t n = nblocks * 16 < len ? nblocks * 16 : len;
+        xor_bytes(out, in, ks, n);
+        in += n;
+        out += n;
+        len -= n;
+        if (n < nblocks * 16) {
+            // 剩余的密钥流 (不足 8 块) 放在 buf 末尾
+            ctx->buf_len = nblocks * 16 - n;
+            memcpy(ctx->buf + SM_CIPHER_BUF_SIZE - ctx->buf_len, ks + n, ctx->buf_len);
+        }
+    }
+    memset(ks, 0, sizeof(ks));
+}
+
+// ===================== 公共接口 =====================
+
+size_t sm_cipher_update(sm_cipher_ctx *ctx, const uint8_t *in, uint8_t *out, size_t len) {
+    switch (ctx->alg) {
+    case SM_CIPHER_SM4_ECB:
+    case SM_CIPHER_SM4_CBC:
+        return block_update(ctx, in, out, len);
+    case SM_CIPHER_SM4_CTR:
+        ctr_update(ctx, in, out, len);
+        return len;
+    case SM_CIPHER_ZUC:
+    case SM_CIPHER_ZUC256:
+        zuc_xor(&ctx->zuc, in, out, len);
+        return len;
+    }
+    return 0;
+}
+
+int sm_cipher_final(sm_cipher_ctx *ctx, uint8_t *out, size_t *outlen) {
+    int ret = 0;
+
+    *outlen = 0;
+    if (ctx->alg == SM_CIPHER_SM4_ECB || ctx->alg == SM_CIPHER_SM4_CBC) {
+        ret = block_final(ctx, out, outlen);
+    }
+    memset(ctx, 0, sizeof(*ctx));
+    return ret;
+}
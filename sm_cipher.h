@@ -0,0 +1,79 @@
+// 作者：https://github.com/8891689
+// sm_cipher.h
+#ifndef SM_CIPHER_H
+#define SM_CIPHER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sm4_avx.h"
+#include "zuc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 统一的流式加解密接口：init / update / final，SM4 各模式和 ZUC 用同一套调用方式。
+ * 不完整的分组、未用完的密钥流都保存在上下文中，调用方可以按任意长度分块传入数据；
+ * 整块数据直接交给最宽的内核 (SM4 为 8 分组 AVX2，ZUC 为 zuc_xor 的展开循环)，不复制输入。
+ */
+typedef enum {
+    SM_CIPHER_SM4_ECB = 0,   // 按分组，可选 PKCS#7 填充
+    SM_CIPHER_SM4_CBC,       // IV 16 字节，可选 PKCS#7 填充
+    SM_CIPHER_SM4_CTR,       // 16 字节初始计数器，按 128 位大端整数递增
+    SM_CIPHER_ZUC,           // ZUC-128，密钥/IV 各 16 字节，密钥流字按大端字节序展开
+    SM_CIPHER_ZUC256,        // ZUC-256，密钥 32 字节，IV 23 字节 (见 zuc256_init)
+} sm_cipher_alg;
+
+// ECB/CBC 最多缓存 8 个分组，凑齐 8 块才交给 8 分组内核；CTR 的密钥流也按 8 块生成
+#define SM_CIPHER_BUF_SIZE 128
+
+typedef struct {
+    sm_cipher_alg alg;
+    int enc;
+    int padding;          // ECB/CBC：final 时添加/检查 PKCS#7 填充 (默认开启)
+    sm4_avx_ctx sm4;
+    zuc_ctx zuc;
+    uint8_t iv[16];       // CBC：上一个密文分组；CTR：下一个计数器
+    uint8_t buf[SM_CIPHER_BUF_SIZE];  // ECB/CBC：未凑满 8 块的输入；CTR：密钥流
+    size_t buf_len;       // ECB/CBC：buf 中的字节数；CTR：buf 末尾未用完的密钥流字节数
+} sm_cipher_ctx;
+
+/**
+ * @brief 算法的密钥/IV 长度 (字节)，ECB 的 IV 长度为 0
+ */
+size_t sm_cipher_key_size(sm_cipher_alg alg);
+size_t sm_cipher_iv_size(sm_cipher_alg alg);
+
+/**
+ * @brief 初始化；enc 非 0 为加密。ECB 时 iv 可以为 NULL
+ * @return 成功返回 0，未知算法返回 -1
+ */
+int sm_cipher_init(sm_cipher_ctx *ctx, sm_cipher_alg alg, const uint8_t *key, const uint8_t *iv, int enc);
+
+/**
+ * @brief ECB/CBC 是否使用 PKCS#7 填充 (在第一次 update 之前设置)
+ */
+void sm_cipher_set_padding(sm_cipher_ctx *ctx, int padding);
+
+/**
+ * @brief 处理 len 字节，返回写入 out 的字节数。
+ * CTR/ZUC 总是写出 len 字节；ECB/CBC 只写出整块 (凑齐 8 块才处理，CBC 加密除外)，
+ * out 需要 len + SM_CIPHER_BUF_SIZE 字节的空间。
+ * in 与 out 可以相同：CTR/ZUC 任意长度均可；ECB/CBC 要求关闭填充且每次 len 都是
+ * SM_CIPHER_BUF_SIZE 的倍数，否则输出位置会超前或落后于输入，必须使用不重叠的缓冲区。
+ */
+size_t sm_cipher_update(sm_cipher_ctx *ctx, const uint8_t *in, uint8_t *out, size_t len);
+
+/**
+ * @brief 结束：ECB/CBC 加密时写出最后的填充分组，解密时检查并去掉填充。
+ * 缓存的分组在这里写出，*outlen 为写入 out 的字节数 (不超过 SM_CIPHER_BUF_SIZE)。结束后上下文被清零。
+ * @return 成功返回 0；剩余数据不足一个分组 (无填充时) 或填充无效返回 -1
+ */
+int sm_cipher_final(sm_cipher_ctx *ctx, uint8_t *out, size_t *outlen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SM_CIPHER_H
@@ -0,0 +1,282 @@
+//  gcc -O3 -mavx2 -march=native zuc.c zuc_avx2.c zuc_eia3.c test_zuc256.c -o test_zuc256
+//  https://github.com/8891689
+// test_zuc256.c
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "zuc.h"
+#include "zuc_avx2.h"
+#include "zuc_eia3.h"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+static int hex_equal(const uint8_t *buf, const char *hex, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unsigned int b;
+        sscanf(hex + 2 * i, "%2x", &b);
+        if (buf[i] != (uint8_t)b) return 0;
+    }
+    return 1;
+}
+
+// 參考實現：按 ZUC-256 MAC 的定義逐比特異或 t 位密鑰流窗口
+static void zuc256_mac_bitwise(const uint8_t key[32], const uint8_t iv[23], const uint8_t *msg,
+                               uint32_t bitlen, int tag_bits, uint8_t *tag) {
+    int nt = tag_bits / 32;
+    size_t L = 2 * (size_t)nt + bitlen / 32 + 2;
+    uint32_t *z = malloc(L * sizeof(uint32_t));
+    uint32_t T[4];
+    zuc_ctx ctx;
+
+    zuc256_init(&ctx, key, iv, tag_bits);
+    zuc_keystream(&ctx, z, L);
+
+    #define KS_WINDOW(i) ((i) % 32 == 0 ? z[(i) / 32] : \
+        ((z[(i) / 32] << ((i) % 32)) | (z[(i) / 32 + 1] >> (32 - (i) % 32))))
+    for (int j = 0; j < nt; j++) T[j] = z[j];
+    for (uint32_t i = 0; i <= bitlen; i++) {
+        // i == bitlen 對應結尾窗口 W_L
+        if (i == bitlen || (msg[i / 8] & (0x80 >> (i % 8)))) {
+            for (int j = 0; j < nt; j++) T[j] ^= KS_WINDOW((size_t)tag_bits + i + 32 * j);
+        }
+    }
+    #undef KS_WINDOW
+
+    for (int j = 0; j < nt; j++) {
+        tag[4 * j] = (uint8_t)(T[j] >> 24);
+        tag[4 * j + 1] = (uint8_t)(T[j] >> 16);
+        tag[4 * j + 2] = (uint8_t)(T[j] >> 8);
+        tag[4 * j + 3] = (uint8_t)T[j];
+    }
+    free(z);
+}
+
+int main() {
+    int failures = 0;
+    uint8_t key[32], iv[23];
+
+    printf("--- ZUC-256 Keystream Test Vectors ---\n");
+    // ZUC-256 設計文檔的測試向量：全 0 密鑰/IV；全 1 密鑰/IV
+    static const char *ks_expected[2] = {
+        "58d03ad62e032ce2dafc683a39bdcb0352a2bc67f1b7de74163ce3a101ef5558"
+        "9639d75b95fa681b7f090df756391ccc903b7612744d544c17bc3fad8b163b08"
+        "21787c0b97775bb84943c6bbe8ad8afd",
+        "3356cbaed1a1c18b6baa4ffe343f777c9e15128f251ab65b949f7b26ef7157f2"
+        "96dd2fa9df95e3ee7a5be02ec32ba585505af316c2f9ded27cdbd935e441ce11"
+        "15fd0a80bb7aef6768989416b8fac8c2",
+    };
+    for (int t = 0; t < 2; t++) {
+        memset(key, t ? 0xFF : 0x00, sizeof(key));
+        memset(iv, t ? 0xFF : 0x00, sizeof(iv));
+
+        uint32_t ks[20];
+        uint8_t ks_bytes[80];
+        zuc_ctx ctx;
+        zuc256_init(&ctx, key, iv, 0);
+        zuc_keystream(&ctx, ks, 20);
+        for (int i = 0; i < 20; i++) {
+            ks_bytes[4 * i] = (uint8_t)(ks[i] >> 24);
+            ks_bytes[4 * i + 1] = (uint8_t)(ks[i] >> 16);
+            ks_bytes[4 * i + 2] = (uint8_t)(ks[i] >> 8);
+            ks_bytes[4 * i + 3] = (uint8_t)ks[i];
+        }
+        int ok = hex_equal(ks_bytes, ks_expected[t], 80);
+
+        // 8 通道：通道 5 使用測試向量，其餘通道使用其他密鑰
+        uint8_t keys8[8][32], ivs8[8][23];
+        for (int ch = 0; ch < 8; ch++) {
+            for (int i = 0; i < 32; i++) keys8[ch][i] = (uint8_t)(ch * 37 + i);
+            for (int i = 0; i < 23; i++) ivs8[ch][i] = (uint8_t)(ch * 11 + i * 3);
+        }
+        memcpy(keys8[5], key, 32);
+        memcpy(ivs8[5], iv, 23);
+        zuc_state_8ch st;
+        uint32_t words[20][8];
+        zuc256_init_8ch(&st, keys8, ivs8, 0);
+        for (int i = 0; i < 20; i++) {
+            zuc_generate_8ch(&st, words[i]);
+            if (words[i][5] != ks[i]) ok = 0;
+        }
+        // 其他通道與標量一致
+        for (int ch = 0; ch < 8; ch++) {
+            uint32_t ref[20];
+            zuc256_init(&ctx, keys8[ch], ivs8[ch], 0);
+            zuc_keystream(&ctx, ref, 20);
+            for (int i = 0; i < 20; i++) {
+                if (words[i][ch] != ref[i]) ok = 0;
+            }
+        }
+        zuc_clear_8ch(&st);
+        printf("Keystream vector %d (scalar + 8-channel): %s\n", t + 1, ok ? "PASS" : "FAIL");
+        failures += !ok;
+    }
+
+    printf("\n--- ZUC-256 MAC Test Vectors ---\n");
+    // 全 0 密鑰/IV：400 比特全 0 消息，4000 比特全 0x11 消息
+    static uint8_t zeros[50], ones[500];
+    memset(ones, 0x11, sizeof(ones));
+    static const struct {
+        uint32_t bitlen;
+        int tag_bits;
+        const char *tag;
+    } mac_vectors[] = {
+        {400, 32, "9b972a74"},
+        {400, 64, "673e54990034d38c"},
+        {400, 128, "d85e54bbcb9600967084c952a1654b26"},
+        {4000, 32, "8754f5cf"},
+        {4000, 64, "130dc225e72240cc"},
+        {4000, 128, "df1e8307b31cc62beca1ac6f8190c22f"},
+    };
+    memset(key, 0, sizeof(key));
+    memset(iv, 0, sizeof(iv));
+    for (size_t v = 0; v < sizeof(mac_vectors) / sizeof(mac_vectors[0]); v++) {
+        uint8_t tag[16], ref[16];
+        int nbytes = mac_vectors[v].tag_bits / 8;
+        const uint8_t *msg = mac_vectors[v].bitlen == 400 ? zeros : ones;
+        zuc256_mac(key, iv, msg, mac_vectors[v].bitlen, mac_vectors[v].tag_bits, tag);
+        zuc256_mac_bitwise(key, iv, msg, mac_vectors[v].bitlen, mac_vectors[v].tag_bits, ref);
+        zuc256_mac_job job = {key, iv, msg, mac_vectors[v].bitlen, {0}};
+        zuc256_mac_8ch(&job, 1, mac_vectors[v].tag_bits);
+        int ok = hex_equal(tag, mac_vectors[v].tag, nbytes) && memcmp(tag, ref, nbytes) == 0 &&
+                 memcmp(job.tag, tag, nbytes) == 0;
+        printf("MAC-%d, %u-bit message: %s\n", mac_vectors[v].tag_bits, mac_vectors[v].bitlen, ok ? "PASS" : "FAIL");
+        failures += !ok;
+    }
+
+    // 批量 / 單消息 vs 逐比特參考，隨機比特長度
+    const size_t NJOBS = 29;
+    zuc256_mac_job jobs[29];
+    uint8_t keys[29][32], ivs[29][23];
+    uint8_t *bufs[29];
+    srand(256);
+    for (size_t j = 0; j < NJOBS; j++) {
+        uint32_t bitlen = j < 10 ? (uint32_t)(j * 31) : (uint32_t)(rand() % 9000);
+        size_t nbytes = (bitlen + 7) / 8;
+        for (int i = 0; i < 32; i++) keys[j][i] = (uint8_t)rand();
+        for (int i = 0; i < 23; i++) ivs[j][i] = (uint8_t)rand();
+        bufs[j] = malloc(nbytes ? nbytes : 1);
+        for (size_t i = 0; i < nbytes; i++) bufs[j][i] = (uint8_t)rand();
+        jobs[j] = (zuc256_mac_job){keys[j], ivs[j], bufs[j], bitlen, {0}};
+    }
+    const int tag_sizes[3] = {32, 64, 128};
+    for (int t = 0; t < 3; t++) {
+        int tb = tag_sizes[t], ok = 1;
+        zuc256_mac_8ch(jobs, NJOBS, tb);
+        for (size_t j = 0; j < NJOBS; j++) {
+            uint8_t tag[16], ref[16];
+            zuc256_mac(keys[j], ivs[j], bufs[j], jobs[j].bitlen, tb, tag);
+            zuc256_mac_bitwise(keys[j], ivs[j], bufs[j], jobs[j].bitlen, tb, ref);
+            if (memcmp(tag, ref, tb / 8) != 0 || memcmp(jobs[j].tag, ref, tb / 8) != 0) ok = 0;
+        }
+        printf("MAC-%d single / 8-channel vs bit-serial (%zu messages): %s\n", tb, NJOBS, ok ? "PASS" : "FAIL");
+        failures += !ok;
+    }
+
+    // 不支持的標籤長度必須被拒絕，且不寫任何輸出
+    const int bad_tag_bits[] = {-32, 8, 48, 96, 160, 256};
+    int reject_ok = 1;
+    for (size_t b = 0; b < sizeof(bad_tag_bits) / sizeof(bad_tag_bits[0]); b++) {
+        int tb = bad_tag_bits[b];
+        uint8_t tag[32];
+        zuc_ctx bad_ctx;
+        zuc_state_8ch bad_st;
+        zuc256_mac_job job = {keys[0], ivs[0], zeros, 64, {0}};
+        memset(tag, 0xAA, sizeof(tag));
+        memset(job.tag, 0xAA, sizeof(job.tag));
+        if (zuc256_mac(keys[0], ivs[0], zeros, 64, tb, tag) != -1) reject_ok = 0;
+        if (zuc256_mac_8ch(&job, 1, tb) != -1) reject_ok = 0;
+        if (zuc256_init(&bad_ctx, keys[0], ivs[0], tb) != -1) reject_ok = 0;
+        if (zuc256_init_8ch(&bad_st, (const uint8_t (*)[32])keys, (const uint8_t (*)[23])ivs, tb) != -1) reject_ok = 0;
+        for (int i = 0; i < 16; i++) {
+            if (tag[i] != 0xAA || job.tag[i] != 0xAA) reject_ok = 0;
+        }
+    }
+    // MAC 接口不接受 0 (密鑰流模式)
+    uint8_t tag0[16];
+    if (zuc256_mac(keys[0], ivs[0], zeros, 64, 0, tag0) != -1) reject_ok = 0;
+    printf("Invalid tag_bits rejected: %s\n", reject_ok ? "PASS" : "FAIL");
+    failures += !reject_ok;
+    for (size_t j = 0; j < NJOBS; j++) free(bufs[j]);
+
+    // --- 吞吐量測試部分：ZUC-256 vs ZUC-128 ---
+    printf("\n--- Throughput: ZUC-256 vs ZUC-128 ---\n");
+    uint8_t keys8[8][32], ivs8[8][23], keys128[8][16], ivs128[8][16];
+    for (int ch = 0; ch < 8; ch++) {
+        for (int i = 0; i < 32; i++) keys8[ch][i] = (uint8_t)(ch + i * 5);
+        for (int i = 0; i < 23; i++) ivs8[ch][i] = (uint8_t)(ch * 3 + i);
+        memcpy(keys128[ch], keys8[ch], 16);
+        memcpy(ivs128[ch], ivs8[ch], 16);
+    }
+
+    const int INITS = 200000;
+    zuc_ctx ctx;
+    zuc_state_8ch st;
+    double t0 = now_sec();
+    for (int i = 0; i < INITS; i++) {
+        ivs128[0][0] = (uint8_t)i;
+        zuc_init(&ctx, keys128[0], ivs128[0]);
+    }
+    double el_i128 = now_sec() - t0;
+    t0 = now_sec();
+    for (int i = 0; i < INITS; i++) {
+        ivs8[0][0] = (uint8_t)i;
+        zuc256_init(&ctx, keys8[0], ivs8[0], 0);
+    }
+    double el_i256 = now_sec() - t0;
+    t0 = now_sec();
+    for (int i = 0; i < INITS / 8; i++) {
+        ivs128[0][0] = (uint8_t)i;
+        zuc_init_8ch(&st, keys128, ivs128);
+    }
+    double el_i128x8 = now_sec() - t0;
+    t0 = now_sec();
+    for (int i = 0; i < INITS / 8; i++) {
+        ivs8[0][0] = (uint8_t)i;
+        zuc256_init_8ch(&st, keys8, ivs8, 0);
+    }
+    double el_i256x8 = now_sec() - t0;
+    printf("Init, scalar     : ZUC-128 %10.0f/s   ZUC-256 %10.0f/s\n", INITS / el_i128, INITS / el_i256);
+    printf("Init, 8-channel  : ZUC-128 %10.0f/s   ZUC-256 %10.0f/s\n", INITS / el_i128x8, INITS / el_i256x8);
+
+    // 密鑰流：初始化之後兩者共用同一個步函數
+    const size_t WORDS = 1 << 22;
+    uint32_t *buf = malloc(WORDS * sizeof(uint32_t));
+    zuc256_init(&ctx, keys8[0], ivs8[0], 0);
+    t0 = now_sec();
+    zuc_keystream(&ctx, buf, WORDS);
+    double el_ks = now_sec() - t0;
+    printf("Keystream, scalar (shared step): %.2f Gbps\n", WORDS * 32.0 / el_ks / 1e9);
+    free(buf);
+
+    // MAC：1500 字節消息
+    const size_t MSGS = 20000, MSG_LEN = 1500;
+    uint8_t *data = malloc(MSGS * MSG_LEN);
+    zuc_eia3_job *e_jobs = malloc(MSGS * sizeof(zuc_eia3_job));
+    zuc256_mac_job *m_jobs = malloc(MSGS * sizeof(zuc256_mac_job));
+    for (size_t i = 0; i < MSGS * MSG_LEN; i++) data[i] = (uint8_t)(i * 29 + 3);
+    for (size_t j = 0; j < MSGS; j++) {
+        e_jobs[j] = (zuc_eia3_job){keys128[j & 7], (uint32_t)j, 1, 0, data + j * MSG_LEN, MSG_LEN * 8, 0};
+        m_jobs[j] = (zuc256_mac_job){keys8[j & 7], ivs8[j & 7], data + j * MSG_LEN, MSG_LEN * 8, {0}};
+    }
+    t0 = now_sec();
+    zuc_eia3_8ch(e_jobs, MSGS);
+    double el_eia3 = now_sec() - t0;
+    printf("MAC, 8-channel   : 128-EIA3     %6.2f Gbps\n", MSGS * MSG_LEN * 8.0 / el_eia3 / 1e9);
+    for (int t = 0; t < 3; t++) {
+        t0 = now_sec();
+        zuc256_mac_8ch(m_jobs, MSGS, tag_sizes[t]);
+        double el = now_sec() - t0;
+        printf("MAC, 8-channel   : ZUC-256/%-3d  %6.2f Gbps\n", tag_sizes[t], MSGS * MSG_LEN * 8.0 / el / 1e9);
+    }
+
+    free(data);
+    free(e_jobs);
+    free(m_jobs);
+    return failures ? 1 : 0;
+}
@@ -10,9 +10,9 @@
 // 定义吞吐量测试参数，与目标输出匹配
 #define WORDS_PER_LOGICAL_RUN 262144      // 每个“运行”生成的32位字数
 #define NUM_LOGICAL_RUNS 1000             // 总共进行多少个“运行”
-#define WORDS_PER_ZUC_GENERATE_CALL 8     // 每次 zuc_generate_8ch 调用生成8个字
+#define WORDS_PER_ZUC_GENERATE_CALL 8     // 每次 zuc_avx_generate_8ch 调用生成8个字
 
-// 计算总共需要调用 zuc_generate_8ch 多少次
+// 计算总共需要调用 zuc_avx_generate_8ch 多少次
 #define TOTAL_ZUC_GENERATE_CALLS (NUM_LOGICAL_RUNS * (WORDS_PER_LOGICAL_RUN / WORDS_PER_ZUC_GENERATE_CALL))
 
 
@@ -21,7 +21,7 @@ int main() {
     // 为了测试AVX2版本，我们将单个官方Key/IV复制到8个通道
     // 然后比较AVX2输出的第一个通道与官方预期值
 
-    zuc_state_8ch state_test_vectors; // 用于测试向量的状态
+    zuc_avx_state_8ch state_test_vectors; // 用于测试向量的状态
 
     // 官方测试向量 1 (全零 Key/IV)
     // 预期密钥流 (取自3GPP TS 35.221 V16.0.0 Annex A.2.1)
@@ -41,9 +41,9 @@ int main() {
     uint32_t current_8ch_output1[8];
     uint32_t generated_keystream_ch0_1[10]; // 足够存储10个字
 
-    zuc_init_8ch(&state_test_vectors, keys_ch1, ivs_ch1);
+    zuc_avx_init_8ch(&state_test_vectors, keys_ch1, ivs_ch1);
     for (int i = 0; i < 10; i++) { // 生成10个字，以便查看
-        zuc_generate_8ch(&state_test_vectors, current_8ch_output1);
+        zuc_avx_generate_8ch(&state_test_vectors, current_8ch_output1);
         generated_keystream_ch0_1[i] = current_8ch_output1[0]; // 取第一个通道的输出
     }
     printf("Test Vector 1 (All zeros):\n");
@@ -68,9 +68,9 @@ int main() {
     uint32_t current_8ch_output2[8];
     uint32_t generated_keystream_ch0_2[10];
 
-    zuc_init_8ch(&state_test_vectors, keys_ch2, ivs_ch2);
+    zuc_avx_init_8ch(&state_test_vectors, keys_ch2, ivs_ch2);
     for (int i = 0; i < 10; i++) {
-        zuc_generate_8ch(&state_test_vectors, current_8ch_output2);
+        zuc_avx_generate_8ch(&state_test_vectors, current_8ch_output2);
         generated_keystream_ch0_2[i] = current_8ch_output2[0];
     }
     printf("Test Vector 2 (All ones):\n");
@@ -95,16 +95,16 @@ int main() {
     uint32_t current_8ch_output3[8];
     uint32_t generated_keystream_ch0_3[10];
 
-    zuc_init_8ch(&state_test_vectors, keys_ch3, ivs_ch3);
+    zuc_avx_init_8ch(&state_test_vectors, keys_ch3, ivs_ch3);
     for (int i = 0; i < 10; i++) {
-        zuc_generate_8ch(&state_test_vectors, current_8ch_output3);
+        zuc_avx_generate_8ch(&state_test_vectors, current_8ch_output3);
         generated_keystream_ch0_3[i] = current_8ch_output3[0];
     }
     // Test Vector 3 的输出在目标格式中没有，这里暂时保持不打印，或者你可以选择打印
     // 为保持与你的目标输出一致，这里不打印Test Vector 3 的结果。
 
     // 清理测试向量状态
-    zuc_clear_8ch(&state_test_vectors);
+    zuc_avx_clear_8ch(&state_test_vectors);
 
 
     // --- 吞吐量测试部分 ---
@@ -134,8 +134,8 @@ int main() {
     };
     
     // 初始化8通道ZUC状态 (用于吞吐量测试)
-    zuc_state_8ch state_perf;
-    zuc_init_8ch(&state_perf, keys_perf, ivs_perf);
+    zuc_avx_state_8ch state_perf;
+    zuc_avx_init_8ch(&state_perf, keys_perf, ivs_perf);
     
     uint32_t output_perf[8]; // 用于接收密钥流输出
     
@@ -143,7 +143,7 @@ int main() {
     clock_t start = clock();
     
     for (int i = 0; i < TOTAL_ZUC_GENERATE_CALLS; i++) {
-        zuc_generate_8ch(&state_perf, output_perf); // 每次调用生成 8 个 32 位密钥流字
+        zuc_avx_generate_8ch(&state_perf, output_perf); // 每次调用生成 8 个 32 位密钥流字
     }
     
     clock_t end = clock();
@@ -168,8 +168,39 @@ int main() {
     printf("Throughput: %.2f MB/s (Megabytes per second)\n", throughput_mb_per_sec);
     printf("Throughput: %.2f Gbps (Gigabits per second)\n", throughput_gbps);
     
+    // S-Box 實現：逐通道查表與 vpshufb + AESENCLAST 的密鑰流一致，各自的吞吐量
+    printf("\n--- S-Box implementations ---\n");
+    const zuc_sbox_impl default_sbox = zuc_avx_get_sbox_8ch();
+    static uint32_t sbox_words[2][4096][8];
+    const zuc_sbox_impl impls[2] = {ZUC_SBOX_TABLE, ZUC_SBOX_SHUFFLE};
+    const char *names[2] = {"per-lane table", "vpshufb + AESENCLAST"};
+    int sbox_ok = 1;
+    for (int i = 0; i < 2; i++) {
+        if (zuc_avx_set_sbox_8ch(impls[i]) != 0) {
+            printf("%-22s: not supported\n", names[i]);
+            if (i == 0) sbox_ok = 0;
+            continue;
+        }
+        zuc_avx_init_8ch(&state_perf, keys_perf, ivs_perf);
+        for (int j = 0; j < 4096; j++) zuc_avx_generate_8ch(&state_perf, sbox_words[i][j]);
+        int same = i == 0 ? sbox_words[0][0][0] == 0x27BEDE74 :
+                   memcmp(sbox_words[0], sbox_words[1], sizeof(sbox_words[0])) == 0;
+        sbox_ok &= same;
+
+        start = clock();
+        for (int j = 0; j < TOTAL_ZUC_GENERATE_CALLS / 4; j++) {
+            zuc_avx_generate_8ch(&state_perf, output_perf);
+        }
+        end = clock();
+        elapsed = (double)(end - start) / CLOCKS_PER_SEC;
+        printf("%-22s: %s, %6.2f Gbps%s\n", names[i], same ? "PASS" : "FAIL",
+               (double)total_generated_bytes / 4 * 8.0 / (elapsed * 1000000000.0),
+               impls[i] == default_sbox ? " (default)" : "");
+    }
+    zuc_avx_set_sbox_8ch(default_sbox);
+
     // 清理吞吐量测试状态
-    zuc_clear_8ch(&state_perf);
+    zuc_avx_clear_8ch(&state_perf);
     
-    return 0;
+    return sbox_ok ? 0 : 1;
 }
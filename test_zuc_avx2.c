@@ -103,6 +103,115 @@ int main() {
     // Test Vector 3 的输出在目标格式中没有，这里暂时保持不打印，或者你可以选择打印
     // 为保持与你的目标输出一致，这里不打印Test Vector 3 的结果。
 
+    // 16 字批量接口与逐字接口一致 (含与单步调用交错、环形位置不为 0 的情况)
+    uint32_t single_words[40][8];
+    uint32_t batch_words[40][8];
+    zuc_init_8ch(&state_test_vectors, keys_ch3, ivs_ch3);
+    for (int i = 0; i < 40; i++) {
+        zuc_generate_8ch(&state_test_vectors, single_words[i]);
+    }
+    zuc_init_8ch(&state_test_vectors, keys_ch3, ivs_ch3);
+    zuc_generate_8ch_x16(&state_test_vectors, batch_words);
+    for (int i = 16; i < 19; i++) {
+        zuc_generate_8ch(&state_test_vectors, batch_words[i]);
+    }
+    zuc_generate_8ch_x16(&state_test_vectors, batch_words + 19);
+    for (int i = 35; i < 40; i++) {
+        zuc_generate_8ch(&state_test_vectors, batch_words[i]);
+    }
+    int x16_ok = memcmp(single_words, batch_words, sizeof(single_words)) == 0 &&
+                 generated_keystream_ch0_3[0] == single_words[0][0];
+    printf("zuc_generate_8ch_x16 vs zuc_generate_8ch: %s\n", x16_ok ? "PASS" : "FAIL");
+
+    // 按通道連續輸出：先單步 3 個字使環形位置不為 0，再生成 37 個字
+    uint32_t chan_words[8][40];
+    uint32_t *chan_out[8];
+    zuc_init_8ch(&state_test_vectors, keys_ch3, ivs_ch3);
+    for (int ch = 0; ch < 8; ch++) chan_out[ch] = chan_words[ch];
+    zuc_generate_8ch_n(&state_test_vectors, chan_out, 3);
+    for (int ch = 0; ch < 8; ch++) chan_out[ch] = chan_words[ch] + 3;
+    zuc_generate_8ch_n(&state_test_vectors, chan_out, 37);
+    int n_ok = 1;
+    for (int i = 0; i < 40; i++) {
+        for (int ch = 0; ch < 8; ch++) {
+            if (chan_words[ch][i] != single_words[i][ch]) n_ok = 0;
+        }
+    }
+    printf("zuc_generate_8ch_n (per-channel output) vs zuc_generate_8ch: %s\n", n_ok ? "PASS" : "FAIL");
+
+    // 8 個數據包直接異或 (大端字節序)，長度不是 4 的倍數；加密再解密恢復原文
+    uint8_t plain[8][150], cipher[8][150];
+    const uint8_t *xin[8];
+    uint8_t *xout[8];
+    for (int ch = 0; ch < 8; ch++) {
+        for (int i = 0; i < 150; i++) plain[ch][i] = (uint8_t)(ch * 31 + i);
+        xin[ch] = plain[ch];
+        xout[ch] = cipher[ch];
+    }
+    zuc_init_8ch(&state_test_vectors, keys_ch3, ivs_ch3);
+    zuc_xor_8ch_n(&state_test_vectors, xin, xout, 150);
+    int xor_ok = 1;
+    for (int ch = 0; ch < 8; ch++) {
+        for (int i = 0; i < 150; i++) {
+            uint8_t ks = (uint8_t)(single_words[i / 4][ch] >> (24 - 8 * (i % 4)));
+            if (cipher[ch][i] != (uint8_t)(plain[ch][i] ^ ks)) xor_ok = 0;
+        }
+        xin[ch] = cipher[ch];
+    }
+    zuc_init_8ch(&state_test_vectors, keys_ch3, ivs_ch3);
+    zuc_xor_8ch_n(&state_test_vectors, xin, xout, 150);
+    if (memcmp(cipher, plain, sizeof(plain)) != 0) xor_ok = 0;
+    printf("zuc_xor_8ch_n (8 packets, 150 bytes, in-place decrypt): %s\n", xor_ok ? "PASS" : "FAIL");
+
+    // 掩碼初始化：運行 7 步後只重新初始化通道 1、4、6 (換密鑰/IV)，
+    // 這些通道從頭輸出新密鑰流，其餘通道不受影響地繼續
+    uint8_t keys_re[8][16], ivs_re[8][16];
+    uint32_t fresh_words[20][8], mixed_words[20][8];
+    const uint8_t relanes = 0x52;
+    for (int ch = 0; ch < 8; ch++) {
+        memcpy(keys_re[ch], keys_ch3[ch], 16);
+        memcpy(ivs_re[ch], ivs_ch3[ch], 16);
+        keys_re[ch][0] ^= (uint8_t)(ch + 1);
+        ivs_re[ch][15] ^= (uint8_t)(ch * 7 + 1);
+    }
+    zuc_init_8ch(&state_test_vectors, keys_re, ivs_re);
+    for (int i = 0; i < 20; i++) zuc_generate_8ch(&state_test_vectors, fresh_words[i]);
+    zuc_init_8ch(&state_test_vectors, keys_ch3, ivs_ch3);
+    for (int i = 0; i < 7; i++) zuc_generate_8ch(&state_test_vectors, mixed_words[0]);
+    zuc_init_8ch_mask(&state_test_vectors, keys_re, ivs_re, relanes);
+    for (int i = 0; i < 20; i++) zuc_generate_8ch(&state_test_vectors, mixed_words[i]);
+    int mask_ok = 1;
+    for (int i = 0; i < 20; i++) {
+        for (int ch = 0; ch < 8; ch++) {
+            uint32_t want = (relanes >> ch) & 1 ? fresh_words[i][ch] : single_words[i + 7][ch];
+            if (mixed_words[i][ch] != want) mask_ok = 0;
+        }
+    }
+    printf("zuc_init_8ch_mask (re-init lanes 1,4,6 mid-stream): %s\n", mask_ok ? "PASS" : "FAIL");
+
+    // 批量初始化：3 個狀態 (兩個交錯初始化 + 一個單獨初始化) 與逐個 zuc_init_8ch 一致
+    static uint8_t keys_batch[24][16], ivs_batch[24][16];
+    static zuc_state_8ch batch_states[3];
+    for (int j = 0; j < 24; j++) {
+        for (int i = 0; i < 16; i++) {
+            keys_batch[j][i] = (uint8_t)(j * 37 + i * 11 + 5);
+            ivs_batch[j][i] = (uint8_t)(j * 53 + i * 29 + 7);
+        }
+    }
+    zuc_init_8ch_batch(batch_states, keys_batch, ivs_batch, 3);
+    int batch_ok = 1;
+    for (int j = 0; j < 3; j++) {
+        uint32_t wa[8], wb[8];
+        zuc_init_8ch(&state_test_vectors, keys_batch + 8 * j, ivs_batch + 8 * j);
+        for (int i = 0; i < 20; i++) {
+            zuc_generate_8ch(&batch_states[j], wa);
+            zuc_generate_8ch(&state_test_vectors, wb);
+            if (memcmp(wa, wb, sizeof(wa)) != 0) batch_ok = 0;
+        }
+        zuc_clear_8ch(&batch_states[j]);
+    }
+    printf("zuc_init_8ch_batch (3 states) vs zuc_init_8ch: %s\n", batch_ok ? "PASS" : "FAIL");
+
     // 清理测试向量状态
     zuc_clear_8ch(&state_test_vectors);
 
@@ -168,8 +277,92 @@ int main() {
     printf("Throughput: %.2f MB/s (Megabytes per second)\n", throughput_mb_per_sec);
     printf("Throughput: %.2f Gbps (Gigabits per second)\n", throughput_gbps);
     
+    // 16 字批量接口吞吐量
+    uint32_t output_x16[16][8];
+    zuc_init_8ch(&state_perf, keys_perf, ivs_perf);
+    start = clock();
+    for (int i = 0; i < TOTAL_ZUC_GENERATE_CALLS / 16; i++) {
+        zuc_generate_8ch_x16(&state_perf, output_x16);
+    }
+    end = clock();
+    elapsed = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("zuc_generate_8ch_x16 throughput: %.2f MB/s (%.2f Gbps)\n",
+           total_generated_mb_decimal / elapsed, (double)total_generated_bytes * 8.0 / (elapsed * 1000000000.0));
+
+    // 按通道連續輸出吞吐量 (每通道 4096 字一次調用)
+    static uint32_t chan_perf[8][4096];
+    for (int ch = 0; ch < 8; ch++) chan_out[ch] = chan_perf[ch];
+    zuc_init_8ch(&state_perf, keys_perf, ivs_perf);
+    start = clock();
+    for (int i = 0; i < TOTAL_ZUC_GENERATE_CALLS / 4096; i++) {
+        zuc_generate_8ch_n(&state_perf, chan_out, 4096);
+    }
+    end = clock();
+    elapsed = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("zuc_generate_8ch_n throughput: %.2f MB/s (%.2f Gbps)\n",
+           total_generated_mb_decimal / elapsed, (double)total_generated_bytes * 8.0 / (elapsed * 1000000000.0));
+
+    // S-Box 實現：三種實現的密鑰流逐字一致 (以逐通道查表為參照)，再分別測吞吐量
+    printf("\n--- S-Box implementations ---\n");
+    static const struct { zuc_sbox_impl impl; const char *name; } sboxes[] = {
+        {ZUC_SBOX_TABLE,   "per-lane table"},
+        {ZUC_SBOX_GATHER,  "vpgatherdd"},
+        {ZUC_SBOX_SHUFFLE, "vpshufb + AESENCLAST"},
+    };
+    const zuc_sbox_impl default_sbox = zuc_get_sbox_8ch();
+    static uint32_t sbox_ref[8][1000], sbox_out[8][1000];
+    int sbox_ok = 1;
+    for (size_t i = 0; i < sizeof(sboxes) / sizeof(sboxes[0]); i++) {
+        if (zuc_set_sbox_8ch(sboxes[i].impl) != 0) {
+            printf("%-22s: not supported\n", sboxes[i].name);
+            continue;
+        }
+        // 環形位置先錯開 5 步，覆蓋單步和 16 步兩種內核
+        for (int ch = 0; ch < 8; ch++) chan_out[ch] = sboxes[i].impl == ZUC_SBOX_TABLE ? sbox_ref[ch] : sbox_out[ch];
+        zuc_init_8ch(&state_perf, keys_perf, ivs_perf);
+        zuc_generate_8ch_n(&state_perf, chan_out, 5);
+        for (int ch = 0; ch < 8; ch++) chan_out[ch] += 5;
+        zuc_generate_8ch_n(&state_perf, chan_out, 995);
+        int same = sboxes[i].impl == ZUC_SBOX_TABLE ? sbox_ref[0][0] == 0x27BEDE74 :
+                   memcmp(sbox_ref, sbox_out, sizeof(sbox_ref)) == 0;
+        sbox_ok &= same;
+
+        zuc_init_8ch(&state_perf, keys_perf, ivs_perf);
+        start = clock();
+        for (int j = 0; j < TOTAL_ZUC_GENERATE_CALLS / 16; j++) {
+            zuc_generate_8ch_x16(&state_perf, output_x16);
+        }
+        end = clock();
+        elapsed = (double)(end - start) / CLOCKS_PER_SEC;
+        printf("%-22s: %s, %6.2f Gbps%s\n", sboxes[i].name, same ? "PASS" : "FAIL",
+               (double)total_generated_bytes * 8.0 / (elapsed * 1000000000.0),
+               sboxes[i].impl == default_sbox ? " (default)" : "");
+    }
+    zuc_set_sbox_8ch(default_sbox);
+
+    // 初始化吞吐量：短數據包的開銷主要在 32 輪初始化
+    printf("\n--- Init throughput (key/IV pairs per second) ---\n");
+    const int INIT_RUNS = 20000;
+    start = clock();
+    for (int r = 0; r < INIT_RUNS; r++) {
+        keys_batch[0][0] = (uint8_t)r;
+        for (int j = 0; j < 3; j++) zuc_init_8ch(&batch_states[j], keys_batch + 8 * j, ivs_batch + 8 * j);
+    }
+    end = clock();
+    elapsed = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("zuc_init_8ch       : %6.2f M inits/s\n", INIT_RUNS * 24.0 / elapsed / 1e6);
+    start = clock();
+    for (int r = 0; r < INIT_RUNS; r++) {
+        keys_batch[0][0] = (uint8_t)r;
+        zuc_init_8ch_batch(batch_states, keys_batch, ivs_batch, 3);
+    }
+    end = clock();
+    elapsed = (double)(end - start) / CLOCKS_PER_SEC;
+    printf("zuc_init_8ch_batch : %6.2f M inits/s\n", INIT_RUNS * 24.0 / elapsed / 1e6);
+    for (int j = 0; j < 3; j++) zuc_clear_8ch(&batch_states[j]);
+
     // 清理吞吐量测试状态
     zuc_clear_8ch(&state_perf);
     
-    return 0;
+    return (x16_ok && n_ok && xor_ok && mask_ok && batch_ok && sbox_ok) ? 0 : 1;
 }
@@ -0,0 +1,203 @@
+//  gcc -O3 -mavx2 -march=native zuc.c zuc_avx2.c zuc_eea3.c test_zuc_eea3.c -o test_zuc_eea3
+//  https://github.com/8891689
+// test_zuc_eea3.c
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "zuc_eea3.h"
+
+// 以空格分隔的十六進制串轉字節
+static size_t hex_to_bytes(const char *hex, uint8_t *out) {
+    size_t n = 0;
+    unsigned int b;
+    while (*hex) {
+        if (*hex == ' ') { hex++; continue; }
+        sscanf(hex, "%2x", &b);
+        out[n++] = (uint8_t)b;
+        hex += 2;
+    }
+    return n;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// 3GPP 128-EEA3 & 128-EIA3 Document 3: Implementor's Test Data，EEA3 測試集 1、2
+static const struct {
+    const char *key;
+    uint32_t count;
+    uint8_t bearer, direction;
+    uint32_t bitlen;
+    const char *plain, *cipher;
+} eea3_sets[] = {
+    {"173d14ba5003731d7a60049470f00a29", 0x66035492, 0x0f, 0, 193,
+     "6cf65340 735552ab 0c9752fa 6f9025fe 0bd675d9 005875b2 00000000",
+     "a6c85fc6 6afb8533 aafc2518 dfe78494 0ee1e4b0 30238cc8 00000000"},
+    {"e5bd3ea0eb55ade866c6ac58bd54302a", 0x00056823, 0x18, 1, 800,
+     "14a8ef69 3d678507 bbe7270a 7f67ff50 06c3525b 9807e467 c4e56000 ba338f5d 42955903 67518222"
+     "46c80d3b 38f07f4b e2d8ff58 05f51322 29bde93b bbdcaf38 2bf1ee97 2fbf9977 bada8945 847a2a6c"
+     "9ad34a66 7554e04d 1f7fa2c3 3241bd8f 01ba220d",
+     "131d43e0 dea1be5c 5a1bfd97 1d852cbf 712d7b4f 57961fea 3208afa8 bca433f4 56ad09c7 417e58bc"
+     "69cf8866 d1353f74 865e8078 1d202dfb 3ecff7fc bc3b190f e82a204e d0e350fc 0f6f2613 b2f2bca6"
+     "df5a473a 57a4a00d 985ebad8 80d6f238 64a07b01"},
+};
+
+int main() {
+    int failures = 0;
+    uint8_t key[16], plain[256], cipher[256], out[256];
+    const size_t nsets = sizeof(eea3_sets) / sizeof(eea3_sets[0]);
+
+    printf("--- 128-EEA3 Test Sets ---\n");
+    for (size_t t = 0; t < nsets; t++) {
+        hex_to_bytes(eea3_sets[t].key, key);
+        hex_to_bytes(eea3_sets[t].plain, plain);
+        hex_to_bytes(eea3_sets[t].cipher, cipher);
+        size_t nbytes = (eea3_sets[t].bitlen + 7) / 8;
+
+        zuc_eea3(key, eea3_sets[t].count, eea3_sets[t].bearer, eea3_sets[t].direction,
+                 plain, out, eea3_sets[t].bitlen);
+        int ok = memcmp(out, cipher, nbytes) == 0;
+
+        // 8 通道接口 (只有一個通道有數據包，其餘通道空閒)
+        zuc_eea3_job job = {key, eea3_sets[t].count, eea3_sets[t].bearer, eea3_sets[t].direction,
+                            plain, out, eea3_sets[t].bitlen};
+        memset(out, 0, sizeof(out));
+        zuc_eea3_8ch(&job, 1);
+        ok &= memcmp(out, cipher, nbytes) == 0;
+
+        printf("Test Set %zu (%u bits): %s\n", t + 1, eea3_sets[t].bitlen, ok ? "PASS" : "FAIL");
+        failures += !ok;
+    }
+
+    // 批量接口 vs 標量：數據包數量不是 8 的倍數，長度按比特隨機 (含 0 長度)，原地加密
+    const size_t NJOBS = 61;
+    zuc_eea3_job jobs[61];
+    uint8_t keys[61][16];
+    uint8_t *bufs[61], *refs[61];
+    srand(12345);
+    for (size_t j = 0; j < NJOBS; j++) {
+        uint32_t bitlen = (j % 13 == 0) ? 0 : (uint32_t)(rand() % 12000);
+        size_t nbytes = (bitlen + 7) / 8;
+        for (int i = 0; i < 16; i++) keys[j][i] = (uint8_t)rand();
+        bufs[j] = malloc(nbytes + 1);
+        refs[j] = malloc(nbytes + 1);
+        for (size_t i = 0; i < nbytes + 1; i++) bufs[j][i] = (uint8_t)rand();
+        jobs[j] = (zuc_eea3_job){keys[j], (uint32_t)rand(), (uint8_t)(j & 0x1F), (uint8_t)(j & 1),
+                                 bufs[j], bufs[j], bitlen};
+        zuc_eea3(keys[j], jobs[j].count, jobs[j].bearer, jobs[j].direction, bufs[j], refs[j], bitlen);
+        refs[j][nbytes] = bufs[j][nbytes];
+    }
+    zuc_eea3_8ch(jobs, NJOBS);
+    int batch_ok = 1;
+    for (size_t j = 0; j < NJOBS; j++) {
+        // 多比較一個字節：不得寫出數據包範圍
+        if (memcmp(bufs[j], refs[j], (jobs[j].bitlen + 7) / 8 + 1) != 0) batch_ok = 0;
+        free(bufs[j]);
+        free(refs[j]);
+    }
+    printf("zuc_eea3_8ch vs zuc_eea3 (%zu packets, bit lengths, lane reuse): %s\n",
+           NJOBS, batch_ok ? "PASS" : "FAIL");
+    failures += !batch_ok;
+
+    // 作業管理器：逐個提交，submit 中途返回的數據包與 flush 返回的合起來每個恰好一次
+    zuc_eea3_mgr mgr;
+    int seen[61] = {0};
+    int mgr_ok = 1;
+    srand(777);
+    for (size_t j = 0; j < NJOBS; j++) {
+        uint32_t bitlen = (j % 11 == 0) ? 0 : (uint32_t)(rand() % 6000);
+        size_t nbytes = (bitlen + 7) / 8;
+        bufs[j] = malloc(nbytes + 1);
+        refs[j] = malloc(nbytes + 1);
+        for (size_t i = 0; i < nbytes + 1; i++) bufs[j][i] = (uint8_t)rand();
+        jobs[j] = (zuc_eea3_job){keys[j], (uint32_t)rand(), (uint8_t)(j & 0x1F), (uint8_t)(j & 1),
+                                 bufs[j], bufs[j], bitlen};
+        zuc_eea3(keys[j], jobs[j].count, jobs[j].bearer, jobs[j].direction, bufs[j], refs[j], bitlen);
+        refs[j][nbytes] = bufs[j][nbytes];
+    }
+    zuc_eea3_mgr_init(&mgr);
+    const zuc_eea3_job *done;
+    for (size_t j = 0; j < NJOBS; j++) {
+        if ((done = zuc_eea3_submit(&mgr, &jobs[j])) != NULL) seen[done - jobs]++;
+    }
+    while ((done = zuc_eea3_flush(&mgr)) != NULL) seen[done - jobs]++;
+    for (size_t j = 0; j < NJOBS; j++) {
+        if (seen[j] != 1) mgr_ok = 0;
+        if (memcmp(bufs[j], refs[j], (jobs[j].bitlen + 7) / 8 + 1) != 0) mgr_ok = 0;
+        free(bufs[j]);
+        free(refs[j]);
+    }
+    printf("zuc_eea3_submit/flush vs zuc_eea3 (%zu packets, each returned once): %s\n",
+           NJOBS, mgr_ok ? "PASS" : "FAIL");
+    failures += !mgr_ok;
+
+    // --- 吞吐量測試部分：1500 字節數據包 ---
+    printf("\n--- Throughput: 1500-byte packets ---\n");
+    const size_t PKTS = 80000, PKT_LEN = 1500;
+    uint8_t *data = malloc(PKTS * PKT_LEN);
+    zuc_eea3_job *perf = malloc(PKTS * sizeof(zuc_eea3_job));
+    memset(data, 0x5A, PKTS * PKT_LEN);
+    for (size_t j = 0; j < PKTS; j++) {
+        perf[j] = (zuc_eea3_job){keys[j % NJOBS], (uint32_t)j, 3, 0,
+                                 data + j * PKT_LEN, data + j * PKT_LEN, PKT_LEN * 8};
+    }
+
+    double t0 = now_sec();
+    for (size_t j = 0; j < PKTS; j++) {
+        zuc_eea3(perf[j].key, perf[j].count, perf[j].bearer, perf[j].direction,
+                 perf[j].in, perf[j].out, perf[j].bitlen);
+    }
+    double el_scalar = now_sec() - t0;
+
+    t0 = now_sec();
+    zuc_eea3_8ch(perf, PKTS);
+    double el_batch = now_sec() - t0;
+
+    printf("zuc_eea3     : %10.0f packets/s, %6.2f Gbps\n", PKTS / el_scalar, PKTS * PKT_LEN * 8.0 / el_scalar / 1e9);
+    printf("zuc_eea3_8ch : %10.0f packets/s, %6.2f Gbps\n", PKTS / el_batch, PKTS * PKT_LEN * 8.0 / el_batch / 1e9);
+
+    // --- IMIX：40/576/1500 字節按 7:4:1 隨機混合 ---
+    printf("\n--- Throughput: IMIX (40/576/1500 bytes, 7:4:1) ---\n");
+    static const size_t imix_len[12] = {40, 40, 40, 40, 40, 40, 40, 576, 576, 576, 576, 1500};
+    const size_t IMIX_PKTS = 300000;
+    size_t total = 0;
+    zuc_eea3_job *imix = malloc(IMIX_PKTS * sizeof(zuc_eea3_job));
+    for (size_t j = 0; j < IMIX_PKTS; j++) {
+        size_t len = imix_len[rand() % 12];
+        imix[j] = (zuc_eea3_job){keys[j % NJOBS], (uint32_t)j, 3, 0,
+                                 data + (j % PKTS) * PKT_LEN, data + (j % PKTS) * PKT_LEN, (uint32_t)(len * 8)};
+        total += len;
+    }
+
+    t0 = now_sec();
+    for (size_t j = 0; j < IMIX_PKTS; j++) {
+        zuc_eea3(imix[j].key, imix[j].count, imix[j].bearer, imix[j].direction,
+                 imix[j].in, imix[j].out, imix[j].bitlen);
+    }
+    el_scalar = now_sec() - t0;
+
+    // 數據包逐個到達：提交一個、取回已完成的，最後 flush
+    size_t completed = 0;
+    t0 = now_sec();
+    zuc_eea3_mgr_init(&mgr);
+    for (size_t j = 0; j < IMIX_PKTS; j++) {
+        if (zuc_eea3_submit(&mgr, &imix[j])) completed++;
+    }
+    while (zuc_eea3_flush(&mgr)) completed++;
+    double el_mgr = now_sec() - t0;
+
+    printf("zuc_eea3        : %10.0f packets/s, %6.2f Gbps\n", IMIX_PKTS / el_scalar, total * 8.0 / el_scalar / 1e9);
+    printf("zuc_eea3_submit : %10.0f packets/s, %6.2f Gbps (%zu completed)\n",
+           IMIX_PKTS / el_mgr, total * 8.0 / el_mgr / 1e9, completed);
+    failures += completed != IMIX_PKTS;
+
+    free(imix);
+    free(data);
+    free(perf);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,237 @@
+//  gcc -O3 -mavx2 -march=native test_zuc_lfsr.c -o test_zuc_lfsr
+//  https://github.com/8891689
+// test_zuc_lfsr.c
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "zuc_lfsr.h"
+
+#define M31 0x7FFFFFFF
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+// ===================== 原來的寫法：逐項循環移位、逐項約簡 =====================
+#define ROTL31(x, n) ((((x) << (n)) | ((x) >> (31 - (n)))) & M31)
+
+static inline uint32_t mod_add31(uint32_t a, uint32_t b) {
+    uint32_t sum = a + b;
+    return (sum & M31) + (sum >> 31);
+}
+
+static inline uint32_t feedback_chain(uint32_t s0, uint32_t s4, uint32_t s10, uint32_t s13, uint32_t s15) {
+    uint32_t v = mod_add31(s0, ROTL31(s0, 8));
+    v = mod_add31(v, ROTL31(s4, 20));
+    v = mod_add31(v, ROTL31(s10, 21));
+    v = mod_add31(v, ROTL31(s13, 17));
+    return mod_add31(v, ROTL31(s15, 15));
+}
+
+static inline __m256i rotl31_avx2(__m256i x, uint32_t n) {
+    n %= 31;
+    const __m256i mask = _mm256_set1_epi32(0x7FFFFFFF);
+    x = _mm256_and_si256(x, mask);
+    __m256i left = _mm256_slli_epi32(x, n);
+    __m256i right = _mm256_srli_epi32(x, 31 - n);
+    return _mm256_and_si256(_mm256_or_si256(left, right), mask);
+}
+
+static inline __m256i mod_add31_avx2(__m256i a, __m256i b) {
+    __m256i sum = _mm256_add_epi32(a, b);
+    return _mm256_add_epi32(_mm256_and_si256(sum, _mm256_set1_epi32(0x7FFFFFFF)), _mm256_srli_epi32(sum, 31));
+}
+
+static inline __m256i feedback_chain_avx2(__m256i s0, __m256i s4, __m256i s10, __m256i s13, __m256i s15) {
+    __m256i v = mod_add31_avx2(s0, rotl31_avx2(s0, 8));
+    v = mod_add31_avx2(v, rotl31_avx2(s4, 20));
+    v = mod_add31_avx2(v, rotl31_avx2(s10, 21));
+    v = mod_add31_avx2(v, rotl31_avx2(s13, 17));
+    return mod_add31_avx2(v, rotl31_avx2(s15, 15));
+}
+
+#ifdef __AVX512F__
+static inline __m512i rotl31_16ch(__m512i x, const int n) {
+    return _mm512_ternarylogic_epi32(_mm512_slli_epi32(x, n), _mm512_srli_epi32(x, 31 - n),
+                                     _mm512_set1_epi32(M31), 0xA8);
+}
+
+static inline __m512i mod_add31_16ch(__m512i a, __m512i b) {
+    __m512i sum = _mm512_add_epi32(a, b);
+    return _mm512_and_si512(_mm512_add_epi32(sum, _mm512_srli_epi32(sum, 31)), _mm512_set1_epi32(M31));
+}
+
+static inline __m512i feedback_chain_16ch(__m512i s0, __m512i s4, __m512i s10, __m512i s13, __m512i s15) {
+    __m512i v = mod_add31_16ch(s0, rotl31_16ch(s0, 8));
+    v = mod_add31_16ch(v, rotl31_16ch(s4, 20));
+    v = mod_add31_16ch(v, rotl31_16ch(s10, 21));
+    v = mod_add31_16ch(v, rotl31_16ch(s13, 17));
+    return mod_add31_16ch(v, rotl31_16ch(s15, 15));
+}
+#endif
+
+// ===================== 只跑 LFSR 的遞推 (每步依賴上一步的輸出) =====================
+// s_i 位於 s[(k + i) & 15]，16 步展開使下標為編譯期常量
+#define LFSR_S(k, i) s[((k) + (i)) & 15]
+#define LFSR_STEP(k) LFSR_S(k, 0) = FB(LFSR_S(k, 0), LFSR_S(k, 4), LFSR_S(k, 10), LFSR_S(k, 13), LFSR_S(k, 15));
+#define LFSR_REPEAT16(R) R(0) R(1) R(2) R(3) R(4) R(5) R(6) R(7) \
+                         R(8) R(9) R(10) R(11) R(12) R(13) R(14) R(15)
+
+// 狀態複製到局部數組，16 步展開後可以全部留在寄存器裡 (否則測到的是存儲轉發延遲)
+#define DEFINE_LFSR_RUN(name, T, fb) \
+static void name(T state[16], size_t blocks) { \
+    T s[16]; \
+    memcpy(s, state, sizeof(s)); \
+    for (size_t b = 0; b < blocks; b++) { \
+        LFSR_REPEAT16(LFSR_STEP) \
+    } \
+    memcpy(state, s, sizeof(s)); \
+}
+
+#define FB feedback_chain
+DEFINE_LFSR_RUN(run_chain, uint32_t, FB)
+#undef FB
+#define FB zuc_lfsr_feedback
+DEFINE_LFSR_RUN(run_delayed, uint32_t, FB)
+#undef FB
+#define FB feedback_chain_avx2
+DEFINE_LFSR_RUN(run_chain_avx2, __m256i, FB)
+#undef FB
+#define FB zuc_lfsr_feedback_avx2
+DEFINE_LFSR_RUN(run_delayed_avx2, __m256i, FB)
+#undef FB
+#ifdef __AVX512F__
+#define FB feedback_chain_16ch
+DEFINE_LFSR_RUN(run_chain_16ch, __m512i, FB)
+#undef FB
+#define FB zuc_lfsr_feedback_16ch
+DEFINE_LFSR_RUN(run_delayed_16ch, __m512i, FB)
+#undef FB
+#endif
+
+static uint32_t rand31(void) {
+    return (((uint32_t)rand() << 16) ^ (uint32_t)rand()) & M31;
+}
+
+int main() {
+    int failures = 0;
+
+    // --- 正確性：隨機值與邊界值 (0、1、M31、2^30) 的所有組合 ---
+    static const uint32_t edge[] = {0, 1, M31, M31 - 1, 0x40000000, 0x3FFFFFFF};
+    const size_t NEDGE = sizeof(edge) / sizeof(edge[0]);
+    const size_t NRAND = 1 << 20;
+    uint32_t (*in)[5] = malloc((NRAND + 7776) * sizeof(*in));
+    size_t n = 0;
+    for (size_t a = 0; a < NEDGE; a++)
+        for (size_t b = 0; b < NEDGE; b++)
+            for (size_t c = 0; c < NEDGE; c++)
+                for (size_t d = 0; d < NEDGE; d++)
+                    for (size_t e = 0; e < NEDGE; e++) {
+                        in[n][0] = edge[a]; in[n][1] = edge[b]; in[n][2] = edge[c];
+                        in[n][3] = edge[d]; in[n][4] = edge[e];
+                        n++;
+                    }
+    srand(31);
+    for (size_t i = 0; i < NRAND; i++) {
+        for (int j = 0; j < 5; j++) in[n][j] = rand31();
+        n++;
+    }
+    while (n % 16) {   // 補齊到 16 的倍數，方便按向量分組
+        for (int j = 0; j < 5; j++) in[n][j] = 0;
+        n++;
+    }
+
+    int ok_scalar = 1, ok_avx2 = 1, ok_16ch = 1;
+    for (size_t i = 0; i < n; i++) {
+        if (zuc_lfsr_feedback(in[i][0], in[i][1], in[i][2], in[i][3], in[i][4]) !=
+            feedback_chain(in[i][0], in[i][1], in[i][2], in[i][3], in[i][4])) ok_scalar = 0;
+    }
+    for (size_t i = 0; i < n; i += 8) {
+        uint32_t col[5][8], got[8];
+        __m256i v[5];
+        for (int j = 0; j < 5; j++) {
+            for (int l = 0; l < 8; l++) col[j][l] = in[i + l][j];
+            v[j] = _mm256_loadu_si256((const __m256i*)col[j]);
+        }
+        _mm256_storeu_si256((__m256i*)got, zuc_lfsr_feedback_avx2(v[0], v[1], v[2], v[3], v[4]));
+        for (int l = 0; l < 8; l++) {
+            if (got[l] != feedback_chain(in[i + l][0], in[i + l][1], in[i + l][2], in[i + l][3], in[i + l][4])) ok_avx2 = 0;
+        }
+    }
+#ifdef __AVX512F__
+    for (size_t i = 0; i < n; i += 16) {
+        uint32_t col[5][16], got[16];
+        __m512i v[5];
+        for (int j = 0; j < 5; j++) {
+            for (int l = 0; l < 16; l++) col[j][l] = in[i + l][j];
+            v[j] = _mm512_loadu_si512(col[j]);
+        }
+        _mm512_storeu_si512(got, zuc_lfsr_feedback_16ch(v[0], v[1], v[2], v[3], v[4]));
+        for (int l = 0; l < 16; l++) {
+            if (got[l] != feedback_chain(in[i + l][0], in[i + l][1], in[i + l][2], in[i + l][3], in[i + l][4])) ok_16ch = 0;
+        }
+    }
+#endif
+    printf("--- Delayed-reduction LFSR feedback vs per-term mod_add31 chain (%zu inputs) ---\n", n);
+    printf("scalar  (64-bit accumulate) : %s\n", ok_scalar ? "PASS" : "FAIL");
+    printf("AVX2    (pairwise tree)     : %s\n", ok_avx2 ? "PASS" : "FAIL");
+#ifdef __AVX512F__
+    printf("AVX-512 (pairwise tree)     : %s\n", ok_16ch ? "PASS" : "FAIL");
+#endif
+    failures += !ok_scalar + !ok_avx2 + !ok_16ch;
+    free(in);
+
+    // --- 每步延遲：LFSR 單獨遞推，每步的 s15 是上一步的結果 ---
+    const size_t BLOCKS = 4000000;     // 6400 萬步
+    uint32_t s_ref[16], s[16], s_new[16];
+    for (int i = 0; i < 16; i++) s_ref[i] = rand31() | 1;
+    double t0, el_chain, el_delayed;
+
+    memcpy(s, s_ref, sizeof(s));
+    t0 = now_sec();
+    run_chain(s, BLOCKS);
+    el_chain = now_sec() - t0;
+    memcpy(s_new, s_ref, sizeof(s_new));
+    t0 = now_sec();
+    run_delayed(s_new, BLOCKS);
+    el_delayed = now_sec() - t0;
+    int same = memcmp(s, s_new, sizeof(s)) == 0;
+
+    printf("\n--- Per-step latency: LFSR-only recurrence, %zu steps ---\n", BLOCKS * 16);
+    printf("scalar  chain   : %6.3f ns/step\n", el_chain / (BLOCKS * 16.0) * 1e9);
+    printf("scalar  delayed : %6.3f ns/step (%.2fx)\n", el_delayed / (BLOCKS * 16.0) * 1e9, el_chain / el_delayed);
+
+    __m256i v[16], v_new[16];
+    for (int i = 0; i < 16; i++) v[i] = v_new[i] = _mm256_set1_epi32((int)s_ref[i]);
+    t0 = now_sec();
+    run_chain_avx2(v, BLOCKS);
+    el_chain = now_sec() - t0;
+    t0 = now_sec();
+    run_delayed_avx2(v_new, BLOCKS);
+    el_delayed = now_sec() - t0;
+    same &= memcmp(v, v_new, sizeof(v)) == 0 && (uint32_t)_mm256_extract_epi32(v[0], 3) == s[0];
+    printf("AVX2    chain   : %6.3f ns/step (8 lanes)\n", el_chain / (BLOCKS * 16.0) * 1e9);
+    printf("AVX2    delayed : %6.3f ns/step (%.2fx)\n", el_delayed / (BLOCKS * 16.0) * 1e9, el_chain / el_delayed);
+
+#ifdef __AVX512F__
+    __m512i w[16], w_new[16];
+    for (int i = 0; i < 16; i++) w[i] = w_new[i] = _mm512_set1_epi32((int)s_ref[i]);
+    t0 = now_sec();
+    run_chain_16ch(w, BLOCKS);
+    el_chain = now_sec() - t0;
+    t0 = now_sec();
+    run_delayed_16ch(w_new, BLOCKS);
+    el_delayed = now_sec() - t0;
+    same &= memcmp(w, w_new, sizeof(w)) == 0;
+    printf("AVX-512 chain   : %6.3f ns/step (16 lanes)\n", el_chain / (BLOCKS * 16.0) * 1e9);
+    printf("AVX-512 delayed : %6.3f ns/step (%.2fx)\n", el_delayed / (BLOCKS * 16.0) * 1e9, el_chain / el_delayed);
+#endif
+    printf("final LFSR state identical: %s\n", same ? "PASS" : "FAIL");
+    failures += !same;
+
+    return failures ? 1 : 0;
+}
@@ -1,14 +1,10 @@
 // https://github.com/8891689
 // zuc.c
 #include "zuc.h"
+#include "zuc_lfsr.h"
 #include <string.h>
 #include <stdint.h>
 
-/* 内部状态 */
-static uint32_t lfsr[16];   // 31-bit LFSR
-static uint32_t R1, R2;     // F函数寄存器
-static uint32_t X0, X1, X2, X3; // 位重组结果
-
 /* S-Box 和 D 常量  */
 
 static const uint8_t S0[256] =  {
@@ -55,144 +51,327 @@ static const uint16_t D[16] = {
     0x4D78, 0x2F13, 0x6BC4, 0x1AF1, 0x5E26, 0x3C4D, 0x789A, 0x47AC
 };
 
-/* 31-bit 循環左移 */
-static inline uint32_t rotl31(uint32_t x, int n) {
-    n %= 31;
-    return ((x << n) | (x >> (31 - n))) & 0x7FFFFFFF;
-}
-
+#define M31 0x7FFFFFFF
 
 /* 高性能但LFSR上下文中适用 */
 static inline uint32_t mod_add31(uint32_t a, uint32_t b) {
     uint32_t sum = a + b;
-    return (sum & 0x7FFFFFFF) + (sum >> 31);
+    return (sum & M31) + (sum >> 31);
+}
+
+/* 線性變換 L1 */
+static inline uint32_t L1(uint32_t x) {
+    return x ^ ((x << 2) | (x >> 30)) ^
+           ((x << 10) | (x >> 22)) ^
+           ((x << 18) | (x >> 14)) ^
+           ((x << 24) | (x >> 8));
+}
+
+/* 線性變換 L2 */
+static inline uint32_t L2(uint32_t x) {
+    return x ^ ((x << 8) | (x >> 24)) ^
+           ((x << 14) | (x >> 18)) ^
+           ((x << 22) | (x >> 10)) ^
+           ((x << 30) | (x >> 2));
+}
+
+static inline uint32_t sbox32(uint32_t x) {
+    return ((uint32_t)S0[x >> 24] << 24) |
+           ((uint32_t)S1[(x >> 16) & 0xFF] << 16) |
+           ((uint32_t)S0[(x >> 8) & 0xFF] << 8) |
+           ((uint32_t)S1[x & 0xFF]);
 }
 
-/* LFSR 初始化模式 - 修正嵌套問題 */
-static void lfsr_init_mode(uint32_t u) {
-    uint32_t v = 0;
+/*
+ * 一步 ZUC：位重組 + 非線性函數 F + LFSR。
+ * s_i 位于 s[((k) + (i)) & 15]；k 为编译期常量时所有下标在编译期确定 (16 步展开)。
+ * W 为 F 的输出 (未异或 X3)，Z 为密钥流字。
+ */
+#define ZUC_S(k, i) s[((k) + (i)) & 15]
 
-    v = mod_add31(v, rotl31(lfsr[15], 15));
-    v = mod_add31(v, rotl31(lfsr[13], 17));
-    v = mod_add31(v, rotl31(lfsr[10], 21));
-    v = mod_add31(v, rotl31(lfsr[4], 20));
-    v = mod_add31(v, rotl31(lfsr[0], 8));
-    v = mod_add31(v, lfsr[0]);
+#define ZUC_ROUND(k, W, Z) do { \
+    uint32_t x0_ = ((ZUC_S(k, 15) & 0x7FFF8000) << 1) | (ZUC_S(k, 14) & 0xFFFF); \
+    uint32_t x1_ = (ZUC_S(k, 11) << 16) | (ZUC_S(k, 9) >> 15); \
+    uint32_t x2_ = (ZUC_S(k, 7) << 16) | (ZUC_S(k, 5) >> 15); \
+    uint32_t x3_ = (ZUC_S(k, 2) << 16) | (ZUC_S(k, 0) >> 15); \
+    uint32_t w1_ = r1 + x1_; \
+    uint32_t w2_ = r2 ^ x2_; \
+    (W) = (x0_ ^ r1) + r2; \
+    (Z) = (W) ^ x3_; \
+    r1 = sbox32(L1((w1_ << 16) | (w2_ >> 16))); \
+    r2 = sbox32(L2((w2_ << 16) | (w1_ >> 16))); \
+} while (0)
 
-    v = mod_add31(v, u); 
+#define ZUC_LFSR_WORK(k) \
+    ZUC_S(k, 0) = zuc_lfsr_feedback(ZUC_S(k, 0), ZUC_S(k, 4), ZUC_S(k, 10), ZUC_S(k, 13), ZUC_S(k, 15))
 
-    if (v == 0) {
-        v = 0x7FFFFFFF;
-    }
+#define ZUC_LFSR_INIT(k, u) do { \
+    uint32_t v_ = mod_add31(zuc_lfsr_feedback(ZUC_S(k, 0), ZUC_S(k, 4), ZUC_S(k, 10), ZUC_S(k, 13), ZUC_S(k, 15)), (u)); \
+    ZUC_S(k, 0) = v_ ? v_ : M31; \
+} while (0)
+
+/* 工作模式一步，s_0 位于 s[k] (k 为变量，用于非 16 对齐的头尾) */
+#define ZUC_WORK_STEP(k, out) do { \
+    uint32_t w_, z_; \
+    ZUC_ROUND(k, w_, z_); \
+    (void)w_; \
+    ZUC_LFSR_WORK(k); \
+    (out) = z_; \
+} while (0)
+
+/* ZUC-256 的 D 常量 (7 位)：[0] 生成密钥流，[1]/[2]/[3] 分别用于 32/64/128 位 MAC */
+static const uint8_t D256[4][16] = {
+    {0x22,0x2F,0x24,0x2A,0x6D,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x52,0x10,0x30},
+    {0x22,0x2F,0x25,0x2A,0x6D,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x52,0x10,0x30},
+    {0x23,0x2F,0x24,0x2A,0x6D,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x52,0x10,0x30},
+    {0x23,0x2F,0x25,0x2A,0x6D,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x52,0x10,0x30}
+};
+
+#define ZUC256_U31(a, b, c, d) (((uint32_t)(a) << 23) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
 
-    for (int i = 0; i < 15; i++) {
-        lfsr[i] = lfsr[i+1];
+/* 32 轮初始化并丢弃第一个输出，s 为装载好的 LFSR */
+static void zuc_init_lfsr(zuc_ctx *ctx, uint32_t s[16]) {
+    uint32_t r1 = 0, r2 = 0;
+    uint32_t discard;
+
+    // 32輪初始化 (2 x 16 步，每轮结束后 s_0 回到 s[0])
+    for (int round = 0; round < 2; round++) {
+        for (int k = 0; k < 16; k++) {
+            uint32_t w, z;
+            ZUC_ROUND(k, w, z);
+            (void)z;
+            ZUC_LFSR_INIT(k, w >> 1);
+        }
     }
-    lfsr[15] = v;
+
+    // 丟棄第一個輸出
+    ZUC_WORK_STEP(0, discard);
+    (void)discard;
+
+    memcpy(ctx->lfsr, s, 16 * sizeof(uint32_t));
+    ctx->R1 = r1;
+    ctx->R2 = r2;
+    ctx->off = 1;
+    ctx->ks_word = 0;
+    ctx->ks_left = 0;
 }
 
-/* LFSR 工作模式 - 修正嵌套問題 */
-static void lfsr_work_mode() {
-    uint32_t v = 0;
-    v = mod_add31(v, rotl31(lfsr[15], 15));
-    v = mod_add31(v, rotl31(lfsr[13], 17));
-    v = mod_add31(v, rotl31(lfsr[10], 21));
-    v = mod_add31(v, rotl31(lfsr[4], 20));
-    v = mod_add31(v, rotl31(lfsr[0], 8));
-    v = mod_add31(v, lfsr[0]);
-
-    if (v == 0) {
-        v = 0x7FFFFFFF;
+/* 密鑰加載 */
+void zuc_init(zuc_ctx *ctx, const uint8_t key[16], const uint8_t iv[16]) {
+    uint32_t s[16];
+
+    for (int i = 0; i < 16; i++) {
+        s[i] = ((uint32_t)key[i] << 23) |
+               ((uint32_t)D[i] << 8) |
+               iv[i];
     }
+    zuc_init_lfsr(ctx, s);
+}
 
-    for (int i = 0; i < 15; i++) {
-        lfsr[i] = lfsr[i+1];
+/* tag_bits 对应的 D256 行，0 为密钥流，不支持的长度返回 -1 */
+static int zuc256_d_index(int tag_bits) {
+    switch (tag_bits) {
+    case 0:   return 0;
+    case 32:  return 1;
+    case 64:  return 2;
+    case 128: return 3;
+    default:  return -1;
     }
-    lfsr[15] = v;
 }
 
-/* 位重組 */
-static void bit_reorganize() {
-    // 使用移位操作確保正確的位位置
-    X0 = ((lfsr[15] >> 15) << 16) | (lfsr[14] & 0xFFFF);
-    X1 = ((lfsr[11] & 0xFFFF) << 16) | (lfsr[9] >> 15);
-    X2 = ((lfsr[7] & 0xFFFF) << 16) | (lfsr[5] >> 15);
-    X3 = ((lfsr[2] & 0xFFFF) << 16) | (lfsr[0] >> 15);
+/* ZUC-256 装载：每个 s_i 由 8 位 + 7 位 + 8 位 + 8 位拼成 */
+static void zuc256_load(const uint8_t key[32], const uint8_t iv[23], int d_index, uint32_t s[16]) {
+    const uint8_t *d = D256[d_index];
+    const uint8_t *k = key;
+
+    // IV 的后 8 个 6 位分量 iv17..iv24 依次打包在 iv[17..22]
+    uint8_t iv17 = iv[17] >> 2;
+    uint8_t iv18 = ((iv[17] & 0x3) << 4) | (iv[18] >> 4);
+    uint8_t iv19 = ((iv[18] & 0xF) << 2) | (iv[19] >> 6);
+    uint8_t iv20 = iv[19] & 0x3F;
+    uint8_t iv21 = iv[20] >> 2;
+    uint8_t iv22 = ((iv[20] & 0x3) << 4) | (iv[21] >> 4);
+    uint8_t iv23 = ((iv[21] & 0xF) << 2) | (iv[22] >> 6);
+    uint8_t iv24 = iv[22] & 0x3F;
+
+    s[0]  = ZUC256_U31(k[0], d[0], k[21], k[16]);
+    s[1]  = ZUC256_U31(k[1], d[1], k[22], k[17]);
+    s[2]  = ZUC256_U31(k[2], d[2], k[23], k[18]);
+    s[3]  = ZUC256_U31(k[3], d[3], k[24], k[19]);
+    s[4]  = ZUC256_U31(k[4], d[4], k[25], k[20]);
+    s[5]  = ZUC256_U31(iv[0], d[5] | iv17, k[5], k[26]);
+    s[6]  = ZUC256_U31(iv[1], d[6] | iv18, k[6], k[27]);
+    s[7]  = ZUC256_U31(iv[10], d[7] | iv19, k[7], iv[2]);
+    s[8]  = ZUC256_U31(k[8], d[8] | iv20, iv[3], iv[11]);
+    s[9]  = ZUC256_U31(k[9], d[9] | iv21, iv[12], iv[4]);
+    s[10] = ZUC256_U31(iv[5], d[10] | iv22, k[10], k[28]);
+    s[11] = ZUC256_U31(k[11], d[11] | iv23, iv[6], iv[13]);
+    s[12] = ZUC256_U31(k[12], d[12] | iv24, iv[7], iv[14]);
+    s[13] = ZUC256_U31(k[13], d[13], iv[15], iv[8]);
+    s[14] = ZUC256_U31(k[14], d[14] | (k[31] >> 4), iv[16], iv[9]);
+    s[15] = ZUC256_U31(k[15], d[15] | (k[31] & 0x0F), k[30], k[29]);
 }
 
-/* 線性變換 L1 */
-static uint32_t L1(uint32_t x) {
-    // 使用32位旋轉（非31位）
-    return x ^ ((x << 2) | (x >> 30)) ^ 
-           ((x << 10) | (x >> 22)) ^ 
-           ((x << 18) | (x >> 14)) ^ 
-           ((x << 24) | (x >> 8));
+int zuc256_init(zuc_ctx *ctx, const uint8_t key[32], const uint8_t iv[23], int tag_bits) {
+    uint32_t s[16];
+    int d_index = zuc256_d_index(tag_bits);
+
+    if (d_index < 0) return -1;
+    zuc256_load(key, iv, d_index, s);
+    zuc_init_lfsr(ctx, s);
+    return 0;
 }
 
-/* 線性變換 L2 */
-static uint32_t L2(uint32_t x) {
-    return x ^ ((x << 8) | (x >> 24)) ^ 
-           ((x << 14) | (x >> 18)) ^ 
-           ((x << 22) | (x >> 10)) ^ 
-           ((x << 30) | (x >> 2));
+/* PRGA */
+void zuc_keystream(zuc_ctx *ctx, uint32_t *out, size_t nwords) {
+    uint32_t s[16];
+    uint32_t r1 = ctx->R1, r2 = ctx->R2;
+    uint32_t off = ctx->off;
+
+    memcpy(s, ctx->lfsr, sizeof(s));
+
+    // 先单步走到 off == 0，之后每 16 步 s_0 又回到 s[0]，下标全部是常量
+    while (nwords > 0 && off != 0) {
+        ZUC_WORK_STEP(off, *out);
+        out++;
+        nwords--;
+        off = (off + 1) & 15;
+    }
+
+    while (nwords >= 16) {
+        ZUC_WORK_STEP(0, out[0]);
+        ZUC_WORK_STEP(1, out[1]);
+        ZUC_WORK_STEP(2, out[2]);
+        ZUC_WORK_STEP(3, out[3]);
+        ZUC_WORK_STEP(4, out[4]);
+        ZUC_WORK_STEP(5, out[5]);
+        ZUC_WORK_STEP(6, out[6]);
+        ZUC_WORK_STEP(7, out[7]);
+        ZUC_WORK_STEP(8, out[8]);
+        ZUC_WORK_STEP(9, out[9]);
+        ZUC_WORK_STEP(10, out[10]);
+        ZUC_WORK_STEP(11, out[11]);
+        ZUC_WORK_STEP(12, out[12]);
+        ZUC_WORK_STEP(13, out[13]);
+        ZUC_WORK_STEP(14, out[14]);
+        ZUC_WORK_STEP(15, out[15]);
+        out += 16;
+        nwords -= 16;
+    }
+
+    while (nwords > 0) {
+        ZUC_WORK_STEP(off, *out);
+        out++;
+        nwords--;
+        off = (off + 1) & 15;
+    }
+
+    memcpy(ctx->lfsr, s, sizeof(s));
+    ctx->R1 = r1;
+    ctx->R2 = r2;
+    ctx->off = off;
 }
 
-/* 非線性函數 F */
-static uint32_t F() {
-    uint32_t W = (X0 ^ R1) + R2;
-    uint32_t W1 = R1 + X1;
-    uint32_t W2 = R2 ^ X2;
-    
-    uint32_t u = (W1 << 16) | (W2 >> 16);
-    uint32_t v = (W2 << 16) | (W1 >> 16);
-    
-    u = L1(u);
-    v = L2(v);
-    
-    // 應用S盒（確保使用正確的S盒索引）
-    R1 = ((uint32_t)S0[u >> 24] << 24) |
-         ((uint32_t)S1[(u >> 16) & 0xFF] << 16) |
-         ((uint32_t)S0[(u >> 8) & 0xFF] << 8) |
-         ((uint32_t)S1[u & 0xFF]);
-    
-    R2 = ((uint32_t)S0[v >> 24] << 24) |
-         ((uint32_t)S1[(v >> 16) & 0xFF] << 16) |
-         ((uint32_t)S0[(v >> 8) & 0xFF] << 8) |
-         ((uint32_t)S1[v & 0xFF]);
-    
-    return W;
+/*
+ * 工作模式一步并把密钥流字按大端字节序异或进第 p 个字：直接在数据上做 32 位异或，
+ * 不经过中间密钥流缓冲区，也不逐字节移位
+ */
+#define ZUC_XOR_STEP(k, p) do { \
+    uint32_t ks_, d_; \
+    ZUC_WORK_STEP(k, ks_); \
+    memcpy(&d_, in + 4 * (p), 4); \
+    d_ ^= __builtin_bswap32(ks_); \
+    memcpy(out + 4 * (p), &d_, 4); \
+} while (0)
+
+/* 异或 nwords 个整字，结构与 zuc_keystream 相同 */
+static void zuc_xor_words(zuc_ctx *ctx, const uint8_t *in, uint8_t *out, size_t nwords) {
+    uint32_t s[16];
+    uint32_t r1 = ctx->R1, r2 = ctx->R2;
+    uint32_t off = ctx->off;
+
+    memcpy(s, ctx->lfsr, sizeof(s));
+
+    while (nwords > 0 && off != 0) {
+        ZUC_XOR_STEP(off, 0);
+        in += 4;
+        out += 4;
+        nwords--;
+        off = (off + 1) & 15;
+    }
+
+    while (nwords >= 16) {
+        ZUC_XOR_STEP(0, 0);
+        ZUC_XOR_STEP(1, 1);
+        ZUC_XOR_STEP(2, 2);
+        ZUC_XOR_STEP(3, 3);
+        ZUC_XOR_STEP(4, 4);
+        ZUC_XOR_STEP(5, 5);
+        ZUC_XOR_STEP(6, 6);
+        ZUC_XOR_STEP(7, 7);
+        ZUC_XOR_STEP(8, 8);
+        ZUC_XOR_STEP(9, 9);
+        ZUC_XOR_STEP(10, 10);
+        ZUC_XOR_STEP(11, 11);
+        ZUC_XOR_STEP(12, 12);
+        ZUC_XOR_STEP(13, 13);
+        ZUC_XOR_STEP(14, 14);
+        ZUC_XOR_STEP(15, 15);
+        in += 64;
+        out += 64;
+        nwords -= 16;
+    }
+
+    while (nwords > 0) {
+        ZUC_XOR_STEP(off, 0);
+        in += 4;
+        out += 4;
+        nwords--;
+        off = (off + 1) & 15;
+    }
+
+    memcpy(ctx->lfsr, s, sizeof(s));
+    ctx->R1 = r1;
+    ctx->R2 = r2;
+    ctx->off = off;
 }
 
-/* 密鑰加載 */
-void zuc_setup(const uint8_t key[16], const uint8_t iv[16]) {
-    for (int i = 0; i < 16; i++) {
-        lfsr[i] = ((uint32_t)key[i] << 23) | 
-                  ((uint32_t)D[i] << 8) | 
-                  iv[i];
+void zuc_xor(zuc_ctx *ctx, const uint8_t *in, uint8_t *out, size_t len) {
+    // 先用完上次剩余的密钥流字节
+    while (len > 0 && ctx->ks_left > 0) {
+        *out++ = *in++ ^ (uint8_t)(ctx->ks_word >> (8 * (ctx->ks_left - 1)));
+        ctx->ks_left--;
+        len--;
+    }
+
+    if (len >= 4) {
+        size_t nwords = len / 4;
+        zuc_xor_words(ctx, in, out, nwords);
+        in += nwords * 4;
+        out += nwords * 4;
+        len -= nwords * 4;
     }
-    
-    R1 = R2 = 0;
-    
-    // 32輪初始化
-    for (int i = 0; i < 32; i++) {
-        bit_reorganize();
-        uint32_t t = F();
-        lfsr_init_mode(t >> 1);
+
+    if (len > 0) {
+        zuc_keystream(ctx, &ctx->ks_word, 1);
+        ctx->ks_left = 4;
+        while (len > 0) {
+            *out++ = *in++ ^ (uint8_t)(ctx->ks_word >> (8 * (ctx->ks_left - 1)));
+            ctx->ks_left--;
+            len--;
+        }
     }
 }
 
-/* PRGA */
+/* 兼容旧接口 */
+static zuc_ctx legacy_ctx;
+
+void zuc_setup(const uint8_t key[16], const uint8_t iv[16]) {
+    zuc_init(&legacy_ctx, key, iv);
+}
+
 void zuc_prga(uint32_t *out, int len) {
-    // 丟棄第一個輸出
-    bit_reorganize();
-    F();
-    lfsr_work_mode();
-    
-    // 生成密鑰流
-    for (int i = 0; i < len; i++) {
-        bit_reorganize();
-        out[i] = F() ^ X3;
-        lfsr_work_mode();
+    if (len > 0) {
+        zuc_keystream(&legacy_ctx, out, (size_t)len);
     }
 }
-
@@ -4,11 +4,50 @@
 #define ZUC_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*
+ * 可重入的 ZUC 上下文。LFSR 以环形缓冲区保存：s_i 位于 lfsr[(off + i) & 15]，
+ * 每步只写回一个寄存器并移动 off，不再整体移位。每个流一个上下文，不同线程、
+ * 同一进程内交错的多个流互不影响。
+ */
+typedef struct {
+    uint32_t lfsr[16];
+    uint32_t R1, R2;
+    uint32_t off;        // s_0 在环形缓冲区中的位置
+    uint32_t ks_word;    // zuc_xor 未用完的密钥流字
+    uint32_t ks_left;    // ks_word 中剩余的字节数 (0..3)
+} zuc_ctx;
+
+/**
+ * @brief 载入密钥/IV，完成 32 轮初始化并丢弃第一个工作模式输出
+ */
+void zuc_init(zuc_ctx *ctx, const uint8_t key[16], const uint8_t iv[16]);
+
+/**
+ * @brief ZUC-256：256 位密钥、184 位 IV，其余流程与 ZUC-128 相同
+ * iv 为 23 字节：iv[0..16] 为 IV0..IV16，iv[17..22] 依次打包 8 个 6 位分量 IV17..IV24。
+ * tag_bits 为 0 时生成加密用密钥流，为 32/64/128 时使用对应长度 MAC 的 D 常量；
+ * 其他值返回 -1 且不修改 ctx，成功返回 0。
+ */
+int zuc256_init(zuc_ctx *ctx, const uint8_t key[32], const uint8_t iv[23], int tag_bits);
+
+/**
+ * @brief 生成 nwords 个 32 位密钥流字
+ */
+void zuc_keystream(zuc_ctx *ctx, uint32_t *out, size_t nwords);
+
+/**
+ * @brief 以密钥流 (每个字按大端字节序展开) 异或 len 字节；in 与 out 可以相同。
+ * 多次调用构成同一条字节流，不足一个字的剩余密钥流保存在上下文中。
+ */
+void zuc_xor(zuc_ctx *ctx, const uint8_t *in, uint8_t *out, size_t len);
+
+// 兼容旧接口：使用内部的全局上下文，不可重入
 void zuc_setup(const uint8_t key[16], const uint8_t iv[16]);
 void zuc_prga(uint32_t *out, int len);
 
@@ -17,4 +56,3 @@ void zuc_prga(uint32_t *out, int len);
 #endif
 
 #endif // ZUC_H
-
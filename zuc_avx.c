@@ -109,10 +109,10 @@ static inline __m256i L2_avx2(__m256i x) {
     return result;
 }
 
-// S盒處理函數
+// S盒處理函數 (逐通道查表)
 // 使用聯合體避免顯式的向量存儲和加載。
 // 這使得編譯器有機會將數據保留在寄存器中，減少內存訪問。
-static void process_sbox(__m256i u, __m256i v, __m256i* sbox_u, __m256i* sbox_v) {
+static void process_sbox_table(__m256i u, __m256i v, __m256i* sbox_u, __m256i* sbox_v) {
     avx2_vec_u32 u_union, v_union, sbox_u_union, sbox_v_union;
     
     u_union.v = u; // 將輸入向量賦值給聯合體
@@ -138,9 +138,49 @@ static void process_sbox(__m256i u, __m256i v, __m256i* sbox_u, __m256i* sbox_v)
     *sbox_v = sbox_v_union.v;
 }
 
+// 當前的 S-Box 實現：默認逐通道查表，運行的 CPU 有 AES-NI 時在加載時改為 vpshufb + AESENCLAST (zuc_sbox.h)
+static zuc_sbox_impl sbox_impl = ZUC_SBOX_TABLE;
+
+#ifdef ZUC_HAVE_SBOX_SHUFFLE
+// 以 -maes 編譯不代表運行的 CPU 支持 AES-NI，首次使用前檢查
+__attribute__((constructor)) static void zuc_avx_sbox_default(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("aes")) sbox_impl = ZUC_SBOX_SHUFFLE;
+}
+#endif
+
+// 本實現不提供 gather 版本 (見 zuc_avx2.c)
+int zuc_avx_set_sbox_8ch(zuc_sbox_impl impl) {
+    if (impl == ZUC_SBOX_SHUFFLE) {
+#ifdef ZUC_HAVE_SBOX_SHUFFLE
+        if (!__builtin_cpu_supports("aes")) return -1;
+#else
+        return -1;
+#endif
+    } else if (impl != ZUC_SBOX_TABLE) {
+        return -1;
+    }
+    sbox_impl = impl;
+    return 0;
+}
+
+zuc_sbox_impl zuc_avx_get_sbox_8ch(void) {
+    return sbox_impl;
+}
+
+static inline void process_sbox(__m256i u, __m256i v, __m256i* sbox_u, __m256i* sbox_v) {
+#ifdef ZUC_HAVE_SBOX_SHUFFLE
+    if (sbox_impl == ZUC_SBOX_SHUFFLE) {
+        zuc_sbox_shuffle_avx2(u, v, sbox_u, sbox_v);
+        return;
+    }
+#endif
+    process_sbox_table(u, v, sbox_u, sbox_v);
+}
+
 // 核心的ZUC一步計算（LFSR時鐘、F函數、R1/R2更新）
 // is_init_mode為1表示初始化模式（LFSR更新包含W>>>1），為0表示工作模式
-static inline void zuc_step_8ch(zuc_state_8ch* state, __m256i* W_out, __m256i* X3_out, int is_init_mode) {
+static inline void zuc_step_8ch(zuc_avx_state_8ch* state, __m256i* W_out, __m256i* X3_out, int is_init_mode) {
     // 位重組 (Bit Reorganization) 
     __m256i lfsr15 = state->lfsr[15];
     __m256i lfsr14 = state->lfsr[14];
@@ -214,7 +254,7 @@ static inline void zuc_step_8ch(zuc_state_8ch* state, __m256i* W_out, __m256i* X
 
 
 // 初始化8個ZUC實例
-void zuc_init_8ch(zuc_state_8ch* state, const uint8_t keys[8][16], const uint8_t ivs[8][16]) {
+void zuc_avx_init_8ch(zuc_avx_state_8ch* state, const uint8_t keys[8][16], const uint8_t ivs[8][16]) {
     memcpy(state->keys, keys, sizeof(state->keys));
     memcpy(state->ivs, ivs, sizeof(state->ivs));
     
@@ -244,7 +284,7 @@ void zuc_init_8ch(zuc_state_8ch* state, const uint8_t keys[8][16], const uint8_t
 }
 
 // 生成8通道密鑰流
-void zuc_generate_8ch(zuc_state_8ch* state, uint32_t output[8]) {
+void zuc_avx_generate_8ch(zuc_avx_state_8ch* state, uint32_t output[8]) {
 
     if (state->discard_initial_output == 0) {
         __m256i dummy_W, dummy_X3;
@@ -265,7 +305,7 @@ void zuc_generate_8ch(zuc_state_8ch* state, uint32_t output[8]) {
 }
 
 // 清理狀態 
-void zuc_clear_8ch(zuc_state_8ch* state) {
+void zuc_avx_clear_8ch(zuc_avx_state_8ch* state) {
     for (int i = 0; i < 16; i++) {
         state->lfsr[i] = _mm256_setzero_si256();
     }
@@ -1,34 +1,41 @@
 //作者：https://github.com/8891689
-#ifndef ZUC_AVX2_H
-#define ZUC_AVX2_H
+#ifndef ZUC_AVX_H
+#define ZUC_AVX_H
 
 #include <immintrin.h> 
 #include <stdint.h>    
+#include "zuc_sbox.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// ZUC 8通道狀態結構體
+// 接口與 zuc_avx2.h 對應，函數以 zuc_avx_ 為前綴，兩個版本可以鏈接進同一個 libsmcrypto
+
+// ZUC 8通道狀態結構體 (與 zuc_avx2.h 的 zuc_state_8ch 佈局不同，兩個頭文件可以同時包含)
 typedef struct {
     __m256i lfsr[16]; // 線性反饋移位寄存器，每個__m256i處理8個通道
     __m256i R1, R2;   // 非線性函數的狀態寄存器
     uint8_t keys[8][16]; // 8個通道的密鑰
     uint8_t ivs[8][16];  // 8個通道的初始化向量
     int discard_initial_output; 
-} zuc_state_8ch;
+} zuc_avx_state_8ch;
 
 // 初始化8個ZUC實例
-void zuc_init_8ch(zuc_state_8ch* state, const uint8_t keys[8][16], const uint8_t ivs[8][16]);
+void zuc_avx_init_8ch(zuc_avx_state_8ch* state, const uint8_t keys[8][16], const uint8_t ivs[8][16]);
 
 // 生成8通道密鑰流
-void zuc_generate_8ch(zuc_state_8ch* state, uint32_t output[8]);
+void zuc_avx_generate_8ch(zuc_avx_state_8ch* state, uint32_t output[8]);
+
+// 選擇 S-Box 實現 (ZUC_SBOX_TABLE 或 ZUC_SBOX_SHUFFLE)，不支持時返回 -1
+int zuc_avx_set_sbox_8ch(zuc_sbox_impl impl);
+zuc_sbox_impl zuc_avx_get_sbox_8ch(void);
 
 // 清理狀態
-void zuc_clear_8ch(zuc_state_8ch* state);
+void zuc_avx_clear_8ch(zuc_avx_state_8ch* state);
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif // ZUC_AVX2_H
+#endif // ZUC_AVX_H
@@ -1,6 +1,7 @@
 // 作者：https://github.com/8891689
 // zuc_avx2.c 
 #include "zuc_avx2.h"
+#include "zuc_lfsr.h"
 #include <string.h>
 #include <immintrin.h>
 
@@ -50,6 +51,14 @@ static const uint16_t D[16] = {
     0x4D78, 0x2F13, 0x6BC4, 0x1AF1, 0x5E26, 0x3C4D, 0x789A, 0x47AC
 };
 
+/* ZUC-256 的 D 常量 (7位值)：[0] 生成密鑰流，[1]/[2]/[3] 分別用於 32/64/128 位 MAC */
+static const uint8_t D256[4][16] = {
+    {0x22,0x2F,0x24,0x2A,0x6D,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x52,0x10,0x30},
+    {0x22,0x2F,0x25,0x2A,0x6D,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x52,0x10,0x30},
+    {0x23,0x2F,0x24,0x2A,0x6D,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x52,0x10,0x30},
+    {0x23,0x2F,0x25,0x2A,0x6D,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x52,0x10,0x30}
+};
+
 // ===================== 高性能 AVX2 S-Box 核心 =====================
 static uint32_t S0_32bit[256] __attribute__((aligned(32)));
 static uint32_t S1_32bit[256] __attribute__((aligned(32)));
@@ -100,20 +109,77 @@ static inline void process_sbox_avx2(__m256i u_in, __m256i v_in, __m256i* sbox_u
 }
 
 
+// 逐通道標量查表 (與 zuc_avx.c 原來的做法相同，用於對比和無 AVX2 gather 優勢的平台)
+static inline void process_sbox_table_8ch(__m256i u_in, __m256i v_in, __m256i* sbox_u_out, __m256i* sbox_v_out) {
+    uint32_t u[8] __attribute__((aligned(32))), v[8] __attribute__((aligned(32)));
+
+    _mm256_store_si256((__m256i*)u, u_in);
+    _mm256_store_si256((__m256i*)v, v_in);
+    for (int i = 0; i < 8; i++) {
+        u[i] = ((uint32_t)S0[u[i] >> 24] << 24) | ((uint32_t)S1[(u[i] >> 16) & 0xFF] << 16) |
+               ((uint32_t)S0[(u[i] >> 8) & 0xFF] << 8) | S1[u[i] & 0xFF];
+        v[i] = ((uint32_t)S0[v[i] >> 24] << 24) | ((uint32_t)S1[(v[i] >> 16) & 0xFF] << 16) |
+               ((uint32_t)S0[(v[i] >> 8) & 0xFF] << 8) | S1[v[i] & 0xFF];
+    }
+    *sbox_u_out = _mm256_load_si256((const __m256i*)u);
+    *sbox_v_out = _mm256_load_si256((const __m256i*)v);
+}
+
+// 當前的 S-Box 實現：默認 gather，運行的 CPU 有 AES-NI 時在加載時改為 vpshufb + AESENCLAST
+static zuc_sbox_impl zuc8_sbox = ZUC_SBOX_GATHER;
+
+#ifdef ZUC_HAVE_SBOX_SHUFFLE
+// 以 -maes 編譯不代表運行的 CPU 支持 AES-NI (libsmcrypto 按指令集分組編譯)，首次使用前檢查
+__attribute__((constructor)) static void zuc8_sbox_default(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("aes")) zuc8_sbox = ZUC_SBOX_SHUFFLE;
+}
+#endif
+
+int zuc_set_sbox_8ch(zuc_sbox_impl impl) {
+    switch (impl) {
+    case ZUC_SBOX_TABLE:
+    case ZUC_SBOX_GATHER:
+        break;
+    case ZUC_SBOX_SHUFFLE:
+#ifdef ZUC_HAVE_SBOX_SHUFFLE
+        if (!__builtin_cpu_supports("aes")) return -1;
+        break;
+#else
+        return -1;
+#endif
+    default:
+        return -1;
+    }
+    zuc8_sbox = impl;
+    return 0;
+}
+
+zuc_sbox_impl zuc_get_sbox_8ch(void) {
+    return zuc8_sbox;
+}
+
+// sbox 為編譯期常量 (各內核按實現分別展開)
+static inline __attribute__((always_inline))
+void zuc_sbox_8ch(__m256i u, __m256i v, __m256i* R1, __m256i* R2, zuc_sbox_impl sbox) {
+#ifdef ZUC_HAVE_SBOX_SHUFFLE
+    if (sbox == ZUC_SBOX_SHUFFLE) {
+        zuc_sbox_shuffle_avx2(u, v, R1, R2);
+        return;
+    }
+#endif
+    if (sbox == ZUC_SBOX_TABLE) {
+        process_sbox_table_8ch(u, v, R1, R2);
+    } else {
+        process_sbox_avx2(u, v, R1, R2);
+    }
+}
+
 // ===================== 輔助函數  =====================
 static inline __m256i rotl32_avx2(__m256i x, int n) {
     return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
 }
 
-static inline __m256i rotl31_avx2(__m256i x, uint32_t n) {
-    n %= 31;
-    const __m256i mask = _mm256_set1_epi32(0x7FFFFFFF);
-    x = _mm256_and_si256(x, mask);
-    __m256i left = _mm256_slli_epi32(x, n);
-    __m256i right = _mm256_srli_epi32(x, 31 - n);
-    return _mm256_and_si256(_mm256_or_si256(left, right), mask);
-}
-
 static inline __m256i mod_add31_avx2(__m256i a, __m256i b) {
     __m256i sum = _mm256_add_epi32(a, b);
     __m256i hi = _mm256_srli_epi32(sum, 31);
@@ -146,94 +212,435 @@ static inline __m256i L2_avx2(__m256i x) {
 }
 
 // ===================== 核心算法實現  =====================
-static void zuc_step_8ch(zuc_state_8ch* state, __m256i* W_out, __m256i* X3_out) {
-    // 位重組 (Bit Reorganization) 
-    __m256i X0 = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(state->lfsr[15], _mm256_set1_epi32(0x7FFF8000)), 1), _mm256_and_si256(state->lfsr[14], _mm256_set1_epi32(0xFFFF)));
-    __m256i X1 = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(state->lfsr[11], _mm256_set1_epi32(0xFFFF)), 16), _mm256_srli_epi32(state->lfsr[9], 15));
-    __m256i X2 = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(state->lfsr[7], _mm256_set1_epi32(0xFFFF)), 16), _mm256_srli_epi32(state->lfsr[5], 15));
-    __m256i X3_val = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(state->lfsr[2], _mm256_set1_epi32(0xFFFF)), 16), _mm256_srli_epi32(state->lfsr[0], 15));
-    
+// LFSR 以環形方式存放：s_i 位於 lfsr[(k + i) & 15]，k 為當前步在 16 步週期中的位置。
+// 每步只寫回被替換的那一個寄存器；k 為編譯期常量時所有下標在編譯期確定。
+#define ZUC8_S(s, k, i) (s)[((k) + (i)) & 15]
+
+static inline __attribute__((always_inline))
+__m256i zuc_round_8ch(__m256i *s, int k, __m256i *R1, __m256i *R2, int init_mode, zuc_sbox_impl sbox) {
+    const __m256i MASK_HI15 = _mm256_set1_epi32(0x7FFF8000);
+    const __m256i MASK_LO16 = _mm256_set1_epi32(0xFFFF);
+
+    // 位重組 (Bit Reorganization)
+    __m256i X0 = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(ZUC8_S(s, k, 15), MASK_HI15), 1), _mm256_and_si256(ZUC8_S(s, k, 14), MASK_LO16));
+    __m256i X1 = _mm256_or_si256(_mm256_slli_epi32(ZUC8_S(s, k, 11), 16), _mm256_srli_epi32(ZUC8_S(s, k, 9), 15));
+    __m256i X2 = _mm256_or_si256(_mm256_slli_epi32(ZUC8_S(s, k, 7), 16), _mm256_srli_epi32(ZUC8_S(s, k, 5), 15));
+    __m256i X3 = _mm256_or_si256(_mm256_slli_epi32(ZUC8_S(s, k, 2), 16), _mm256_srli_epi32(ZUC8_S(s, k, 0), 15));
+
     // F函數
-    __m256i W_val = _mm256_add_epi32(_mm256_xor_si256(X0, state->R1), state->R2);
-    __m256i W1 = _mm256_add_epi32(state->R1, X1);
-    __m256i W2 = _mm256_xor_si256(state->R2, X2);
-    __m256i u = _mm256_or_si256(_mm256_slli_epi32(W1, 16), _mm256_srli_epi32(W2, 16));
-    __m256i v = _mm256_or_si256(_mm256_slli_epi32(W2, 16), _mm256_srli_epi32(W1, 16));
-    u = L1_avx2(u);
-    v = L2_avx2(v);
-    
-    // 調用高性能 S-Box
-    process_sbox_avx2(u, v, &state->R1, &state->R2);
-    
-    // LFSR 更新 
-    __m256i v_sum = _mm256_setzero_si256(); 
-    v_sum = mod_add31_avx2(v_sum, rotl31_avx2(state->lfsr[15], 15));
-    v_sum = mod_add31_avx2(v_sum, rotl31_avx2(state->lfsr[13], 17));
-    v_sum = mod_add31_avx2(v_sum, rotl31_avx2(state->lfsr[10], 21));
-    v_sum = mod_add31_avx2(v_sum, rotl31_avx2(state->lfsr[4], 20));
-    v_sum = mod_add31_avx2(v_sum, rotl31_avx2(state->lfsr[0], 8));
-    v_sum = mod_add31_avx2(v_sum, state->lfsr[0]);
-    
-    if (state->is_init_mode) {
-        __m256i W_half = _mm256_srli_epi32(W_val, 1);
-        v_sum = mod_add31_avx2(v_sum, W_half);
-    }
-    
-    memmove(state->lfsr, state->lfsr + 1, 15 * sizeof(__m256i));
-    state->lfsr[15] = v_sum;
-
-    if (W_out) *W_out = W_val;
-    if (X3_out) *X3_out = X3_val;
+    __m256i W = _mm256_add_epi32(_mm256_xor_si256(X0, *R1), *R2);
+    __m256i W1 = _mm256_add_epi32(*R1, X1);
+    __m256i W2 = _mm256_xor_si256(*R2, X2);
+    __m256i u = L1_avx2(_mm256_or_si256(_mm256_slli_epi32(W1, 16), _mm256_srli_epi32(W2, 16)));
+    __m256i v = L2_avx2(_mm256_or_si256(_mm256_slli_epi32(W2, 16), _mm256_srli_epi32(W1, 16)));
+    zuc_sbox_8ch(u, v, R1, R2, sbox);
+
+    // LFSR 更新
+    __m256i v_sum = zuc_lfsr_feedback_avx2(ZUC8_S(s, k, 0), ZUC8_S(s, k, 4), ZUC8_S(s, k, 10),
+                                           ZUC8_S(s, k, 13), ZUC8_S(s, k, 15));
+    if (init_mode) {
+        v_sum = mod_add31_avx2(v_sum, _mm256_srli_epi32(W, 1));
+    }
+    ZUC8_S(s, k, 0) = v_sum;
+
+    return _mm256_xor_si256(W, X3);
 }
 
-// 初始化8個ZUC實例
-void zuc_init_8ch(zuc_state_8ch* state, const uint8_t keys[8][16], const uint8_t ivs[8][16]) {
-    // S-Box數據一次性初始化
+#define ZUC8_REPEAT16(R) R(0) R(1) R(2) R(3) R(4) R(5) R(6) R(7) \
+                         R(8) R(9) R(10) R(11) R(12) R(13) R(14) R(15)
+
+// 按當前 S-Box 實現分派到各自展開的內核
+#ifdef ZUC_HAVE_SBOX_SHUFFLE
+#define ZUC8_DISPATCH(fn, ...) do { \
+    switch (zuc8_sbox) { \
+    case ZUC_SBOX_SHUFFLE: fn(__VA_ARGS__, ZUC_SBOX_SHUFFLE); break; \
+    case ZUC_SBOX_TABLE:   fn(__VA_ARGS__, ZUC_SBOX_TABLE); break; \
+    default:               fn(__VA_ARGS__, ZUC_SBOX_GATHER); break; \
+    } \
+} while (0)
+#else
+#define ZUC8_DISPATCH(fn, ...) do { \
+    if (zuc8_sbox == ZUC_SBOX_TABLE) fn(__VA_ARGS__, ZUC_SBOX_TABLE); \
+    else fn(__VA_ARGS__, ZUC_SBOX_GATHER); \
+} while (0)
+#endif
+
+// 16 步工作模式，out[j] 為第 j 步 8 個通道的密鑰流；狀態只在結束時寫回一次
+static inline __attribute__((always_inline))
+void zuc_keystream16_8ch_impl(zuc_state_8ch* state, __m256i out[16], zuc_sbox_impl sbox) {
+    __m256i s[16];
+    __m256i R1 = state->R1, R2 = state->R2;
+    memcpy(s, state->lfsr, sizeof(s));
+#define ZUC8_WORK_ROUND(k) out[k] = zuc_round_8ch(s, k, &R1, &R2, 0, sbox);
+    ZUC8_REPEAT16(ZUC8_WORK_ROUND)
+#undef ZUC8_WORK_ROUND
+    memcpy(state->lfsr, s, sizeof(s));
+    state->R1 = R1;
+    state->R2 = R2;
+}
+
+static void zuc_keystream16_8ch(zuc_state_8ch* state, __m256i out[16]) {
+    ZUC8_DISPATCH(zuc_keystream16_8ch_impl, state, out);
+}
+
+// 單步工作模式 (非 16 對齊時使用)
+static inline __attribute__((always_inline))
+void zuc_step_8ch_impl(zuc_state_8ch* state, __m256i* z, zuc_sbox_impl sbox) {
+    *z = zuc_round_8ch(state->lfsr, state->lfsr_offset, &state->R1, &state->R2, 0, sbox);
+    state->lfsr_offset = (state->lfsr_offset + 1) & 15;
+}
+
+static inline __m256i zuc_step_8ch(zuc_state_8ch* state) {
+    __m256i z;
+    ZUC8_DISPATCH(zuc_step_8ch_impl, state, &z);
+    return z;
+}
+
+// 8x8 的 32 位轉置：r[j] 為第 j 步 8 個通道的字，輸出 t[ch] 為通道 ch 連續 8 步的字
+static inline void transpose_8x8_epi32(const __m256i r[8], __m256i t[8]) {
+    __m256i a0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    __m256i a1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    __m256i a2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    __m256i a3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    __m256i a4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    __m256i a5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    __m256i a6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    __m256i a7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    __m256i b0 = _mm256_unpacklo_epi64(a0, a2);
+    __m256i b1 = _mm256_unpackhi_epi64(a0, a2);
+    __m256i b2 = _mm256_unpacklo_epi64(a1, a3);
+    __m256i b3 = _mm256_unpackhi_epi64(a1, a3);
+    __m256i b4 = _mm256_unpacklo_epi64(a4, a6);
+    __m256i b5 = _mm256_unpackhi_epi64(a4, a6);
+    __m256i b6 = _mm256_unpacklo_epi64(a5, a7);
+    __m256i b7 = _mm256_unpackhi_epi64(a5, a7);
+
+    t[0] = _mm256_permute2x128_si256(b0, b4, 0x20);
+    t[1] = _mm256_permute2x128_si256(b1, b5, 0x20);
+    t[2] = _mm256_permute2x128_si256(b2, b6, 0x20);
+    t[3] = _mm256_permute2x128_si256(b3, b7, 0x20);
+    t[4] = _mm256_permute2x128_si256(b0, b4, 0x31);
+    t[5] = _mm256_permute2x128_si256(b1, b5, 0x31);
+    t[6] = _mm256_permute2x128_si256(b2, b6, 0x31);
+    t[7] = _mm256_permute2x128_si256(b3, b7, 0x31);
+}
+
+// 完整初始化內核：32 輪初始化模式 + 丟棄的第一個工作模式字，全部展開在寄存器中；
+// 沒有模式分支，兩個 16 步之間也不寫回狀態。結束時 s_0 位於 lfsr[1]
+static inline __attribute__((always_inline)) void zuc_init_kernel_8ch_impl(zuc_state_8ch* state, zuc_sbox_impl sbox) {
+    __m256i s[16];
+    __m256i R1 = _mm256_setzero_si256(), R2 = _mm256_setzero_si256();
+    memcpy(s, state->lfsr, sizeof(s));
+#define ZUC8_INIT_ROUND(k) (void)zuc_round_8ch(s, k, &R1, &R2, 1, sbox);
+    ZUC8_REPEAT16(ZUC8_INIT_ROUND)
+    ZUC8_REPEAT16(ZUC8_INIT_ROUND)
+#undef ZUC8_INIT_ROUND
+    (void)zuc_round_8ch(s, 0, &R1, &R2, 0, sbox);
+    memcpy(state->lfsr, s, sizeof(s));
+    state->R1 = R1;
+    state->R2 = R2;
+    state->lfsr_offset = 1;
+    state->is_init_mode = 0;
+    state->discard_initial_output = 1;
+}
+
+// S-Box數據一次性初始化
+static void zuc8_tables_init(void) {
     static int sbox_data_initialized = 0;
     if (!sbox_data_initialized) {
         init_sbox_data_avx2();
         sbox_data_initialized = 1;
     }
+}
 
-    memcpy(state->keys, keys, sizeof(state->keys));
-    memcpy(state->ivs, ivs, sizeof(state->ivs));
-    
-    // LFSR 初始化
-    uint32_t lfsr_vals[8] __attribute__((aligned(32))); 
-    for (int i = 0; i < 16; i++) {
-        for (int ch = 0; ch < 8; ch++) {
-            lfsr_vals[ch] = ((uint32_t)keys[ch][i] << 23) | 
-                           ((uint32_t)D[i] << 8) | 
-                           ivs[ch][i];
+// 32 輪初始化並丟棄第一個輸出 (LFSR 已裝載)，ZUC-128 與 ZUC-256 共用
+static void zuc_init_rounds_8ch(zuc_state_8ch* state) {
+    zuc8_tables_init();
+    ZUC8_DISPATCH(zuc_init_kernel_8ch_impl, state);
+}
+
+// 密鑰/IV 裝載 s_i = k_i || d_i || iv_i：每個通道的 16 字節用 vpmovzxbd 擴展成
+// s_0..7 和 s_8..15 兩行，再做兩次 8x8 轉置得到按 s_i 排列的 8 通道向量
+static inline void zuc_load_8ch(__m256i s[16], const uint8_t keys[8][16], const uint8_t ivs[8][16]) {
+    const __m256i d_lo = _mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)D)), 8);
+    const __m256i d_hi = _mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(D + 8))), 8);
+    __m256i lo[8], hi[8];
+
+    for (int ch = 0; ch < 8; ch++) {
+        __m128i k = _mm_loadu_si128((const __m128i*)keys[ch]);
+        __m128i v = _mm_loadu_si128((const __m128i*)ivs[ch]);
+        lo[ch] = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(_mm256_cvtepu8_epi32(k), 23), d_lo),
+                                 _mm256_cvtepu8_epi32(v));
+        hi[ch] = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(k, 8)), 23), d_hi),
+                                 _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+    }
+    transpose_8x8_epi32(lo, s);
+    transpose_8x8_epi32(hi, s + 8);
+}
+
+// 兩個獨立狀態交錯初始化：單個狀態每步的依賴鏈 (F 函數 -> S-Box -> R1/R2) 很長，
+// 兩條鏈交錯後亂序執行可以互相填補空閒的執行端口
+static inline __attribute__((always_inline)) void zuc_init_kernel_8ch_x2_impl(zuc_state_8ch* a, zuc_state_8ch* b, zuc_sbox_impl sbox) {
+    __m256i sa[16], sb[16];
+    __m256i R1a = _mm256_setzero_si256(), R2a = _mm256_setzero_si256();
+    __m256i R1b = _mm256_setzero_si256(), R2b = _mm256_setzero_si256();
+    memcpy(sa, a->lfsr, sizeof(sa));
+    memcpy(sb, b->lfsr, sizeof(sb));
+#define ZUC8_INIT_ROUND_X2(k) (void)zuc_round_8ch(sa, k, &R1a, &R2a, 1, sbox); \
+                              (void)zuc_round_8ch(sb, k, &R1b, &R2b, 1, sbox);
+    ZUC8_REPEAT16(ZUC8_INIT_ROUND_X2)
+    ZUC8_REPEAT16(ZUC8_INIT_ROUND_X2)
+#undef ZUC8_INIT_ROUND_X2
+    (void)zuc_round_8ch(sa, 0, &R1a, &R2a, 0, sbox);
+    (void)zuc_round_8ch(sb, 0, &R1b, &R2b, 0, sbox);
+    memcpy(a->lfsr, sa, sizeof(sa));
+    memcpy(b->lfsr, sb, sizeof(sb));
+    a->R1 = R1a; a->R2 = R2a;
+    b->R1 = R1b; b->R2 = R2b;
+    a->lfsr_offset = b->lfsr_offset = 1;
+    a->is_init_mode = b->is_init_mode = 0;
+    a->discard_initial_output = b->discard_initial_output = 1;
+}
+
+static inline __attribute__((always_inline))
+void zuc_init_batch_8ch_impl(zuc_state_8ch states[], const uint8_t (*keys)[16], const uint8_t (*ivs)[16],
+                             size_t n, zuc_sbox_impl sbox) {
+    size_t j = 0;
+    for (; j + 2 <= n; j += 2) {
+        for (size_t t = j; t < j + 2; t++) {
+            memcpy(states[t].keys, keys + 8 * t, sizeof(states[t].keys));
+            memcpy(states[t].ivs, ivs + 8 * t, sizeof(states[t].ivs));
+            zuc_load_8ch(states[t].lfsr, keys + 8 * t, ivs + 8 * t);
         }
-        state->lfsr[i] = _mm256_load_si256((__m256i*)lfsr_vals);
+        zuc_init_kernel_8ch_x2_impl(&states[j], &states[j + 1], sbox);
     }
-    
-    state->R1 = _mm256_setzero_si256();
-    state->R2 = _mm256_setzero_si256();
-    state->is_init_mode = 1;
-    
-    for (int i = 0; i < 32; i++) {
-        zuc_step_8ch(state, NULL, NULL);
+    for (; j < n; j++) {
+        memcpy(states[j].keys, keys + 8 * j, sizeof(states[j].keys));
+        memcpy(states[j].ivs, ivs + 8 * j, sizeof(states[j].ivs));
+        zuc_load_8ch(states[j].lfsr, keys + 8 * j, ivs + 8 * j);
+        zuc_init_kernel_8ch_impl(&states[j], sbox);
     }
+}
 
-    state->is_init_mode = 0;
-    state->discard_initial_output = 0; 
+// 批量初始化 n 個 8 通道狀態 (S-Box 實現只分派一次)
+void zuc_init_8ch_batch(zuc_state_8ch states[], const uint8_t keys[][16], const uint8_t ivs[][16], size_t n) {
+    zuc8_tables_init();
+    ZUC8_DISPATCH(zuc_init_batch_8ch_impl, states, keys, ivs, n);
+}
+
+// 初始化8個ZUC實例
+void zuc_init_8ch(zuc_state_8ch* state, const uint8_t keys[8][16], const uint8_t ivs[8][16]) {
+    zuc_init_8ch_batch(state, keys, ivs, 1);
+}
+
+// 只重新初始化 lanes 中的通道：在臨時狀態上完整初始化 8 個通道 (未選中通道的結果丟棄)，
+// 再按 s_i 對齊混合進當前狀態；其餘通道的 LFSR/R1/R2 和環形位置都不變
+void zuc_init_8ch_mask(zuc_state_8ch* state, const uint8_t keys[8][16], const uint8_t ivs[8][16], uint8_t lanes) {
+    zuc_state_8ch t;
+    uint32_t m[8] __attribute__((aligned(32)));
+
+    if (lanes == 0) return;
+    zuc_init_8ch(&t, keys, ivs);
+    for (int ch = 0; ch < 8; ch++) {
+        m[ch] = (lanes >> ch) & 1 ? 0xFFFFFFFFu : 0;
+        if ((lanes >> ch) & 1) {
+            memcpy(state->keys[ch], keys[ch], 16);
+            memcpy(state->ivs[ch], ivs[ch], 16);
+        }
+    }
+    const __m256i mask = _mm256_load_si256((const __m256i*)m);
+    for (int i = 0; i < 16; i++) {
+        __m256i *dst = &state->lfsr[(state->lfsr_offset + i) & 15];
+        *dst = _mm256_blendv_epi8(*dst, t.lfsr[(t.lfsr_offset + i) & 15], mask);
+    }
+    state->R1 = _mm256_blendv_epi8(state->R1, t.R1, mask);
+    state->R2 = _mm256_blendv_epi8(state->R2, t.R2, mask);
+    zuc_clear_8ch(&t);
+}
+
+#define ZUC256_U31(a, b, c, d) (((uint32_t)(a) << 23) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
+
+// ZUC-256 裝載：每個 s_i 由 8 位 + 7 位 + 8 位 + 8 位拼成
+static void zuc256_load(const uint8_t k[32], const uint8_t iv[23], const uint8_t d[16], uint32_t s[16]) {
+    // IV 的後 8 個 6 位分量 iv17..iv24 依次打包在 iv[17..22]
+    uint8_t iv17 = iv[17] >> 2;
+    uint8_t iv18 = ((iv[17] & 0x3) << 4) | (iv[18] >> 4);
+    uint8_t iv19 = ((iv[18] & 0xF) << 2) | (iv[19] >> 6);
+    uint8_t iv20 = iv[19] & 0x3F;
+    uint8_t iv21 = iv[20] >> 2;
+    uint8_t iv22 = ((iv[20] & 0x3) << 4) | (iv[21] >> 4);
+    uint8_t iv23 = ((iv[21] & 0xF) << 2) | (iv[22] >> 6);
+    uint8_t iv24 = iv[22] & 0x3F;
+
+    s[0]  = ZUC256_U31(k[0], d[0], k[21], k[16]);
+    s[1]  = ZUC256_U31(k[1], d[1], k[22], k[17]);
+    s[2]  = ZUC256_U31(k[2], d[2], k[23], k[18]);
+    s[3]  = ZUC256_U31(k[3], d[3], k[24], k[19]);
+    s[4]  = ZUC256_U31(k[4], d[4], k[25], k[20]);
+    s[5]  = ZUC256_U31(iv[0], d[5] | iv17, k[5], k[26]);
+    s[6]  = ZUC256_U31(iv[1], d[6] | iv18, k[6], k[27]);
+    s[7]  = ZUC256_U31(iv[10], d[7] | iv19, k[7], iv[2]);
+    s[8]  = ZUC256_U31(k[8], d[8] | iv20, iv[3], iv[11]);
+    s[9]  = ZUC256_U31(k[9], d[9] | iv21, iv[12], iv[4]);
+    s[10] = ZUC256_U31(iv[5], d[10] | iv22, k[10], k[28]);
+    s[11] = ZUC256_U31(k[11], d[11] | iv23, iv[6], iv[13]);
+    s[12] = ZUC256_U31(k[12], d[12] | iv24, iv[7], iv[14]);
+    s[13] = ZUC256_U31(k[13], d[13], iv[15], iv[8]);
+    s[14] = ZUC256_U31(k[14], d[14] | (k[31] >> 4), iv[16], iv[9]);
+    s[15] = ZUC256_U31(k[15], d[15] | (k[31] & 0x0F), k[30], k[29]);
+}
+
+// 初始化8個ZUC-256實例
+int zuc256_init_8ch(zuc_state_8ch* state, const uint8_t keys[8][32], const uint8_t ivs[8][23], int tag_bits) {
+    uint32_t s[8][16] __attribute__((aligned(32)));
+    __m256i lo[8], hi[8];
+    const uint8_t *d;
+
+    switch (tag_bits) {
+    case 0:   d = D256[0]; break;
+    case 32:  d = D256[1]; break;
+    case 64:  d = D256[2]; break;
+    case 128: d = D256[3]; break;
+    default:  return -1;
+    }
+
+    // keys/ivs 字段只保存 ZUC-128 的參數
+    memset(state->keys, 0, sizeof(state->keys));
+    memset(state->ivs, 0, sizeof(state->ivs));
+
+    for (int ch = 0; ch < 8; ch++) {
+        zuc256_load(keys[ch], ivs[ch], d, s[ch]);
+    }
+    for (int ch = 0; ch < 8; ch++) {
+        lo[ch] = _mm256_load_si256((const __m256i*)s[ch]);
+        hi[ch] = _mm256_load_si256((const __m256i*)(s[ch] + 8));
+    }
+    transpose_8x8_epi32(lo, state->lfsr);
+    transpose_8x8_epi32(hi, state->lfsr + 8);
+    memset(s, 0, sizeof(s));
+
+    zuc_init_rounds_8ch(state);
+    return 0;
 }
 
 // 生成8通道密鑰流
 void zuc_generate_8ch(zuc_state_8ch* state, uint32_t output[8]) {
+    _mm256_storeu_si256((__m256i*)output, zuc_step_8ch(state));
+}
+
+// 一次生成 16 個字 (每通道)，output[j][ch] 與連續 16 次 zuc_generate_8ch 的結果相同
+void zuc_generate_8ch_x16(zuc_state_8ch* state, uint32_t output[16][8]) {
+    __m256i out[16];
 
-    if (state->discard_initial_output == 0) {
-        zuc_step_8ch(state, NULL, NULL);
-        state->discard_initial_output = 1;
+    if (state->lfsr_offset == 0) {
+        zuc_keystream16_8ch(state, out);
+    } else {
+        // 與單步調用混用後環形位置不為 0：逐步生成 16 個字，位置回到原處
+        for (int j = 0; j < 16; j++) {
+            out[j] = zuc_step_8ch(state);
+        }
     }
+    for (int j = 0; j < 16; j++) {
+        _mm256_storeu_si256((__m256i*)output[j], out[j]);
+    }
+}
+
+// 單步生成到臨時數組 (處理非 16 對齊的頭尾)
+static inline void zuc_step_store_8ch(zuc_state_8ch* state, uint32_t word[8]) {
+    _mm256_storeu_si256((__m256i*)word, zuc_step_8ch(state));
+}
+
+void zuc_generate_8ch_n(zuc_state_8ch* state, uint32_t *out[8], size_t nwords) {
+    uint32_t word[8];
+    size_t pos = 0;
+
+    while (pos < nwords && state->lfsr_offset != 0) {
+        zuc_step_store_8ch(state, word);
+        for (int ch = 0; ch < 8; ch++) out[ch][pos] = word[ch];
+        pos++;
+    }
+
+    while (pos + 16 <= nwords) {
+        __m256i ks[16], t[8];
+        zuc_keystream16_8ch(state, ks);
+        for (int half = 0; half < 2; half++) {
+            transpose_8x8_epi32(ks + half * 8, t);
+            for (int ch = 0; ch < 8; ch++) {
+                _mm256_storeu_si256((__m256i*)(out[ch] + pos + half * 8), t[ch]);
+            }
+        }
+        pos += 16;
+    }
+
+    while (pos < nwords) {
+        zuc_step_store_8ch(state, word);
+        for (int ch = 0; ch < 8; ch++) out[ch][pos] = word[ch];
+        pos++;
+    }
+}
+
+void zuc_xor_8ch_n(zuc_state_8ch* state, const uint8_t *in[8], uint8_t *out[8], size_t len) {
+    // 密鑰流字按大端字節序展開
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    uint32_t word[8];
+    size_t nwords = (len + 3) / 4;
+    size_t pos = 0;
 
-    __m256i W_val, X3_val;
-    zuc_step_8ch(state, &W_val, &X3_val);
-    
-    __m256i out_vec = _mm256_xor_si256(W_val, X3_val);
-    _mm256_storeu_si256((__m256i*)output, out_vec);
+    #define ZUC8_XOR_WORD(ch, w, p) do { \
+        for (size_t b_ = 0; b_ < 4 && (p) * 4 + b_ < len; b_++) { \
+            out[ch][(p) * 4 + b_] = in[ch][(p) * 4 + b_] ^ (uint8_t)((w) >> (24 - 8 * b_)); \
+        } \
+    } while (0)
+
+    while (pos < nwords && state->lfsr_offset != 0) {
+        zuc_step_store_8ch(state, word);
+        for (int ch = 0; ch < 8; ch++) ZUC8_XOR_WORD(ch, word[ch], pos);
+        pos++;
+    }
+
+    // 只有完整的 64 字節才走向量路徑，最後不足一個字的部分留給逐字處理
+    while (pos + 16 <= len / 4) {
+        __m256i ks[16], t[8];
+        zuc_keystream16_8ch(state, ks);
+        for (int half = 0; half < 2; half++) {
+            transpose_8x8_epi32(ks + half * 8, t);
+            for (int ch = 0; ch < 8; ch++) {
+                size_t off = (pos + half * 8) * 4;
+                __m256i d = _mm256_loadu_si256((const __m256i*)(in[ch] + off));
+                d = _mm256_xor_si256(d, _mm256_shuffle_epi8(t[ch], bswap));
+                _mm256_storeu_si256((__m256i*)(out[ch] + off), d);
+            }
+        }
+        pos += 16;
+    }
+
+    while (pos < nwords) {
+        zuc_step_store_8ch(state, word);
+        for (int ch = 0; ch < 8; ch++) ZUC8_XOR_WORD(ch, word[ch], pos);
+        pos++;
+    }
+
+    #undef ZUC8_XOR_WORD
+}
+
+// 替換單個通道的狀態，s[i] 為該通道的 s_i；其餘通道不變
+void zuc_set_lane_8ch(zuc_state_8ch* state, int ch, const uint32_t s[16], uint32_t R1, uint32_t R2) {
+    uint32_t lane[8] __attribute__((aligned(32)));
+
+    for (int i = 0; i < 16; i++) {
+        __m256i *r = &state->lfsr[(state->lfsr_offset + i) & 15];
+        _mm256_store_si256((__m256i*)lane, *r);
+        lane[ch] = s[i];
+        *r = _mm256_load_si256((const __m256i*)lane);
+    }
+    _mm256_store_si256((__m256i*)lane, state->R1);
+    lane[ch] = R1;
+    state->R1 = _mm256_load_si256((const __m256i*)lane);
+    _mm256_store_si256((__m256i*)lane, state->R2);
+    lane[ch] = R2;
+    state->R2 = _mm256_load_si256((const __m256i*)lane);
 }
 
 // 清理狀態
@@ -4,6 +4,8 @@
 
 #include <immintrin.h> 
 #include <stdint.h>    
+#include <stddef.h>
+#include "zuc_sbox.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -17,14 +19,49 @@ typedef struct {
     uint8_t ivs[8][16];
     int discard_initial_output;
     int is_init_mode;  
+    int lfsr_offset;   // 環形 LFSR 中 s0 的位置 (lfsr[(lfsr_offset + i) & 15] 為 s_i)
 } zuc_state_8ch;
 
 // 初始化8個ZUC實例
 void zuc_init_8ch(zuc_state_8ch* state, const uint8_t keys[8][16], const uint8_t ivs[8][16]);
 
+// 批量初始化 n 個 8 通道狀態：states[j] 使用 keys[8j .. 8j+7] 和 ivs[8j .. 8j+7]，
+// 結果與逐個 zuc_init_8ch 相同
+void zuc_init_8ch_batch(zuc_state_8ch states[], const uint8_t keys[][16], const uint8_t ivs[][16], size_t n);
+
+// 只重新初始化 lanes (第 ch 位對應通道 ch) 中的通道，其餘通道繼續原來的密鑰流；
+// keys/ivs 中未選中通道的內容不使用
+void zuc_init_8ch_mask(zuc_state_8ch* state, const uint8_t keys[8][16], const uint8_t ivs[8][16], uint8_t lanes);
+
+// 初始化8個ZUC-256實例：iv 為 23 字節 (後 8 個 6 位分量打包在 iv[17..22])，
+// tag_bits 為 0 時生成加密用密鑰流，為 32/64/128 時使用對應長度 MAC 的 D 常量；
+// 其他值返回 -1 且不修改 state，成功返回 0
+int zuc256_init_8ch(zuc_state_8ch* state, const uint8_t keys[8][32], const uint8_t ivs[8][23], int tag_bits);
+
 // 生成8通道密鑰流
 void zuc_generate_8ch(zuc_state_8ch* state, uint32_t output[8]);
 
+// 一次生成每通道 16 個字：16 步完全展開，LFSR 寄存器輪換命名而不搬移數據
+// output[j][ch] 為通道 ch 的第 j 個字 (與連續 16 次 zuc_generate_8ch 相同)
+void zuc_generate_8ch_x16(zuc_state_8ch* state, uint32_t output[16][8]);
+
+// 批量生成：每個通道的 nwords 個密鑰流字連續寫入 out[ch]
+// (內部每 16 步做兩次 8x8 寄存器轉置，輸出按通道順序存放)
+void zuc_generate_8ch_n(zuc_state_8ch* state, uint32_t *out[8], size_t nwords);
+
+// 批量異或：每個通道 len 字節，out[ch] = in[ch] ^ 密鑰流 (字按大端字節序展開，與 128-EEA3 一致)
+// 消耗 ceil(len / 4) 個字；in[ch] 與 out[ch] 可以相同
+void zuc_xor_8ch_n(zuc_state_8ch* state, const uint8_t *in[8], uint8_t *out[8], size_t len);
+
+// 替換通道 ch 的狀態 (s[i] 為 s_i，按當前環形位置寫入)，用於在其他通道繼續運行時裝入新的流
+void zuc_set_lane_8ch(zuc_state_8ch* state, int ch, const uint32_t s[16], uint32_t R1, uint32_t R2);
+
+// 選擇 S-Box 實現 (對之後所有 8 通道調用生效)，不支持時返回 -1 並保持原設置。
+// ZUC_SBOX_SHUFFLE 需要以 -maes 編譯且運行的 CPU 支持 AES-NI。默認在加載時檢查 CPUID：
+// 有 AES-NI 時為 ZUC_SBOX_SHUFFLE，否則為 ZUC_SBOX_GATHER
+int zuc_set_sbox_8ch(zuc_sbox_impl impl);
+zuc_sbox_impl zuc_get_sbox_8ch(void);
+
 // 清理狀態
 void zuc_clear_8ch(zuc_state_8ch* state);
 
@@ -0,0 +1,47 @@
+// 作者：https://github.com/8891689
+#ifndef ZUC_AVX512_H
+#define ZUC_AVX512_H
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "zuc_sbox.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ZUC 16通道狀態 (AVX-512，編譯需要 -mavx512f -mavx512bw；S-Box 實現見 zuc_set_sbox_16ch)
+typedef struct {
+    __m512i lfsr[16];
+    __m512i R1, R2;
+    int lfsr_offset;   // 環形 LFSR 中 s0 的位置 (lfsr[(lfsr_offset + i) & 15] 為 s_i)
+} zuc_state_16ch;
+
+// 初始化16個ZUC實例
+void zuc_init_16ch(zuc_state_16ch* state, const uint8_t keys[16][16], const uint8_t ivs[16][16]);
+
+// 只重新初始化 lanes 中的通道 (k 寄存器掩碼)，其餘通道的密鑰流位置不變
+void zuc_init_16ch_mask(zuc_state_16ch* state, const uint8_t keys[16][16], const uint8_t ivs[16][16],
+                        __mmask16 lanes);
+
+// 生成16通道密鑰流 (每通道一個字)
+void zuc_generate_16ch(zuc_state_16ch* state, uint32_t output[16]);
+
+// 一次生成每通道 16 個字，output[j][ch] 為通道 ch 的第 j 個字
+void zuc_generate_16ch_x16(zuc_state_16ch* state, uint32_t output[16][16]);
+
+// 選擇 S-Box 實現 (對之後所有 16 通道調用生效)，不支持時返回 -1 並保持原設置。
+// ZUC_SBOX_GATHER 總是可用；ZUC_SBOX_SHUFFLE 需要以 -mgfni 編譯且運行的 CPU 支持 GFNI，
+// ZUC_SBOX_PERMUTE 需要以 -mavx512vbmi 編譯。默認在加載時檢查 CPUID：有 GFNI 時為 SHUFFLE，否則為 GATHER
+int zuc_set_sbox_16ch(zuc_sbox_impl impl);
+zuc_sbox_impl zuc_get_sbox_16ch(void);
+
+// 清理狀態
+void zuc_clear_16ch(zuc_state_16ch* state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ZUC_AVX512_H
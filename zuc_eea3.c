@@ -0,0 +1,191 @@
+// 作者：https://github.com/8891689
+// zuc_eea3.c
+#include <string.h>
+#include "zuc_eea3.h"
+#include "zuc.h"
+#include "zuc_avx2.h"
+
+// 每次批量異或的最大字節數 (空閒通道寫入同樣大小的臨時緩衝區)
+#define ZUC_EEA3_CHUNK 512
+
+void zuc_eea3_iv(uint32_t count, uint8_t bearer, uint8_t direction, uint8_t iv[16]) {
+    iv[0] = (uint8_t)(count >> 24);
+    iv[1] = (uint8_t)(count >> 16);
+    iv[2] = (uint8_t)(count >> 8);
+    iv[3] = (uint8_t)count;
+    iv[4] = (uint8_t)(((bearer & 0x1F) << 3) | ((direction & 1) << 2));
+    iv[5] = iv[6] = iv[7] = 0;
+    memcpy(iv + 8, iv, 8);
+}
+
+// 清零最後一個字節中超出 bitlen 的比特
+static inline void eea3_mask_tail(uint8_t *out, uint32_t bitlen) {
+    if (bitlen & 7) {
+        out[bitlen / 8] &= (uint8_t)(0xFF << (8 - (bitlen & 7)));
+    }
+}
+
+void zuc_eea3(const uint8_t key[16], uint32_t count, uint8_t bearer, uint8_t direction,
+              const uint8_t *in, uint8_t *out, uint32_t bitlen) {
+    zuc_ctx ctx;
+    uint8_t iv[16];
+
+    zuc_eea3_iv(count, bearer, direction, iv);
+    zuc_init(&ctx, key, iv);
+    zuc_xor(&ctx, in, out, ((size_t)bitlen + 7) / 8);
+    eea3_mask_tail(out, bitlen);
+    memset(&ctx, 0, sizeof(ctx));
+}
+
+// 少於這麼多通道待初始化時，逐個標量初始化再寫入通道，否則一次向量化掩碼初始化
+// (掩碼初始化無論幾個通道都要完整跑 8 通道的 32 輪，IMIX 實測 4 左右最好)
+#define ZUC_EEA3_VEC_INIT_MIN 4
+
+void zuc_eea3_mgr_init(zuc_eea3_mgr *mgr) {
+    memset(mgr, 0, sizeof(*mgr));
+}
+
+static void eea3_mgr_push_done(zuc_eea3_mgr *mgr, const zuc_eea3_job *job) {
+    mgr->done[(mgr->done_head + mgr->done_count) & 7] = job;
+    mgr->done_count++;
+}
+
+static const zuc_eea3_job *eea3_mgr_pop_done(zuc_eea3_mgr *mgr) {
+    if (mgr->done_count == 0) return NULL;
+    const zuc_eea3_job *job = mgr->done[mgr->done_head];
+    mgr->done_head = (mgr->done_head + 1) & 7;
+    mgr->done_count--;
+    return job;
+}
+
+// 初始化所有待初始化的通道
+static void eea3_mgr_init_pending(zuc_eea3_mgr *mgr) {
+    int n = __builtin_popcount(mgr->pending);
+
+    if (n >= ZUC_EEA3_VEC_INIT_MIN) {
+        zuc_init_8ch_mask(&mgr->state, mgr->keys, mgr->ivs, mgr->pending);
+    } else {
+        for (int ch = 0; ch < 8; ch++) {
+            if (!((mgr->pending >> ch) & 1)) continue;
+            uint32_t s[16];
+            zuc_ctx ctx;
+            zuc_init(&ctx, mgr->keys[ch], mgr->ivs[ch]);
+            for (int i = 0; i < 16; i++) {
+                s[i] = ctx.lfsr[(ctx.off + i) & 15];
+            }
+            zuc_set_lane_8ch(&mgr->state, ch, s, ctx.R1, ctx.R2);
+            memcpy(mgr->state.keys[ch], mgr->keys[ch], 16);
+            memcpy(mgr->state.ivs[ch], mgr->ivs[ch], 16);
+            memset(&ctx, 0, sizeof(ctx));
+            memset(s, 0, sizeof(s));
+        }
+    }
+    memset(mgr->keys, 0, sizeof(mgr->keys));
+    mgr->pending = 0;
+}
+
+// 運行所有忙碌通道，直到至少一個數據包完成 (調用時至少有一個忙碌通道)
+static void eea3_mgr_run(zuc_eea3_mgr *mgr) {
+    uint8_t scratch[ZUC_EEA3_CHUNK];
+    int completed = 0;
+
+    if (mgr->pending) eea3_mgr_init_pending(mgr);
+
+    while (!completed) {
+        const uint8_t *in[8];
+        uint8_t *out[8];
+        size_t chunk = ZUC_EEA3_CHUNK;
+
+        for (int ch = 0; ch < 8; ch++) {
+            const zuc_eea3_job *job = mgr->lane_job[ch];
+            if (job) {
+                size_t rem = mgr->lane_bytes[ch] - mgr->lane_done[ch];
+                if (rem < chunk) chunk = rem;
+                in[ch] = job->in + mgr->lane_done[ch];
+                out[ch] = job->out + mgr->lane_done[ch];
+            } else {
+                in[ch] = scratch;
+                out[ch] = scratch;
+            }
+        }
+
+        if (chunk >= 4) {
+            // 所有忙碌通道都至少還有 chunk 字節：按整字批量異或
+            chunk &= ~(size_t)3;
+            zuc_xor_8ch_n(&mgr->state, in, out, chunk);
+            for (int ch = 0; ch < 8; ch++) {
+                if (mgr->lane_job[ch]) mgr->lane_done[ch] += chunk;
+            }
+        } else {
+            // 有通道只剩最後一個不完整的字：單步生成，各通道按自己的剩餘長度異或
+            uint32_t w[8];
+            zuc_generate_8ch(&mgr->state, w);
+            for (int ch = 0; ch < 8; ch++) {
+                if (!mgr->lane_job[ch]) continue;
+                size_t n = mgr->lane_bytes[ch] - mgr->lane_done[ch];
+                if (n > 4) n = 4;
+                for (size_t b = 0; b < n; b++) {
+                    out[ch][b] = in[ch][b] ^ (uint8_t)(w[ch] >> (24 - 8 * b));
+                }
+                mgr->lane_done[ch] += n;
+            }
+        }
+
+        // 完成的數據包進入完成隊列，通道空出
+        for (int ch = 0; ch < 8; ch++) {
+            const zuc_eea3_job *job = mgr->lane_job[ch];
+            if (!job || mgr->lane_done[ch] < mgr->lane_bytes[ch]) continue;
+            eea3_mask_tail(job->out, job->bitlen);
+            eea3_mgr_push_done(mgr, job);
+            mgr->lane_job[ch] = NULL;
+            completed = 1;
+        }
+    }
+}
+
+const zuc_eea3_job *zuc_eea3_submit(zuc_eea3_mgr *mgr, const zuc_eea3_job *job) {
+    if (job->bitlen == 0) {
+        // 長度為 0 的數據包無需處理
+        eea3_mgr_push_done(mgr, job);
+        return eea3_mgr_pop_done(mgr);
+    }
+
+    int ch = 0;
+    while (mgr->lane_job[ch]) ch++;     // 提交之後總會留出至少一個空閒通道
+    mgr->lane_job[ch] = job;
+    mgr->lane_bytes[ch] = ((size_t)job->bitlen + 7) / 8;
+    mgr->lane_done[ch] = 0;
+    memcpy(mgr->keys[ch], job->key, 16);
+    zuc_eea3_iv(job->count, job->bearer, job->direction, mgr->ivs[ch]);
+    mgr->pending |= (uint8_t)(1u << ch);
+
+    int busy = 0;
+    for (int i = 0; i < 8; i++) busy += mgr->lane_job[i] != NULL;
+    if (busy == 8) eea3_mgr_run(mgr);
+
+    return eea3_mgr_pop_done(mgr);
+}
+
+const zuc_eea3_job *zuc_eea3_flush(zuc_eea3_mgr *mgr) {
+    if (mgr->done_count == 0) {
+        int busy = 0;
+        for (int ch = 0; ch < 8; ch++) busy += mgr->lane_job[ch] != NULL;
+        if (!busy) {
+            zuc_clear_8ch(&mgr->state);
+            return NULL;
+        }
+        eea3_mgr_run(mgr);
+    }
+    return eea3_mgr_pop_done(mgr);
+}
+
+void zuc_eea3_8ch(const zuc_eea3_job *jobs, size_t njobs) {
+    zuc_eea3_mgr mgr;
+
+    zuc_eea3_mgr_init(&mgr);
+    for (size_t i = 0; i < njobs; i++) {
+        (void)zuc_eea3_submit(&mgr, &jobs[i]);
+    }
+    while (zuc_eea3_flush(&mgr)) {
+    }
+}
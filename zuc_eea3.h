@@ -0,0 +1,86 @@
+// 作者：https://github.com/8891689
+// zuc_eea3.h
+#ifndef ZUC_EEA3_H
+#define ZUC_EEA3_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "zuc_avx2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 128-EEA3 (3GPP 機密性算法)。
+ * IV 由 COUNT(32 位)、BEARER(5 位)、DIRECTION(1 位) 構造；消息長度以比特計，
+ * 輸出最後一個字節中超出長度的比特清零。
+ */
+
+// 一個待加密 (或解密) 的數據包；in 與 out 可以相同
+typedef struct {
+    const uint8_t *key;     // 16 字節
+    uint32_t count;
+    uint8_t bearer;         // 低 5 位有效
+    uint8_t direction;      // 低 1 位有效
+    const uint8_t *in;
+    uint8_t *out;
+    uint32_t bitlen;
+} zuc_eea3_job;
+
+/**
+ * @brief 由 COUNT/BEARER/DIRECTION 構造 128-EEA3 的 16 字節 IV
+ */
+void zuc_eea3_iv(uint32_t count, uint8_t bearer, uint8_t direction, uint8_t iv[16]);
+
+/**
+ * @brief 單個數據包 (標量 ZUC)
+ */
+void zuc_eea3(const uint8_t key[16], uint32_t count, uint8_t bearer, uint8_t direction,
+              const uint8_t *in, uint8_t *out, uint32_t bitlen);
+
+/**
+ * @brief 批量處理 njobs 個數據包，每個數據包各自的密鑰/IV，8 個通道並行 (zuc_avx2)。
+ * 等價於依次 zuc_eea3_submit 所有數據包後 flush 到底。
+ */
+void zuc_eea3_8ch(const zuc_eea3_job *jobs, size_t njobs);
+
+/*
+ * 8 通道作業管理器：數據包逐個提交，每個通道獨立裝入/初始化，
+ * 某個通道的數據包結束後只重新初始化該通道，其餘通道繼續生成密鑰流。
+ * 同一輪中空出的多個通道一起做向量化的掩碼初始化 (zuc_init_8ch_mask)，
+ * 只有 1~2 個通道時改用標量初始化後寫入該通道 (更便宜)。
+ * 完成順序不一定是提交順序；作業結構體和數據緩衝區在返回之前必須保持有效。
+ */
+typedef struct {
+    zuc_state_8ch state;
+    const zuc_eea3_job *lane_job[8];    // NULL 為空閒通道
+    size_t lane_bytes[8], lane_done[8];
+    uint8_t keys[8][16], ivs[8][16];    // 待初始化通道的密鑰/IV
+    uint8_t pending;                    // 已裝入、尚未初始化的通道
+    const zuc_eea3_job *done[8];        // 已完成、尚未返回的作業 (不超過空閒通道數)
+    unsigned done_head, done_count;
+} zuc_eea3_mgr;
+
+/**
+ * @brief 初始化作業管理器 (所有通道空閒)
+ */
+void zuc_eea3_mgr_init(zuc_eea3_mgr *mgr);
+
+/**
+ * @brief 提交一個數據包。有空閒通道時只裝入；8 個通道都被佔用時運行到至少一個數據包完成。
+ * @return 一個已完成的數據包，沒有則返回 NULL
+ */
+const zuc_eea3_job *zuc_eea3_submit(zuc_eea3_mgr *mgr, const zuc_eea3_job *job);
+
+/**
+ * @brief 不再提交新數據包時調用：運行到至少一個數據包完成並返回它；
+ * 全部完成後返回 NULL (此時內部狀態已清零)
+ */
+const zuc_eea3_job *zuc_eea3_flush(zuc_eea3_mgr *mgr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ZUC_EEA3_H
@@ -0,0 +1,362 @@
+// 作者：https://github.com/8891689
+// zuc_eia3.c
+#include <string.h>
+#include <immintrin.h>
+#include "zuc_eia3.h"
+#include "zuc.h"
+#include "zuc_avx2.h"
+
+// 每次生成的密鑰流字數 (每通道)
+#define ZUC_EIA3_CHUNK 256
+// 保留的歷史密鑰流字數上限 (ZUC-256 128 位標籤：延遲 4 + 標籤 4)
+#define ZUC_MAC_HIST 8
+
+/*
+ * 一條消息的累加狀態，128-EIA3 與 ZUC-256 MAC 共用。
+ * 標籤字 j 對消息字 m 使用密鑰流 k_(delay+j+m) || k_(delay+j+m+1)：
+ * EIA3 只有一個標籤字且 delay = 0；ZUC-256 的 t 位標籤有 t/32 個字，delay = t/32，
+ * 初始標籤為密鑰流的前 t/32 個字。密鑰流按字順序分批送入。
+ */
+typedef struct {
+    const uint8_t *msg;
+    uint32_t bitlen;
+    size_t full;        // 完整的消息字數 (bitlen / 32)
+    size_t total;       // 需要的密鑰流字數
+    size_t consumed;    // 已送入的密鑰流字數
+    size_t done;        // 已處理的消息字數 (最後一個不完整的字處理後為 full + 1)
+    int ntag;           // 標籤字數
+    int delay;          // 0 為 EIA3
+    uint32_t hist[ZUC_MAC_HIST];    // 最近送入的 delay + ntag 個密鑰流字
+    uint32_t head[4];   // ZUC-256 的初始標籤
+    __m128i acc[4];     // 無進位乘積的累加，第 32..63 位為 T
+    uint32_t tag[4];
+} zuc_mac_lane;
+
+void zuc_eia3_iv(uint32_t count, uint8_t bearer, uint8_t direction, uint8_t iv[16]) {
+    iv[0] = (uint8_t)(count >> 24);
+    iv[1] = (uint8_t)(count >> 16);
+    iv[2] = (uint8_t)(count >> 8);
+    iv[3] = (uint8_t)count;
+    iv[4] = (uint8_t)((bearer & 0x1F) << 3);
+    iv[5] = iv[6] = iv[7] = 0;
+    memcpy(iv + 8, iv, 8);
+    iv[8] ^= (uint8_t)((direction & 1) << 7);
+    iv[14] ^= (uint8_t)((direction & 1) << 7);
+}
+
+// 每個字節內按比特反轉：消息比特 b (字節內從高位數起) 移到第 b 位
+static inline __m128i reverse_bits_in_bytes(__m128i x) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i rev4 = _mm_setr_epi8(0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+                                       0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF);
+    __m128i lo = _mm_shuffle_epi8(rev4, _mm_and_si128(x, nibble));
+    __m128i hi = _mm_shuffle_epi8(rev4, _mm_and_si128(_mm_srli_epi16(x, 4), nibble));
+    return _mm_or_si128(_mm_slli_epi16(lo, 4), hi);
+}
+
+// 一個消息字 (按內存順序讀出的 4 字節) 與密鑰流 k0 || k1
+static inline __m128i eia3_word(__m128i acc, uint32_t k0, uint32_t k1, uint32_t m_mem) {
+    __m128i r = reverse_bits_in_bytes(_mm_cvtsi32_si128((int)m_mem));
+    __m128i k = _mm_cvtsi64_si128((long long)(((uint64_t)k0 << 32) | k1));
+    return _mm_xor_si128(acc, _mm_clmulepi64_si128(k, r, 0x00));
+}
+
+// n 個完整消息字，ks[0..n] 為對應的密鑰流 k_j .. k_j+n
+static inline __m128i eia3_accumulate(__m128i acc, const uint32_t *ks, const uint8_t *msg, size_t n) {
+    const __m128i lo32 = _mm_set1_epi64x(0xFFFFFFFF);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i r = reverse_bits_in_bytes(_mm_loadu_si128((const __m128i*)(msg + 4 * i)));
+        // 交換每個 64 位中的兩個字：ka = (k_i||k_i+1, k_i+2||k_i+3)，kb 錯開一個字
+        __m128i ka = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(ks + i)), 0xB1);
+        __m128i kb = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(ks + i + 1)), 0xB1);
+        __m128i ra = _mm_and_si128(r, lo32);        // 消息字 i, i+2
+        __m128i rb = _mm_srli_epi64(r, 32);         // 消息字 i+1, i+3
+        __m128i p0 = _mm_clmulepi64_si128(ka, ra, 0x00);
+        __m128i p1 = _mm_clmulepi64_si128(ka, ra, 0x11);
+        __m128i p2 = _mm_clmulepi64_si128(kb, rb, 0x00);
+        __m128i p3 = _mm_clmulepi64_si128(kb, rb, 0x11);
+        acc = _mm_xor_si128(acc, _mm_xor_si128(_mm_xor_si128(p0, p1), _mm_xor_si128(p2, p3)));
+    }
+    for (; i < n; i++) {
+        uint32_t m;
+        memcpy(&m, msg + 4 * i, 4);
+        acc = eia3_word(acc, ks[i], ks[i + 1], m);
+    }
+    return acc;
+}
+
+// 最後一個消息字：清除 bitlen 之後的比特，並在第 bitlen 比特置 1 (對應異或結尾窗口 W_LENGTH)
+static inline uint32_t mac_last_word(const zuc_mac_lane *ln) {
+    size_t nbytes = ((size_t)ln->bitlen + 7) / 8 - ln->full * 4;
+    uint32_t rem = ln->bitlen & 31;
+    uint8_t tmp[4] = {0, 0, 0, 0};
+    uint32_t m;
+
+    memcpy(tmp, ln->msg + ln->full * 4, nbytes);
+    m = ((uint32_t)tmp[0] << 24) | ((uint32_t)tmp[1] << 16) | ((uint32_t)tmp[2] << 8) | tmp[3];
+    m = rem ? (m & (0xFFFFFFFFu << (32 - rem))) : 0;
+    m |= 0x80000000u >> rem;
+    return __builtin_bswap32(m);
+}
+
+// tag_bits 為 0 表示 128-EIA3，否則為 ZUC-256 的標籤長度 (32/64/128)
+static void mac_lane_init(zuc_mac_lane *ln, const uint8_t *msg, uint32_t bitlen, int tag_bits) {
+    memset(ln, 0, sizeof(*ln));
+    ln->msg = msg;
+    ln->bitlen = bitlen;
+    ln->full = bitlen / 32;
+    if (tag_bits) {
+        ln->ntag = tag_bits / 32;
+        ln->delay = ln->ntag;
+        // 最後一個消息字的窗口用到 k_(2*ntag+full)
+        ln->total = 2 * (size_t)ln->ntag + ln->full + 1;
+    } else {
+        ln->ntag = 1;
+        ln->delay = 0;
+        ln->total = ((size_t)bitlen + 31) / 32 + 2;
+    }
+    for (int j = 0; j < ln->ntag; j++) {
+        ln->acc[j] = _mm_setzero_si128();
+    }
+}
+
+// 送入 buf[ZUC_MAC_HIST .. ZUC_MAC_HIST+n) 這 n 個新的密鑰流字，前面的空位用於放入歷史字
+static void mac_consume(zuc_mac_lane *ln, uint32_t *buf, size_t n) {
+    size_t h = (size_t)(ln->delay + ln->ntag);
+    uint32_t *b = buf + ZUC_MAC_HIST - h;      // b[i] 為密鑰流字 consumed - h + i
+    size_t c_old = ln->consumed;
+    size_t c_new = c_old + n;
+
+    memcpy(b, ln->hist, h * sizeof(uint32_t));
+    if (ln->delay) {
+        for (size_t i = c_old; i < c_new && i < (size_t)ln->ntag; i++) {
+            ln->head[i] = b[h + i - c_old];
+        }
+    }
+
+    // 消息字 m 在密鑰流字 m + h 到達後即可處理
+    size_t ready = c_new > h ? c_new - h : 0;
+    if (ready > ln->full + 1) ready = ln->full + 1;
+    if (ln->done < ready) {
+        size_t m0 = ln->done;
+        size_t end = ready < ln->full ? ready : ln->full;
+        uint32_t last = ready > ln->full ? mac_last_word(ln) : 0;
+        for (int j = 0; j < ln->ntag; j++) {
+            const uint32_t *ks = b + h + ln->delay + j + m0 - c_old;
+            if (m0 < end) {
+                ln->acc[j] = eia3_accumulate(ln->acc[j], ks, ln->msg + m0 * 4, end - m0);
+            }
+            if (ready > ln->full) {
+                size_t idx = h + ln->delay + j + ln->full - c_old;
+                ln->acc[j] = eia3_word(ln->acc[j], b[idx], b[idx + 1], last);
+            }
+        }
+        ln->done = ready;
+    }
+
+    ln->consumed = c_new;
+    memcpy(ln->hist, b + n, h * sizeof(uint32_t));
+    if (ln->consumed == ln->total) {
+        for (int j = 0; j < ln->ntag; j++) {
+            uint32_t t = (uint32_t)((uint64_t)_mm_cvtsi128_si64(ln->acc[j]) >> 32);
+            ln->tag[j] = t ^ (ln->delay ? ln->head[j] : b[h + n - 1]);
+        }
+    }
+}
+
+// 用標量上下文生成密鑰流並累加，直到消息結束
+static void mac_run_scalar(zuc_ctx *ctx, zuc_mac_lane *ln) {
+    uint32_t buf[ZUC_MAC_HIST + ZUC_EIA3_CHUNK];
+
+    while (ln->consumed < ln->total) {
+        size_t n = ln->total - ln->consumed;
+        if (n > ZUC_EIA3_CHUNK) n = ZUC_EIA3_CHUNK;
+        zuc_keystream(ctx, buf + ZUC_MAC_HIST, n);
+        mac_consume(ln, buf, n);
+    }
+    memset(ctx, 0, sizeof(*ctx));
+    memset(buf, 0, sizeof(buf));
+}
+
+uint32_t zuc_eia3(const uint8_t key[16], uint32_t count, uint8_t bearer, uint8_t direction,
+                  const uint8_t *msg, uint32_t bitlen) {
+    uint8_t iv[16];
+    zuc_mac_lane ln;
+    zuc_ctx ctx;
+
+    zuc_eia3_iv(count, bearer, direction, iv);
+    zuc_init(&ctx, key, iv);
+    mac_lane_init(&ln, msg, bitlen, 0);
+    mac_run_scalar(&ctx, &ln);
+    return ln.tag[0];
+}
+
+static void mac_store_tag(const zuc_mac_lane *ln, uint8_t *tag) {
+    for (int j = 0; j < ln->ntag && j < 4; j++) {
+        tag[4 * j] = (uint8_t)(ln->tag[j] >> 24);
+        tag[4 * j + 1] = (uint8_t)(ln->tag[j] >> 16);
+        tag[4 * j + 2] = (uint8_t)(ln->tag[j] >> 8);
+        tag[4 * j + 3] = (uint8_t)ln->tag[j];
+    }
+}
+
+// ZUC-256 MAC 的標籤長度；acc/head/hist 都按最多 4 個標籤字分配
+static int zuc256_tag_bits_valid(int tag_bits) {
+    return tag_bits == 32 || tag_bits == 64 || tag_bits == 128;
+}
+
+int zuc256_mac(const uint8_t key[32], const uint8_t iv[23], const uint8_t *msg, uint32_t bitlen,
+               int tag_bits, uint8_t *tag) {
+    zuc_mac_lane ln;
+    zuc_ctx ctx;
+
+    if (!zuc256_tag_bits_valid(tag_bits)) return -1;
+    zuc256_init(&ctx, key, iv, tag_bits);
+    mac_lane_init(&ln, msg, bitlen, tag_bits);
+    mac_run_scalar(&ctx, &ln);
+    mac_store_tag(&ln, tag);
+    return 0;
+}
+
+// 8 通道批量：EIA3 與 ZUC-256 的作業結構不同，通過 fetch/store 回調讀取輸入、寫回標籤
+typedef struct {
+    const uint8_t *key;     // EIA3 為 16 字節，ZUC-256 為 32 字節
+    uint8_t iv[23];         // EIA3 只用前 16 字節
+    const uint8_t *msg;
+    uint32_t bitlen;
+} mac_input;
+
+typedef void (*mac_fetch_fn)(void *jobs, size_t i, mac_input *in);
+typedef void (*mac_store_fn)(void *jobs, size_t i, const zuc_mac_lane *ln);
+
+static void mac_scalar_init(zuc_ctx *ctx, const mac_input *in, int tag_bits) {
+    if (tag_bits) {
+        zuc256_init(ctx, in->key, in->iv, tag_bits);
+    } else {
+        zuc_init(ctx, in->key, in->iv);
+    }
+}
+
+// 在通道 ch 上裝入新的消息：標量完成初始化，再寫入 8 通道狀態的該通道
+static void mac_load_lane(zuc_state_8ch *state, int ch, const mac_input *in, int tag_bits) {
+    uint32_t s[16];
+    zuc_ctx ctx;
+
+    mac_scalar_init(&ctx, in, tag_bits);
+    for (int i = 0; i < 16; i++) {
+        s[i] = ctx.lfsr[(ctx.off + i) & 15];
+    }
+    zuc_set_lane_8ch(state, ch, s, ctx.R1, ctx.R2);
+    memset(&ctx, 0, sizeof(ctx));
+    memset(s, 0, sizeof(s));
+}
+
+static void mac_run_8ch(void *jobs, size_t njobs, int tag_bits, mac_fetch_fn fetch, mac_store_fn store) {
+    uint32_t kbuf[8][ZUC_MAC_HIST + ZUC_EIA3_CHUNK];
+    zuc_state_8ch state;
+    mac_input in;
+    size_t lane_job[8];
+    int lane_busy[8];
+    zuc_mac_lane lanes[8];
+    size_t next = 0;
+    int active = 0;
+
+    // 前 8 個消息一起初始化，空閒通道使用全零密鑰/IV
+    uint8_t keys[8][32], ivs[8][23];
+    memset(keys, 0, sizeof(keys));
+    memset(ivs, 0, sizeof(ivs));
+    for (int ch = 0; ch < 8; ch++) {
+        lane_busy[ch] = next < njobs;
+        if (!lane_busy[ch]) continue;
+        lane_job[ch] = next++;
+        fetch(jobs, lane_job[ch], &in);
+        memcpy(keys[ch], in.key, tag_bits ? 32 : 16);
+        memcpy(ivs[ch], in.iv, tag_bits ? 23 : 16);
+        mac_lane_init(&lanes[ch], in.msg, in.bitlen, tag_bits);
+        active++;
+    }
+    if (!active) return;
+    if (tag_bits) {
+        zuc256_init_8ch(&state, (const uint8_t (*)[32])keys, (const uint8_t (*)[23])ivs, tag_bits);
+    } else {
+        uint8_t keys128[8][16], ivs128[8][16];
+        for (int ch = 0; ch < 8; ch++) {
+            memcpy(keys128[ch], keys[ch], 16);
+            memcpy(ivs128[ch], ivs[ch], 16);
+        }
+        zuc_init_8ch(&state, (const uint8_t (*)[16])keys128, (const uint8_t (*)[16])ivs128);
+        memset(keys128, 0, sizeof(keys128));
+    }
+    memset(keys, 0, sizeof(keys));
+
+    while (active) {
+        uint32_t *out[8];
+        size_t chunk = ZUC_EIA3_CHUNK;
+
+        for (int ch = 0; ch < 8; ch++) {
+            out[ch] = kbuf[ch] + ZUC_MAC_HIST;
+            if (lane_busy[ch] && lanes[ch].total - lanes[ch].consumed < chunk) {
+                chunk = lanes[ch].total - lanes[ch].consumed;
+            }
+        }
+
+        // 所有活動通道同步生成 chunk 個字 (每通道連續存放)，再各自累加
+        zuc_generate_8ch_n(&state, out, chunk);
+        for (int ch = 0; ch < 8; ch++) {
+            if (lane_busy[ch]) mac_consume(&lanes[ch], kbuf[ch], chunk);
+        }
+
+        // 已完成的通道輸出標籤並裝入下一個消息
+        for (int ch = 0; ch < 8; ch++) {
+            if (!lane_busy[ch] || lanes[ch].consumed < lanes[ch].total) continue;
+            store(jobs, lane_job[ch], &lanes[ch]);
+            lane_busy[ch] = next < njobs;
+            if (lane_busy[ch]) {
+                lane_job[ch] = next++;
+                fetch(jobs, lane_job[ch], &in);
+                mac_lane_init(&lanes[ch], in.msg, in.bitlen, tag_bits);
+                mac_load_lane(&state, ch, &in, tag_bits);
+            } else {
+                active--;
+            }
+        }
+    }
+
+    zuc_clear_8ch(&state);
+}
+
+static void eia3_fetch(void *jobs, size_t i, mac_input *in) {
+    const zuc_eia3_job *job = (const zuc_eia3_job *)jobs + i;
+    in->key = job->key;
+    zuc_eia3_iv(job->count, job->bearer, job->direction, in->iv);
+    in->msg = job->msg;
+    in->bitlen = job->bitlen;
+}
+
+static void eia3_store(void *jobs, size_t i, const zuc_mac_lane *ln) {
+    ((zuc_eia3_job *)jobs)[i].mac = ln->tag[0];
+}
+
+void zuc_eia3_8ch(zuc_eia3_job *jobs, size_t njobs) {
+    mac_run_8ch(jobs, njobs, 0, eia3_fetch, eia3_store);
+}
+
+static void zuc256_fetch(void *jobs, size_t i, mac_input *in) {
+    const zuc256_mac_job *job = (const zuc256_mac_job *)jobs + i;
+    in->key = job->key;
+    memcpy(in->iv, job->iv, 23);
+    in->msg = job->msg;
+    in->bitlen = job->bitlen;
+}
+
+static void zuc256_store(void *jobs, size_t i, const zuc_mac_lane *ln) {
+    mac_store_tag(ln, ((zuc256_mac_job *)jobs)[i].tag);
+}
+
+int zuc256_mac_8ch(zuc256_mac_job *jobs, size_t njobs, int tag_bits) {
+    if (!zuc256_tag_bits_valid(tag_bits)) return -1;
+    mac_run_8ch(jobs, njobs, tag_bits, zuc256_fetch, zuc256_store);
+    return 0;
+}
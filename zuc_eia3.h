@@ -0,0 +1,82 @@
+// 作者：https://github.com/8891689
+// zuc_eia3.h
+#ifndef ZUC_EIA3_H
+#define ZUC_EIA3_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 128-EIA3 (3GPP 完整性算法)，輸出 32 位 MAC。
+ *
+ * 按定義，消息的每個為 1 的比特 i 都要異或一個從密鑰流第 i 比特開始的 32 位窗口。
+ * 這裡每 32 個消息比特做一次無進位乘法 (PCLMULQDQ)：把消息字按比特反轉後與
+ * 64 位密鑰流 (k_j || k_j+1) 相乘，積的第 32..63 位就是 32 個窗口的異或。
+ * 整字部分每次處理 4 個字 (16 字節)；最後一個不完整的字掩碼後處理，
+ * 結尾對 z_LENGTH 的異或視為消息第 LENGTH 比特為 1，併入同一個字。
+ * 需要 -mpclmul -msse4.1 (或 -march=native)。
+ */
+
+// 一個待計算 MAC 的消息
+typedef struct {
+    const uint8_t *key;     // 16 字節
+    uint32_t count;
+    uint8_t bearer;         // 低 5 位有效
+    uint8_t direction;      // 低 1 位有效
+    const uint8_t *msg;
+    uint32_t bitlen;
+    uint32_t mac;           // 輸出
+} zuc_eia3_job;
+
+/**
+ * @brief 由 COUNT/BEARER/DIRECTION 構造 128-EIA3 的 16 字節 IV
+ */
+void zuc_eia3_iv(uint32_t count, uint8_t bearer, uint8_t direction, uint8_t iv[16]);
+
+/**
+ * @brief 單個消息 (標量 ZUC 密鑰流 + PCLMUL 累加)
+ */
+uint32_t zuc_eia3(const uint8_t key[16], uint32_t count, uint8_t bearer, uint8_t direction,
+                  const uint8_t *msg, uint32_t bitlen);
+
+/**
+ * @brief 批量計算 njobs 個消息的 MAC，密鑰流由 8 通道 ZUC (zuc_avx2) 並行生成；
+ * 某個通道的消息結束後立即裝入下一個消息。結果寫入 jobs[i].mac。
+ */
+void zuc_eia3_8ch(zuc_eia3_job *jobs, size_t njobs);
+
+/*
+ * ZUC-256 MAC (32/64/128 位標籤)，與 128-EIA3 共用同一套 PCLMUL 累加：
+ * t 位標籤的每個 32 位字各自是一個與 EIA3 相同的累加，只是密鑰流起點不同。
+ * key 為 32 字節，iv 為 23 字節 (格式見 zuc256_init)，標籤按大端字節序輸出 tag_bits / 8 字節。
+ */
+typedef struct {
+    const uint8_t *key;     // 32 字節
+    const uint8_t *iv;      // 23 字節
+    const uint8_t *msg;
+    uint32_t bitlen;
+    uint8_t tag[16];        // 輸出，前 tag_bits / 8 字節有效
+} zuc256_mac_job;
+
+/**
+ * @brief 單個消息的 ZUC-256 MAC
+ * tag_bits 只能是 32/64/128，否則返回 -1 且不寫 tag；成功返回 0
+ */
+int zuc256_mac(const uint8_t key[32], const uint8_t iv[23], const uint8_t *msg, uint32_t bitlen,
+                int tag_bits, uint8_t *tag);
+
+/**
+ * @brief 批量 ZUC-256 MAC，8 通道 (zuc256_init_8ch) 生成密鑰流，所有作業使用相同的標籤長度
+ * tag_bits 不是 32/64/128 時返回 -1，不處理任何作業；成功返回 0
+ */
+int zuc256_mac_8ch(zuc256_mac_job *jobs, size_t njobs, int tag_bits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ZUC_EIA3_H
@@ -0,0 +1,75 @@
+// 作者：https://github.com/8891689
+// zuc_lfsr.h
+#ifndef ZUC_LFSR_H
+#define ZUC_LFSR_H
+
+#include <stdint.h>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+/*
+ * ZUC LFSR 反饋，zuc.c / zuc_avx2.c / zuc_avx512.c 共用：
+ *     s16 = (1 + 2^8) s0 + 2^20 s4 + 2^21 s10 + 2^17 s13 + 2^15 s15  mod (2^31 - 1)
+ *
+ * 乘 2^n 在模 2^31 - 1 下就是 31 位循環左移。原來的寫法是逐項循環移位再逐項 mod_add31，
+ * 5 次約簡串成一條依賴鏈。這裡改為延遲約簡 (x mod 2^31 - 1 由 (x & M31) + (x >> 31) 折疊)：
+ *
+ * 標量：在 64 位中直接累加 s_i << n (和 < 2^53)，連循環移位都不需要，最後折疊兩次 (<= M31)。
+ * SIMD：32 位通道只放得下兩個 31 位數之和，所以成對相加後才折疊一次 (約簡延遲到每兩項)，
+ *       組成樹形：最新的 s15 最後加入，其依賴鏈只剩 循環移位 + 1 次加法折疊，
+ *       其餘各項與上一步的 F 函數並行。循環移位的輸入已經 < 2^31，省掉了移位前的截斷。
+ *       (把通道拆成奇偶兩組 64 位累加實測更慢：拆分與合併的指令比省下的還多。)
+ *
+ * 結果與逐項約簡完全一致：只有全零輸入得到 0，其餘 0 的同餘類都表示為 M31。
+ */
+
+#define ZUC_M31 0x7FFFFFFFu
+
+static inline uint32_t zuc_lfsr_feedback(uint32_t s0, uint32_t s4, uint32_t s10, uint32_t s13, uint32_t s15) {
+    uint64_t t = ((uint64_t)s0 << 8) + s0 + ((uint64_t)s4 << 20) + ((uint64_t)s10 << 21) +
+                 ((uint64_t)s13 << 17) + ((uint64_t)s15 << 15);
+    t = (t & ZUC_M31) + (t >> 31);                  // < 2^31 + 2^22
+    return (uint32_t)((t & ZUC_M31) + (t >> 31));   // <= M31
+}
+
+#ifdef __AVX2__
+// (x & M31) + (x >> 31)：x <= 2^32 - 2 (兩個 31 位數之和) 時結果 <= M31
+static inline __m256i zuc_fold31_avx2(__m256i x) {
+    return _mm256_add_epi32(_mm256_and_si256(x, _mm256_set1_epi32((int)ZUC_M31)), _mm256_srli_epi32(x, 31));
+}
+
+// 31 位循環左移，x < 2^31
+#define ZUC_ROT31_AVX2(x, n) _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi32((x), (n)), _mm256_set1_epi32((int)ZUC_M31)), \
+                                             _mm256_srli_epi32((x), 31 - (n)))
+
+static inline __m256i zuc_lfsr_feedback_avx2(__m256i s0, __m256i s4, __m256i s10, __m256i s13, __m256i s15) {
+    // 兩個 31 位數之和不溢出 32 位：成對相加後各折疊一次
+    __m256i a = zuc_fold31_avx2(_mm256_add_epi32(s0, ZUC_ROT31_AVX2(s0, 8)));
+    __m256i b = zuc_fold31_avx2(_mm256_add_epi32(ZUC_ROT31_AVX2(s4, 20), ZUC_ROT31_AVX2(s10, 21)));
+    __m256i c = zuc_fold31_avx2(_mm256_add_epi32(a, ZUC_ROT31_AVX2(s13, 17)));
+    c = zuc_fold31_avx2(_mm256_add_epi32(c, b));
+    // s15 最新，最後加入：它的依賴鏈只有 循環移位 + 1 次加法折疊
+    return zuc_fold31_avx2(_mm256_add_epi32(c, ZUC_ROT31_AVX2(s15, 15)));
+}
+#endif
+
+#ifdef __AVX512F__
+static inline __m512i zuc_fold31_16ch(__m512i x) {
+    return _mm512_add_epi32(_mm512_and_si512(x, _mm512_set1_epi32((int)ZUC_M31)), _mm512_srli_epi32(x, 31));
+}
+
+// 31 位循環左移：一條 vpternlogd ((a | b) & c) 完成合併和截斷
+#define ZUC_ROT31_16CH(x, n) _mm512_ternarylogic_epi32(_mm512_slli_epi32((x), (n)), _mm512_srli_epi32((x), 31 - (n)), \
+                                                       _mm512_set1_epi32((int)ZUC_M31), 0xA8)
+
+static inline __m512i zuc_lfsr_feedback_16ch(__m512i s0, __m512i s4, __m512i s10, __m512i s13, __m512i s15) {
+    __m512i a = zuc_fold31_16ch(_mm512_add_epi32(s0, ZUC_ROT31_16CH(s0, 8)));
+    __m512i b = zuc_fold31_16ch(_mm512_add_epi32(ZUC_ROT31_16CH(s4, 20), ZUC_ROT31_16CH(s10, 21)));
+    __m512i c = zuc_fold31_16ch(_mm512_add_epi32(a, ZUC_ROT31_16CH(s13, 17)));
+    c = zuc_fold31_16ch(_mm512_add_epi32(c, b));
+    return zuc_fold31_16ch(_mm512_add_epi32(c, ZUC_ROT31_16CH(s15, 15)));
+}
+#endif
+
+#endif // ZUC_LFSR_H
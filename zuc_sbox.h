@@ -0,0 +1,118 @@
+// 作者：https://github.com/8891689
+// zuc_sbox.h
+#ifndef ZUC_SBOX_H
+#define ZUC_SBOX_H
+
+#include <stdint.h>
+#include <immintrin.h>
+
+/*
+ * ZUC 的 S-Box 層實現 (zuc_avx.c / zuc_avx2.c / zuc_avx512.c 共用，運行時用 zuc_set_sbox_8ch /
+ * zuc_set_sbox_16ch 選擇)：
+ *   ZUC_SBOX_TABLE   逐通道標量查表 (僅 8 通道)
+ *   ZUC_SBOX_GATHER  每步 8 條 vpgatherdd
+ *   ZUC_SBOX_SHUFFLE 不訪問內存中的表 (無緩存計時洩漏)：S0 用 vpshufb；S1 在 8 通道用 AESENCLAST，
+ *                    在 16 通道用 GFNI
+ *   ZUC_SBOX_PERMUTE vpermi2b 在寄存器中查完整的 256 項表 (僅 16 通道，以 -mavx512vbmi 編譯時)
+ */
+typedef enum {
+    ZUC_SBOX_TABLE = 0,
+    ZUC_SBOX_GATHER = 1,
+    ZUC_SBOX_SHUFFLE = 2,
+    ZUC_SBOX_PERMUTE = 3,
+} zuc_sbox_impl;
+
+/*
+ * S0 是一個 3 輪 4 位 Feistel 結構，最後循環左移 5 位：
+ *     b1 = xh ^ P1[xl];  a1 = xl ^ P2[b1];  b2 = b1 ^ P3[a1];  S0 = rol8(b2 || a1, 5)
+ * rol8(b2 << 4, 5) = b2 << 1 是線性的，所以 S0 = (b1 << 1) ^ Q[a1]，
+ * 其中 Q[a] = rol8(a, 5) ^ (P3[a] << 1)。四個 16 項表都用 vpshufb 查。
+ *
+ * S1 與 AES S-Box 同構：S1(x) = Post(AES_SBOX(T x))，T 為兩個有限域之間的線性同構，
+ * Post 為仿射變換 (吸收了 AES 的仿射常量 0x63)。T 和 Post 都按高低半字節拆成兩次 vpshufb；
+ * AES_SBOX 用 AESENCLAST (輪密鑰為 0)，其 ShiftRows 由輸入端的逆置換抵消。
+ */
+static const uint8_t zuc_s0_p1[16] __attribute__((aligned(16))) = {
+    0x00, 0x06, 0x09, 0x07, 0x06, 0x06, 0x0b, 0x03, 0x09, 0x0d, 0x09, 0x05, 0x0e, 0x0c, 0x0a, 0x00
+};
+static const uint8_t zuc_s0_p2[16] __attribute__((aligned(16))) = {
+    0x01, 0x0b, 0x0a, 0x0e, 0x03, 0x0f, 0x02, 0x09, 0x0d, 0x08, 0x05, 0x06, 0x00, 0x07, 0x04, 0x0c
+};
+static const uint8_t zuc_s0_q[16] __attribute__((aligned(16))) = {
+    0x16, 0x3e, 0x46, 0x7e, 0x92, 0xa8, 0xc6, 0xec, 0x15, 0x35, 0x49, 0x79, 0x93, 0xa1, 0xcb, 0xe9
+};
+static const uint8_t zuc_s1_t_lo[16] __attribute__((aligned(16))) = {
+    0x00, 0x01, 0x32, 0x33, 0x73, 0x72, 0x41, 0x40, 0x75, 0x74, 0x47, 0x46, 0x06, 0x07, 0x34, 0x35
+};
+static const uint8_t zuc_s1_t_hi[16] __attribute__((aligned(16))) = {
+    0x00, 0xd9, 0xe8, 0x31, 0xcd, 0x14, 0x25, 0xfc, 0x2d, 0xf4, 0xc5, 0x1c, 0xe0, 0x39, 0x08, 0xd1
+};
+static const uint8_t zuc_s1_post_lo[16] __attribute__((aligned(16))) = {
+    0xfe, 0xb1, 0x6e, 0x21, 0xb5, 0xfa, 0x25, 0x6a, 0xc9, 0x86, 0x59, 0x16, 0x82, 0xcd, 0x12, 0x5d
+};
+static const uint8_t zuc_s1_post_hi[16] __attribute__((aligned(16))) = {
+    0x00, 0x34, 0x42, 0x76, 0x36, 0x02, 0x74, 0x40, 0x66, 0x52, 0x24, 0x10, 0x50, 0x64, 0x12, 0x26
+};
+// AES ShiftRows 的逆置換
+static const uint8_t zuc_inv_shift_rows[16] __attribute__((aligned(16))) = {
+    0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3
+};
+
+#if defined(__AVX2__) && defined(__AES__)
+#define ZUC_HAVE_SBOX_SHUFFLE 1
+
+#define ZUC_LUT16_AVX2(t) _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(t)))
+
+// 按字節：lo 為低半字節查 t_lo，hi 為高半字節查 t_hi，兩者異或
+static inline __m256i zuc_nibble_map_avx2(__m256i x, const uint8_t t_lo[16], const uint8_t t_hi[16]) {
+    const __m256i MASK_0F = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_and_si256(x, MASK_0F);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), MASK_0F);
+    return _mm256_xor_si256(_mm256_shuffle_epi8(ZUC_LUT16_AVX2(t_lo), lo),
+                            _mm256_shuffle_epi8(ZUC_LUT16_AVX2(t_hi), hi));
+}
+
+// 32 個字節各自過 S0
+static inline __m256i zuc_sbox0_shuffle_avx2(__m256i x) {
+    const __m256i MASK_0F = _mm256_set1_epi8(0x0F);
+    __m256i xl = _mm256_and_si256(x, MASK_0F);
+    __m256i xh = _mm256_and_si256(_mm256_srli_epi16(x, 4), MASK_0F);
+    __m256i b1 = _mm256_xor_si256(xh, _mm256_shuffle_epi8(ZUC_LUT16_AVX2(zuc_s0_p1), xl));
+    __m256i a1 = _mm256_xor_si256(xl, _mm256_shuffle_epi8(ZUC_LUT16_AVX2(zuc_s0_p2), b1));
+    return _mm256_xor_si256(_mm256_add_epi8(b1, b1), _mm256_shuffle_epi8(ZUC_LUT16_AVX2(zuc_s0_q), a1));
+}
+
+// 32 個字節各自過 S1
+static inline __m256i zuc_sbox1_aesni_avx2(__m256i x) {
+    __m256i t = zuc_nibble_map_avx2(x, zuc_s1_t_lo, zuc_s1_t_hi);
+    t = _mm256_shuffle_epi8(t, ZUC_LUT16_AVX2(zuc_inv_shift_rows));
+#ifdef __VAES__
+    t = _mm256_aesenclast_epi128(t, _mm256_setzero_si256());
+#else
+    __m128i lo = _mm_aesenclast_si128(_mm256_castsi256_si128(t), _mm_setzero_si128());
+    __m128i hi = _mm_aesenclast_si128(_mm256_extracti128_si256(t, 1), _mm_setzero_si128());
+    t = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+#endif
+    return zuc_nibble_map_avx2(t, zuc_s1_post_lo, zuc_s1_post_hi);
+}
+
+/*
+ * R1 = S(u)、R2 = S(v)，字內字節 3..0 依次過 S0、S1、S0、S1。
+ * u、v 的字節先重排成兩個向量 (每個字內：S1 組 [u0 v0 u2 v2]，S0 組 [v1 u1 v3 u3])，
+ * 各過一次 S-Box，再用字節混合拆回 R1 = [S1 u0, S0 u1, S1 u2, S0 u3] 和 R2。
+ */
+static inline void zuc_sbox_shuffle_avx2(__m256i u, __m256i v, __m256i *r1, __m256i *r2) {
+    const __m256i ODD = _mm256_set1_epi16((short)0xFF00);
+    const __m256i SWAP = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                          1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+    __m256i t1 = _mm256_blendv_epi8(u, _mm256_slli_epi16(v, 8), ODD);
+    __m256i t0 = _mm256_blendv_epi8(_mm256_srli_epi16(v, 8), u, ODD);
+    t1 = zuc_sbox1_aesni_avx2(t1);
+    t0 = zuc_sbox0_shuffle_avx2(t0);
+    *r1 = _mm256_blendv_epi8(t1, t0, ODD);
+    *r2 = _mm256_shuffle_epi8(_mm256_blendv_epi8(t0, t1, ODD), SWAP);
+}
+#endif
+
+#endif // ZUC_SBOX_H
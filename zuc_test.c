@@ -12,6 +12,20 @@
 #include <sys/time.h> 
 #endif
 
+// 单调时间 (秒)
+static double now_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER t, frequency;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart / frequency.QuadPart;
+#else
+    struct timeval t;
+    gettimeofday(&t, NULL);
+    return (double)t.tv_sec + (double)t.tv_usec / 1000000.0;
+#endif
+}
+
 // 辅助函数以十六进制格式打印数据
 void print_hex(const char* label, const uint8_t* data, int len) {
     printf("%s: ", label);
@@ -32,9 +46,11 @@ int main() {
     uint8_t iv1[16] = {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
                     0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
     uint32_t keystream1[10];
+    zuc_ctx ctx;
+    int failures = 0;
     
-    zuc_setup(key1, iv1);
-    zuc_prga(keystream1, 10);
+    zuc_init(&ctx, key1, iv1);
+    zuc_keystream(&ctx, keystream1, 10);
     
     printf("\nTest Vector 1 (All zeros):\n");
     for (int i = 0; i < 10; i++) {
@@ -48,8 +64,8 @@ int main() {
                     0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF};
     uint32_t keystream2[10];
     
-    zuc_setup(key2, iv2);
-    zuc_prga(keystream2, 10);
+    zuc_init(&ctx, key2, iv2);
+    zuc_keystream(&ctx, keystream2, 10);
     
     printf("\n\nTest Vector 2 (All ones):\n");
     for (int i = 0; i < 10; i++) {
@@ -63,14 +79,66 @@ int main() {
                     0x1f,0x6b,0xda,0x6b,0xfb,0xd8,0x07,0x66};
     uint32_t keystream3[10];
     
-    zuc_setup(key3, iv3);
-    zuc_prga(keystream3, 10);
+    zuc_init(&ctx, key3, iv3);
+    zuc_keystream(&ctx, keystream3, 10);
     
     printf("\n\nTest Vector 3 (Original values):\n");
     for (int i = 0; i < 10; i++) {
         printf("0x%08X%s", keystream3[i], (i % 5 == 4) ? "\n" : " ");
     }
 
+    // 前两个输出字：向量 1、2 为规范值，向量 3 为回归值
+    int tv_ok = keystream1[0] == 0x27BEDE74 && keystream1[1] == 0x018082DA &&
+                keystream2[0] == 0x0657CFA0 && keystream2[1] == 0x7096398B &&
+                keystream3[0] == 0x6E7DC9E4 && keystream3[1] == 0xFD29D3F6;
+    printf("\nTest vectors 1-3: %s\n", tv_ok ? "PASS" : "FAIL");
+    failures += !tv_ok;
+
+    // --- 可重入性：两个交错的流与各自独立生成的结果一致，分块长度任意 ---
+    zuc_ctx a, b;
+    uint32_t ref_a[100], ref_b[100], got_a[100], got_b[100];
+    zuc_init(&a, key1, iv3);
+    zuc_keystream(&a, ref_a, 100);
+    zuc_init(&b, key3, iv1);
+    zuc_keystream(&b, ref_b, 100);
+    zuc_init(&a, key1, iv3);
+    zuc_init(&b, key3, iv1);
+    for (int pos = 0, step = 1; pos < 100; pos += step, step = step % 19 + 3) {
+        int n = (pos + step > 100) ? 100 - pos : step;
+        zuc_keystream(&a, got_a + pos, (size_t)n);
+        zuc_keystream(&b, got_b + pos, (size_t)n);
+    }
+    int interleave_ok = memcmp(ref_a, got_a, sizeof(ref_a)) == 0 && memcmp(ref_b, got_b, sizeof(ref_b)) == 0;
+    printf("Interleaved contexts, odd chunk sizes: %s\n", interleave_ok ? "PASS" : "FAIL");
+    failures += !interleave_ok;
+
+    // zuc_xor 分块调用 (跨字边界) 与整体密钥流一致
+    uint8_t msg[397], enc[397];
+    for (int i = 0; i < (int)sizeof(msg); i++) msg[i] = (uint8_t)(i * 7);
+    zuc_init(&a, key3, iv3);
+    for (size_t pos = 0, step = 1; pos < sizeof(msg); pos += step, step = step % 13 + 1) {
+        size_t n = (pos + step > sizeof(msg)) ? sizeof(msg) - pos : step;
+        zuc_xor(&a, msg + pos, enc + pos, n);
+    }
+    int xor_ok = 1;
+    uint32_t ks_all[100];
+    zuc_init(&b, key3, iv3);
+    zuc_keystream(&b, ks_all, 100);
+    for (int i = 0; i < (int)sizeof(msg); i++) {
+        if ((uint8_t)(msg[i] ^ (ks_all[i / 4] >> (24 - 8 * (i % 4)))) != enc[i]) xor_ok = 0;
+    }
+    printf("zuc_xor in arbitrary chunks: %s\n", xor_ok ? "PASS" : "FAIL");
+    failures += !xor_ok;
+
+    // 旧接口 zuc_setup/zuc_prga 与上下文接口一致
+    uint32_t legacy[10];
+    zuc_setup(key3, iv3);
+    zuc_prga(legacy, 4);
+    zuc_prga(legacy + 4, 6);
+    int legacy_ok = memcmp(legacy, keystream3, sizeof(legacy)) == 0;
+    printf("Legacy zuc_setup/zuc_prga: %s\n", legacy_ok ? "PASS" : "FAIL");
+    failures += !legacy_ok;
+
     // --- 吞吐量测试部分 ---
 
     printf("\n--- Throughput Test ---\n");
@@ -104,7 +172,7 @@ int main() {
     // 在开始计时前进行一次 ZUC 初始化
     // zuc_setup 自身不是密钥流生成的一部分，不应包含在吞吐量计时中。
     // 但是，为了确保状态干净，每次基准测试前都应调用。
-    zuc_setup(throughput_key, throughput_iv);
+    zuc_init(&ctx, throughput_key, throughput_iv);
 
     // --- 开始计时 ---
 #ifdef _WIN32
@@ -118,8 +186,8 @@ int main() {
 
     // 循环生成密钥流
     for (int i = 0; i < NUM_ITERATIONS; i++) {
-        // zuc_prga 是实际生成密钥流的函数
-        zuc_prga(keystream_buffer, NUM_WORDS_PER_RUN);
+        // zuc_keystream 是实际生成密钥流的函数
+        zuc_keystream(&ctx, keystream_buffer, NUM_WORDS_PER_RUN);
     }
 
     // --- 停止计时 ---
@@ -150,8 +218,22 @@ int main() {
         printf("Time elapsed is zero, cannot calculate throughput. (Test duration might be too short or timer issue)\n");
     }
 
+    // 单条流直接异或 1MB 数据 (原地)：密钥流字直接异或进数据，与只生成密钥流的速度相当
+    uint8_t *data_buffer = (uint8_t *)keystream_buffer;
+    memset(data_buffer, 0x5A, (size_t)NUM_WORDS_PER_RUN * 4);
+    zuc_init(&ctx, throughput_key, throughput_iv);
+    double xor_start = now_seconds();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        zuc_xor(&ctx, data_buffer, data_buffer, (size_t)NUM_WORDS_PER_RUN * 4);
+    }
+    double xor_elapsed = now_seconds() - xor_start;
+    if (xor_elapsed > 0) {
+        printf("zuc_xor (1 MB in place): %.2f MB/s\n",
+               (double)total_bytes_generated / (1024.0 * 1024.0) / xor_elapsed);
+    }
+
     // 释放内存
     free(keystream_buffer);
     
-    return 0;
+    return failures ? 1 : 0;
 }